@@ -0,0 +1,80 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+
+// Hash_Map<uint64_t, uint64_t> lookups of random keys, a loop of single get() calls against get_many(),
+// from tables that fit in the L2 to tables much larger than the last level cache. Half of the queried
+// keys are in the map
+// Usage: Batched_Lookup_Bench [max_count]
+
+using U64_Map = hstl::Hash_Map<uint64_t, uint64_t>;
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 16'000'000u);
+
+	constexpr size_t QUERY_COUNT = 100'000u;
+
+	printf("Lookups of %zu keys, single get() -> get_many() (speedup, higher is better)\n", QUERY_COUNT);
+
+	for (size_t count = 16'000u; count <= max_count; count *= 8u)
+	{
+		bench::Random random;
+
+		hstl::Array<uint64_t> keys;
+		keys.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys.push(random.next());
+		}
+
+		U64_Map map{count};
+		map.insert_many(keys.buffer(), keys.buffer(), count);
+
+		hstl::Array<uint64_t> queries;
+		queries.reserve(QUERY_COUNT);
+
+		for (size_t i = 0; i < QUERY_COUNT; ++i)
+		{
+			queries.push(i % 2u == 0u ? keys[random.next() % count] : random.next());
+		}
+
+		hstl::Array<const uint64_t*> results{QUERY_COUNT};
+
+		double single_ns = bench::ns_per_call([&]()
+		{
+			uint64_t sum = 0u;
+
+			for (size_t i = 0; i < QUERY_COUNT; ++i)
+			{
+				const uint64_t* value = map.get(queries[i]);
+				sum += value != nullptr ? *value : 0u;
+			}
+
+			bench::do_not_optimize(sum);
+		}) / static_cast<double>(QUERY_COUNT);
+
+		double batched_ns = bench::ns_per_call([&]()
+		{
+			map.get_many(queries.buffer(), QUERY_COUNT, results.buffer());
+
+			uint64_t sum = 0u;
+
+			for (size_t i = 0; i < QUERY_COUNT; ++i)
+			{
+				sum += results[i] != nullptr ? *results[i] : 0u;
+			}
+
+			bench::do_not_optimize(sum);
+		}) / static_cast<double>(QUERY_COUNT);
+
+		size_t table_bytes = map.capacity() * (sizeof(uint64_t) * 2u + 1u);
+
+		printf("%9zu keys (%7.1f MB table) | %6.1f -> %6.1f ns per key (%5.2fx)\n",
+			count, static_cast<double>(table_bytes) / (1024.0 * 1024.0),
+			single_ns, batched_ns, single_ns / batched_ns);
+	}
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+
+// Minimal timing helpers shared by the benchmark executables
+// Build with optimizations (e.g. -DCMAKE_BUILD_TYPE=Release), debug numbers are meaningless
+namespace bench
+{
+	// Keeps the compiler from dropping a computation whose result is otherwise unused
+	template<typename T>
+	inline void do_not_optimize(const T& value)
+	{
+#if defined(_MSC_VER)
+		static volatile const void* sink;
+		sink = &value;
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	inline double now_seconds()
+	{
+		using Clock = std::chrono::steady_clock;
+
+		return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+	}
+
+	// Calls f() until at least "min_seconds" passed and returns the average nanoseconds per call
+	template<typename F>
+	double ns_per_call(F&& f, double min_seconds = 0.2)
+	{
+		f(); // warm up caches and page in memory
+
+		size_t calls = 0u;
+		double start = now_seconds();
+		double elapsed = 0.0;
+
+		do
+		{
+			f();
+			++calls;
+			elapsed = now_seconds() - start;
+		}
+		while (elapsed < min_seconds);
+
+		return elapsed * 1e9 / static_cast<double>(calls);
+	}
+
+	// Reads an optional size limit from the command line so the big cases can be skipped on small machines
+	inline size_t max_count_from_args(int argc, char** argv, size_t default_max)
+	{
+		if (argc > 1)
+		{
+			return static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+		}
+
+		return default_max;
+	}
+
+	// Deterministic and fast, good enough to generate benchmark inputs
+	struct Random
+	{
+		uint64_t state{0x9E3779B97F4A7C15ull};
+
+		uint64_t next()
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+
+			return state;
+		}
+	};
+};
@@ -0,0 +1,129 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+#include <Concurrent_Hash_Map.h>
+
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+// Throughput of 1 to 32 threads sharing a cache of 1M uint64_t keys, 90% lookups and 10% inserts of
+// random keys: a Hash_Map behind one global mutex against a Concurrent_Hash_Map with 64 shards
+// The numbers only scale as far as the machine has cores
+// Usage: Concurrent_Hash_Map_Bench [max_threads]
+
+static constexpr size_t KEY_COUNT = 1'000'000u;
+static constexpr size_t OPERATIONS_PER_THREAD = 1'000'000u;
+
+class Locked_Map
+{
+public:
+	bool get(uint64_t key, uint64_t& out)
+	{
+		std::lock_guard lock{mutex};
+
+		const uint64_t* value = map.get(key);
+
+		if (value == nullptr)
+		{
+			return false;
+		}
+
+		out = *value;
+
+		return true;
+	}
+
+	void insert(uint64_t key, uint64_t value)
+	{
+		std::lock_guard lock{mutex};
+
+		map.insert(key, value);
+	}
+
+private:
+	std::mutex mutex;
+	hstl::Hash_Map<uint64_t, uint64_t> map{KEY_COUNT * 2u};
+};
+
+// Million operations per second over all the threads
+template<typename Map>
+static double run(Map& map, size_t thread_count)
+{
+	hstl::Array<std::thread> threads;
+	threads.reserve(thread_count);
+
+	std::atomic<bool> go{false};
+	std::atomic<uint64_t> found{0u};
+
+	for (size_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace([&map, &go, &found, t]()
+		{
+			bench::Random random{0x9E3779B97F4A7C15ull + t * 0x632BE59BD9B4E019ull};
+			uint64_t hits = 0u;
+
+			while (go.load() == false)
+			{
+				std::this_thread::yield();
+			}
+
+			for (size_t i = 0; i < OPERATIONS_PER_THREAD; ++i)
+			{
+				uint64_t key = random.next() % (KEY_COUNT * 2u);
+
+				if (i % 10u == 0u)
+				{
+					map.insert(key, i);
+				}
+				else
+				{
+					uint64_t value = 0u;
+					hits += map.get(key, value);
+				}
+			}
+
+			found += hits;
+		});
+	}
+
+	double start = bench::now_seconds();
+	go = true;
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	double elapsed = bench::now_seconds() - start;
+
+	bench::do_not_optimize(found.load());
+
+	return static_cast<double>(thread_count * OPERATIONS_PER_THREAD) / elapsed / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_threads = bench::max_count_from_args(argc, argv, 32u);
+
+	printf("Mops/s, global mutex -> Concurrent_Hash_Map (%u hardware threads)\n", std::thread::hardware_concurrency());
+
+	for (size_t thread_count = 1u; thread_count <= max_threads; thread_count *= 2u)
+	{
+		Locked_Map locked;
+		hstl::Concurrent_Hash_Map<uint64_t, uint64_t> sharded{KEY_COUNT * 2u};
+
+		for (uint64_t key = 0u; key < KEY_COUNT * 2u; key += 2u)
+		{
+			locked.insert(key, key);
+			sharded.insert(key, key);
+		}
+
+		double locked_mops = run(locked, thread_count);
+		double sharded_mops = run(sharded, thread_count);
+
+		printf("%2zu threads | %6.1f -> %6.1f Mops/s (%5.2fx)\n", thread_count, locked_mops, sharded_mops, sharded_mops / locked_mops);
+	}
+
+	return 0;
+}
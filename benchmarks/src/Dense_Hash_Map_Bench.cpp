@@ -0,0 +1,103 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+#include <Dense_Hash_Map.h>
+
+// Hash_Map<uint64_t, uint64_t> against Dense_Hash_Map<uint64_t, uint64_t>: summing every value, and
+// looking up random keys (half of them in the map). A quarter of the keys are removed before measuring,
+// so the Hash_Map iterates a table with holes and the Dense_Hash_Map has swap-removed elements
+// Usage: Dense_Hash_Map_Bench [max_count]
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 16'000'000u);
+
+	constexpr size_t QUERY_COUNT = 100'000u;
+
+	printf("Hash_Map -> Dense_Hash_Map, ns per element iterated and per lookup (lower is better)\n");
+
+	for (size_t count = 16'000u; count <= max_count; count *= 8u)
+	{
+		bench::Random random;
+
+		hstl::Array<uint64_t> keys;
+		keys.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys.push(random.next());
+		}
+
+		hstl::Hash_Map<uint64_t, uint64_t> map;
+		hstl::Dense_Hash_Map<uint64_t, uint64_t> dense;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			map.insert(keys[i], i);
+			dense.insert(keys[i], i);
+		}
+
+		for (size_t i = 0; i < count; i += 4u)
+		{
+			map.remove(keys[i]);
+			dense.remove(keys[i]);
+		}
+
+		hstl::Array<uint64_t> queries;
+		queries.reserve(QUERY_COUNT);
+
+		for (size_t i = 0; i < QUERY_COUNT; ++i)
+		{
+			queries.push(i % 2u == 0u ? keys[random.next() % count] : random.next());
+		}
+
+		double map_iterate_ns = bench::ns_per_call([&]()
+		{
+			uint64_t sum = 0u;
+
+			map.for_each([&](const uint64_t&, const uint64_t& value) { sum += value; });
+
+			bench::do_not_optimize(sum);
+		}) / static_cast<double>(map.count());
+
+		double dense_iterate_ns = bench::ns_per_call([&]()
+		{
+			uint64_t sum = 0u;
+
+			for (uint64_t value : dense.value_array())
+			{
+				sum += value;
+			}
+
+			bench::do_not_optimize(sum);
+		}) / static_cast<double>(dense.count());
+
+		auto lookups = [&](const auto& container)
+		{
+			return bench::ns_per_call([&]()
+			{
+				uint64_t sum = 0u;
+
+				for (size_t i = 0; i < QUERY_COUNT; ++i)
+				{
+					const uint64_t* value = container.get(queries[i]);
+					sum += value != nullptr ? *value : 0u;
+				}
+
+				bench::do_not_optimize(sum);
+			}) / static_cast<double>(QUERY_COUNT);
+		};
+
+		double map_lookup_ns = lookups(map);
+		double dense_lookup_ns = lookups(dense);
+
+		size_t index_bytes = dense.capacity() * (sizeof(uint8_t) + sizeof(uint32_t));
+		size_t table_bytes = map.capacity() * (sizeof(uint64_t) * 2u + 1u);
+
+		printf("%9zu keys | iterate %5.2f -> %5.2f ns | lookup %6.1f -> %6.1f ns | table %7.1f MB -> index %6.1f MB\n",
+			count, map_iterate_ns, dense_iterate_ns, map_lookup_ns, dense_lookup_ns,
+			static_cast<double>(table_bytes) / (1024.0 * 1024.0), static_cast<double>(index_bytes) / (1024.0 * 1024.0));
+	}
+
+	return 0;
+}
@@ -0,0 +1,142 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+#include <Frozen_Hash_Map.h>
+#include <Mapped_File.h>
+#include <Str.h>
+
+#include <cstdio>
+
+// An asset table of "count" names ("textures/asset_N.dds") mapped to 64-bit file offsets
+// Startup: inserting every entry into a Hash_Map<Str, uint64_t> against mapping a Frozen_Hash_Map blob
+// from a file and viewing it (the page cache is warm, the first lookups then fault the pages in)
+// Lookups: random hits, half the queries are for names that aren't in the table
+// The offline build of the blob is timed too
+// Usage: Frozen_Hash_Map_Bench [max_count]
+
+static constexpr size_t QUERY_COUNT = 1u << 16u;
+static constexpr const char* BLOB_PATH = "Frozen_Hash_Map_Bench.bin";
+
+using Frozen_Map = hstl::Frozen_Hash_Map<hstl::Str_View, uint64_t>;
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 1u << 20u);
+
+	printf("startup ms, Hash_Map inserts -> mapped Frozen_Hash_Map | ns per lookup, Hash_Map -> Frozen_Hash_Map | build ms\n");
+
+	for (size_t count = 1024u; count <= max_count; count *= 8u)
+	{
+		hstl::Array<hstl::Str> names;
+		hstl::Array<hstl::Str_View> keys;
+		hstl::Array<uint64_t> offsets;
+
+		// Even numbers are in the table, odd ones are the misses
+		for (size_t i = 0; i < count * 2u; ++i)
+		{
+			char name[64];
+			snprintf(name, sizeof(name), "textures/environment/asset_%zu.dds", i);
+			names.push(hstl::Str{name});
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys.push(names[i * 2u].view());
+			offsets.push(i * 4096u);
+		}
+
+		double build_start = bench::now_seconds();
+		auto blob = Frozen_Map::build(keys.buffer(), offsets.buffer(), count);
+		double build_ms = (bench::now_seconds() - build_start) * 1e3;
+
+		if (blob == false)
+		{
+			printf("build failed: %.*s\n", static_cast<int>(blob.get_err().count()), blob.get_err().data());
+
+			return 1;
+		}
+
+		FILE* file = fopen(BLOB_PATH, "wb");
+
+		if (file == nullptr || fwrite(blob.get_value().buffer(), 1u, blob.get_value().size(), file) != blob.get_value().size())
+		{
+			printf("can't write %s\n", BLOB_PATH);
+
+			return 1;
+		}
+
+		fclose(file);
+
+		double map_startup = bench::ns_per_call([&]()
+		{
+			hstl::Hash_Map<hstl::Str, uint64_t> map;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				map.insert(names[i * 2u], offsets[i]);
+			}
+
+			bench::do_not_optimize(map.count());
+		}) / 1e6;
+
+		double frozen_startup = bench::ns_per_call([&]()
+		{
+			auto mapped = hstl::Mapped_File::open(BLOB_PATH);
+			auto frozen = Frozen_Map::view(mapped.get_value().data(), mapped.get_value().size());
+
+			bench::do_not_optimize(frozen.get_value().count());
+		}) / 1e6;
+
+		hstl::Hash_Map<hstl::Str, uint64_t> map;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			map.insert(names[i * 2u], offsets[i]);
+		}
+
+		auto mapped = hstl::Mapped_File::open(BLOB_PATH);
+		auto viewed = Frozen_Map::view(mapped.get_value().data(), mapped.get_value().size());
+		Frozen_Map frozen = viewed.get_value();
+
+		bench::Random random;
+		hstl::Array<hstl::Str_View> queries;
+
+		for (size_t q = 0; q < QUERY_COUNT; ++q)
+		{
+			queries.push(names[random.next() % (count * 2u)].view());
+		}
+
+		double map_lookup = bench::ns_per_call([&]()
+		{
+			uint64_t sum = 0u;
+
+			for (size_t q = 0; q < QUERY_COUNT; ++q)
+			{
+				const uint64_t* value = map.get(queries[q]);
+				sum += value != nullptr ? *value : 1u;
+			}
+
+			bench::do_not_optimize(sum);
+		}) / static_cast<double>(QUERY_COUNT);
+
+		double frozen_lookup = bench::ns_per_call([&]()
+		{
+			uint64_t sum = 0u;
+
+			for (size_t q = 0; q < QUERY_COUNT; ++q)
+			{
+				const uint64_t* value = frozen.get(queries[q]);
+				sum += value != nullptr ? *value : 1u;
+			}
+
+			bench::do_not_optimize(sum);
+		}) / static_cast<double>(QUERY_COUNT);
+
+		printf("%8zu entries | %8.3f -> %6.3f ms | %5.1f -> %5.1f ns (%4.2fx) | %8.1f ms, %zu bytes\n",
+			count, map_startup, frozen_startup, map_lookup, frozen_lookup, map_lookup / frozen_lookup, build_ms, blob.get_value().size());
+	}
+
+	remove(BLOB_PATH);
+
+	return 0;
+}
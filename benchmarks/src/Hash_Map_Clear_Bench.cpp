@@ -0,0 +1,95 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+
+// A per-frame scratch map: every frame inserts "count" uint64_t keys, looks each one up twice and empties
+// the map for the next frame. The map is either destroyed and rebuilt every frame, emptied with clear()
+// or emptied with clear() under GENERATIONAL_CLEAR. The table is sized for "capacity" elements, which is
+// what a scratch map that once saw a large frame keeps around
+// Usage: Hash_Map_Clear_Bench [max_capacity]
+
+struct Generational : hstl::Hash_Map_Options<uint64_t, uint64_t>
+{
+	static constexpr bool GENERATIONAL_CLEAR = true;
+};
+
+using Plain_Map = hstl::Hash_Map<uint64_t, uint64_t>;
+using Generational_Map = hstl::Hash_Map<uint64_t, uint64_t, hstl::Hash<uint64_t>, hstl::Equal_To<uint64_t>, Generational>;
+
+template<typename Map>
+static void fill_and_query(Map& map, const hstl::Array<uint64_t>& keys, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		map.insert(keys[i], i);
+	}
+
+	uint64_t sum = 0u;
+
+	for (size_t round = 0; round < 2u; ++round)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			sum += *map.get(keys[i]);
+		}
+	}
+
+	bench::do_not_optimize(sum);
+}
+
+// Nanoseconds per frame, averaged over a few frames
+template<typename Map>
+static double ns_per_frame(const hstl::Array<uint64_t>& keys, size_t count, size_t capacity, bool rebuild)
+{
+	constexpr size_t FRAMES = 8u;
+
+	Map map{capacity};
+
+	return bench::ns_per_call([&]()
+	{
+		for (size_t frame = 0; frame < FRAMES; ++frame)
+		{
+			if (rebuild)
+			{
+				Map fresh{capacity};
+				fill_and_query(fresh, keys, count);
+			}
+			else
+			{
+				fill_and_query(map, keys, count);
+				map.clear();
+			}
+		}
+	}) / static_cast<double>(FRAMES);
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_capacity = bench::max_count_from_args(argc, argv, 1u << 16u);
+
+	printf("ns per frame, rebuilt -> clear() -> generational clear()\n");
+
+	for (size_t capacity = 2048u; capacity <= max_capacity; capacity *= 8u)
+	{
+		for (size_t count = 16u; count <= capacity; count *= 8u)
+		{
+			bench::Random random;
+			hstl::Array<uint64_t> keys;
+			keys.reserve(count);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				keys.push(random.next());
+			}
+
+			double rebuilt = ns_per_frame<Plain_Map>(keys, count, capacity, true);
+			double cleared = ns_per_frame<Plain_Map>(keys, count, capacity, false);
+			double generational = ns_per_frame<Generational_Map>(keys, count, capacity, false);
+
+			printf("capacity %6zu, %5zu keys | %9.0f -> %9.0f -> %9.0f ns (%5.2fx, %5.2fx)\n",
+				capacity, count, rebuilt, cleared, generational, rebuilt / cleared, rebuilt / generational);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+
+#include <unordered_map>
+
+// Hit and miss lookups on Hash_Map filled to load factors between 0.5 and 0.875, against std::unordered_map
+// with the same keys. Small tables stay in cache, big ones are dominated by memory latency
+// Usage: Hash_Probe_Bench [max_capacity]
+
+static constexpr size_t LOOKUPS = 1u << 16;
+
+static void run_case(size_t capacity, double load_factor)
+{
+	size_t count = static_cast<size_t>(load_factor * static_cast<double>(capacity));
+
+	hstl::Array<uint64_t> keys{count};
+	hstl::Array<uint64_t> hits{LOOKUPS};
+	hstl::Array<uint64_t> misses{LOOKUPS};
+	bench::Random random;
+
+	// Odd keys are inserted and even keys are never there
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys[i] = random.next() | 1u;
+	}
+
+	for (size_t i = 0; i < LOOKUPS; ++i)
+	{
+		hits[i] = keys[random.next() % count];
+		misses[i] = random.next() & ~uint64_t{1u};
+	}
+
+	hstl::Hash_Map<uint64_t, uint64_t> map;
+	std::unordered_map<uint64_t, uint64_t> std_map;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		map.insert(keys[i], i);
+		std_map.emplace(keys[i], i);
+	}
+
+	auto lookup_all = [](const auto& lookups, auto&& find)
+	{
+		size_t found = 0u;
+
+		for (uint64_t key : lookups)
+		{
+			found += find(key);
+		}
+
+		bench::do_not_optimize(found);
+	};
+
+	auto hstl_find = [&](uint64_t key) { return map.get(key) != nullptr; };
+	auto std_find = [&](uint64_t key) { return std_map.find(key) != std_map.end(); };
+
+	double hstl_hit = bench::ns_per_call([&]() { lookup_all(hits, hstl_find); }) / LOOKUPS;
+	double hstl_miss = bench::ns_per_call([&]() { lookup_all(misses, hstl_find); }) / LOOKUPS;
+	double std_hit = bench::ns_per_call([&]() { lookup_all(hits, std_find); }) / LOOKUPS;
+	double std_miss = bench::ns_per_call([&]() { lookup_all(misses, std_find); }) / LOOKUPS;
+
+	printf("%9zu slots, load %.3f | hit %6.2f ns (std %6.2f ns, %5.2fx) | miss %6.2f ns (std %6.2f ns, %5.2fx)\n",
+		map.capacity(), static_cast<double>(map.count()) / static_cast<double>(map.capacity()),
+		hstl_hit, std_hit, std_hit / hstl_hit,
+		hstl_miss, std_miss, std_miss / hstl_miss);
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_capacity = bench::max_count_from_args(argc, argv, 1u << 22);
+
+	printf("Group width %zu\n", hstl::detail::Control_Group::WIDTH);
+
+	for (size_t capacity = 1u << 14; capacity <= max_capacity; capacity <<= 4u)
+	{
+		for (double load_factor : { 0.5, 0.625, 0.75, 0.875 })
+		{
+			run_case(capacity, load_factor);
+		}
+	}
+
+	return 0;
+}
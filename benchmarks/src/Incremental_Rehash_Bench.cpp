@@ -0,0 +1,109 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+
+#include <algorithm>
+
+// Latency of single inserts while a Hash_Map<uint64_t, uint64_t> is built from empty, with the default
+// all-at-once rehash and with INCREMENTAL_REHASH: the worst insert that grew the table, the 99.9th
+// percentile of all inserts and the average. The worst insert overall isn't reported, on a busy machine
+// it's the scheduler tick that happened to land on it
+// Usage: Incremental_Rehash_Bench [count]
+
+struct Incremental : hstl::Hash_Map_Options<uint64_t, uint64_t>
+{
+	static constexpr bool INCREMENTAL_REHASH = true;
+};
+
+template<typename Options>
+using U64_Map = hstl::Hash_Map<uint64_t, uint64_t, hstl::Hash<uint64_t>, hstl::Equal_To<uint64_t>, Options>;
+
+struct Latency
+{
+	double growth_ns{0.0};
+	double p999_ns{0.0};
+	double average_ns{0.0};
+};
+
+template<typename Options>
+static Latency measure(const hstl::Array<uint64_t>& keys)
+{
+	size_t count = keys.size();
+	hstl::Array<double> elapsed{count};
+	Latency result;
+
+	// Best of a few runs
+	for (int run = 0; run < 3; ++run)
+	{
+		U64_Map<Options> map;
+
+		double growth = 0.0;
+		double start = bench::now_seconds();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			size_t capacity = map.capacity();
+
+			double before = bench::now_seconds();
+			map.insert(keys[i], i);
+			elapsed[i] = bench::now_seconds() - before;
+
+			if (map.capacity() != capacity)
+			{
+				growth = std::max(growth, elapsed[i]);
+			}
+		}
+
+		double total = bench::now_seconds() - start;
+
+		bench::do_not_optimize(map.count());
+
+		std::sort(elapsed.begin(), elapsed.end());
+
+		Latency latency{growth * 1e9, elapsed[count - 1u - count / 1000u] * 1e9, total * 1e9 / static_cast<double>(count)};
+
+		if (run == 0)
+		{
+			result = latency;
+		}
+		else
+		{
+			result.growth_ns = std::min(result.growth_ns, latency.growth_ns);
+			result.p999_ns = std::min(result.p999_ns, latency.p999_ns);
+			result.average_ns = std::min(result.average_ns, latency.average_ns);
+		}
+	}
+
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 4'000'000u);
+
+	printf("Insert latency, all-at-once -> incremental rehash (the average includes the timer overhead)\n");
+
+	for (size_t count = 10'000u; count <= max_count; count *= 20u)
+	{
+		hstl::Array<uint64_t> keys;
+		keys.reserve(count);
+
+		bench::Random random;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys.push(random.next());
+		}
+
+		Latency all_at_once = measure<hstl::Hash_Map_Options<uint64_t, uint64_t>>(keys);
+		Latency incremental = measure<Incremental>(keys);
+
+		printf("%8zu keys | growing insert %11.0f -> %8.0f ns | p99.9 %7.0f -> %7.0f ns | average %6.1f -> %6.1f ns\n",
+			count,
+			all_at_once.growth_ns, incremental.growth_ns,
+			all_at_once.p999_ns, incremental.p999_ns,
+			all_at_once.average_ns, incremental.average_ns);
+	}
+
+	return 0;
+}
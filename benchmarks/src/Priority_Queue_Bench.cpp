@@ -0,0 +1,219 @@
+#include "Bench.h"
+
+#include <Priority_Queue.h>
+
+#include <queue>
+#include <vector>
+#include <functional>
+
+// Compares hstl::Priority_Queue (binary, 4-ary, 8-ary) against std::priority_queue on a push-all/pop-all
+// workload and on a steady-state mix that looks like an event scheduler, then Indexed_Priority_Queue with
+// decrease_key against the usual lazy-deletion Dijkstra on a random grid
+// Usage: Priority_Queue_Bench [count]
+
+// std::priority_queue::pop() returns nothing, hstl hands the element back, this works for both
+template<typename Queue>
+static uint32_t pop_top(Queue& q)
+{
+	uint32_t top = q.top();
+	q.pop();
+
+	return top;
+}
+
+template<typename Queue>
+static uint64_t push_pop_all(Queue& q, const hstl::Array<uint32_t>& input)
+{
+	for (uint32_t v : input)
+	{
+		q.push(v);
+	}
+
+	uint64_t checksum = 0u;
+
+	while (q.empty() == false)
+	{
+		checksum += pop_top(q);
+	}
+
+	return checksum;
+}
+
+// Keeps "count" elements queued, every step pops the earliest event and schedules a later one
+template<typename Queue>
+static uint64_t scheduler_mix(Queue& q, const hstl::Array<uint32_t>& input)
+{
+	for (uint32_t v : input)
+	{
+		q.push(v);
+	}
+
+	uint64_t checksum = 0u;
+
+	for (uint32_t v : input)
+	{
+		uint32_t now = pop_top(q);
+
+		checksum += now;
+		q.push(now + (v & 0xFFFFu));
+	}
+
+	while (q.empty() == false)
+	{
+		pop_top(q);
+	}
+
+	return checksum;
+}
+
+template<typename Queue>
+static double time_case(const hstl::Array<uint32_t>& input, bool mix)
+{
+	return bench::ns_per_call([&]()
+	{
+		Queue q;
+		bench::do_not_optimize(mix ? scheduler_mix(q, input) : push_pop_all(q, input));
+	});
+}
+
+static void run_queues(size_t count)
+{
+	hstl::Array<uint32_t> input{count};
+	bench::Random random;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		input[i] = static_cast<uint32_t>(random.next());
+	}
+
+	using Std = std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>>;
+	using Binary = hstl::Priority_Queue<uint32_t, std::greater<uint32_t>, 2>;
+	using Quad = hstl::Priority_Queue<uint32_t, std::greater<uint32_t>, 4>;
+	using Octal = hstl::Priority_Queue<uint32_t, std::greater<uint32_t>, 8>;
+
+	for (bool mix : { false, true })
+	{
+		double std_ns = time_case<Std>(input, mix);
+		double binary_ns = time_case<Binary>(input, mix);
+		double quad_ns = time_case<Quad>(input, mix);
+		double octal_ns = time_case<Octal>(input, mix);
+
+		printf("%-13s %9zu | std %9.3f ms | 2-ary %9.3f ms (%5.2fx) | 4-ary %9.3f ms (%5.2fx) | 8-ary %9.3f ms (%5.2fx)\n",
+			mix ? "scheduler" : "push/pop all", count,
+			std_ns * 1e-6,
+			binary_ns * 1e-6, std_ns / binary_ns,
+			quad_ns * 1e-6, std_ns / quad_ns,
+			octal_ns * 1e-6, std_ns / octal_ns);
+	}
+}
+
+static void run_dijkstra(uint32_t side)
+{
+	uint32_t nodes = side * side;
+	hstl::Array<uint32_t> weight{nodes};
+	bench::Random random;
+
+	for (uint32_t i = 0; i < nodes; ++i)
+	{
+		weight[i] = 1u + static_cast<uint32_t>(random.next() % 100u);
+	}
+
+	hstl::Array<uint32_t> dist{nodes};
+
+	auto relax_neighbours = [&](uint32_t node, auto&& relax)
+	{
+		uint32_t x = node % side;
+		uint32_t y = node / side;
+
+		if (x > 0u) relax(node - 1u);
+		if (x + 1u < side) relax(node + 1u);
+		if (y > 0u) relax(node - side);
+		if (y + 1u < side) relax(node + side);
+	};
+
+	double lazy_ns = bench::ns_per_call([&]()
+	{
+		using Entry = std::pair<uint32_t, uint32_t>;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> q;
+
+		for (uint32_t i = 0; i < nodes; ++i) dist[i] = UINT32_MAX;
+
+		dist[0] = 0u;
+		q.push({ 0u, 0u });
+
+		while (q.empty() == false)
+		{
+			auto [d, node] = q.top();
+			q.pop();
+
+			if (d > dist[node])
+				continue;
+
+			relax_neighbours(node, [&](uint32_t next)
+			{
+				if (d + weight[next] < dist[next])
+				{
+					dist[next] = d + weight[next];
+					q.push({ dist[next], next });
+				}
+			});
+		}
+
+		bench::do_not_optimize(dist[nodes - 1u]);
+	});
+
+	double indexed_ns = bench::ns_per_call([&]()
+	{
+		hstl::Indexed_Priority_Queue<uint32_t, std::greater<uint32_t>> q;
+		q.reserve(nodes, nodes);
+
+		for (uint32_t i = 0; i < nodes; ++i) dist[i] = UINT32_MAX;
+
+		dist[0] = 0u;
+		q.push(0u, 0u);
+
+		while (q.empty() == false)
+		{
+			auto [d, node] = q.pop();
+
+			relax_neighbours(node, [&](uint32_t next)
+			{
+				uint32_t candidate = d + weight[next];
+
+				if (candidate < dist[next])
+				{
+					if (dist[next] == UINT32_MAX)
+						q.push(next, candidate);
+					else
+						q.decrease_key(next, candidate);
+
+					dist[next] = candidate;
+				}
+			});
+		}
+
+		bench::do_not_optimize(dist[nodes - 1u]);
+	});
+
+	printf("dijkstra      %9u | std lazy %9.3f ms | indexed 4-ary %9.3f ms (%5.2fx)\n",
+		nodes, lazy_ns * 1e-6, indexed_ns * 1e-6, lazy_ns / indexed_ns);
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 1'000'000u);
+
+	printf("Speedup of hstl over std::priority_queue (higher is better)\n");
+
+	for (size_t count = 1'000u; count <= max_count; count *= 10u)
+	{
+		run_queues(count);
+	}
+
+	for (uint32_t side = 32u; side * side <= max_count; side *= 4u)
+	{
+		run_dijkstra(side);
+	}
+
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include "Bench.h"
+
+#include <Concurrent_Hash_Map.h>
+#include <Read_Mostly_Hash_Map.h>
+
+#include <thread>
+#include <atomic>
+
+// Lookup throughput of 1 to 32 reader threads on a table of 1M uint64_t keys, half of the lookups miss,
+// while one writer keeps overwriting random keys: a Concurrent_Hash_Map, whose readers share a lock per
+// shard, against a Read_Mostly_Hash_Map, whose readers take no lock at all
+// The numbers only scale as far as the machine has cores
+// Usage: Read_Mostly_Hash_Map_Bench [max_threads]
+
+static constexpr size_t KEY_COUNT = 1'000'000u;
+static constexpr size_t LOOKUPS_PER_THREAD = 1'000'000u;
+
+// Million lookups per second over all the reader threads
+template<typename Map>
+static double run(Map& map, size_t thread_count)
+{
+	hstl::Array<std::thread> threads;
+	threads.reserve(thread_count);
+
+	std::atomic<bool> go{false};
+	std::atomic<bool> done{false};
+	std::atomic<uint64_t> found{0u};
+
+	for (size_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace([&map, &go, &found, t]()
+		{
+			bench::Random random{0x9E3779B97F4A7C15ull + t * 0x632BE59BD9B4E019ull};
+			uint64_t hits = 0u;
+
+			while (go.load() == false)
+			{
+				std::this_thread::yield();
+			}
+
+			for (size_t i = 0; i < LOOKUPS_PER_THREAD; ++i)
+			{
+				uint64_t value = 0u;
+				hits += map.get(random.next() % (KEY_COUNT * 2u), value);
+			}
+
+			found += hits;
+		});
+	}
+
+	std::thread writer([&map, &go, &done]()
+	{
+		bench::Random random{0xD1B54A32D192ED03ull};
+
+		while (go.load() == false)
+		{
+			std::this_thread::yield();
+		}
+
+		for (uint64_t i = 0u; done.load(std::memory_order_relaxed) == false; ++i)
+		{
+			map.insert((random.next() % KEY_COUNT) * 2u, i);
+
+			// A read-mostly load, the writer only touches the table now and then
+			if (i % 64u == 0u)
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	double start = bench::now_seconds();
+	go = true;
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	double elapsed = bench::now_seconds() - start;
+
+	done = true;
+	writer.join();
+
+	bench::do_not_optimize(found.load());
+
+	return static_cast<double>(thread_count * LOOKUPS_PER_THREAD) / elapsed / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_threads = bench::max_count_from_args(argc, argv, 32u);
+
+	printf("Mops/s, Concurrent_Hash_Map -> Read_Mostly_Hash_Map, 1 writer (%u hardware threads)\n", std::thread::hardware_concurrency());
+
+	for (size_t thread_count = 1u; thread_count <= max_threads; thread_count *= 2u)
+	{
+		hstl::Concurrent_Hash_Map<uint64_t, uint64_t> sharded{KEY_COUNT};
+		hstl::Read_Mostly_Hash_Map<uint64_t, uint64_t> read_mostly{KEY_COUNT};
+
+		for (uint64_t key = 0u; key < KEY_COUNT * 2u; key += 2u)
+		{
+			sharded.insert(key, key);
+			read_mostly.insert(key, key);
+		}
+
+		double sharded_mops = run(sharded, thread_count);
+		double read_mostly_mops = run(read_mostly, thread_count);
+
+		printf("%2zu threads | %6.1f -> %6.1f Mops/s (%5.2fx)\n", thread_count, sharded_mops, read_mostly_mops, read_mostly_mops / sharded_mops);
+	}
+
+	return 0;
+}
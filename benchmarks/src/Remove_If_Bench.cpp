@@ -0,0 +1,75 @@
+#include "Bench.h"
+
+#include <Array.h>
+
+#include <algorithm>
+
+// Culls a share of a 1M-element array with Array::remove_if / remove_if_ordered and compares them against
+// the previous remove_if, which walked from the back with a branch per element
+// Usage: Remove_If_Bench [count]
+
+// The remove_if that Array used to have, kept here as the baseline
+template<typename T, typename F>
+static void previous_remove_if(hstl::Array<T>& arr, F f)
+{
+	int64_t last_survivor = static_cast<int64_t>(arr.size()) - 1;
+
+	for (int64_t i = last_survivor; i >= 0; --i)
+	{
+		if (f(arr[i]) == false)
+			continue;
+
+		if (last_survivor != i)
+		{
+			memcpy(&arr[i], &arr[last_survivor], sizeof(T));
+		}
+
+		last_survivor--;
+	}
+
+	arr.resize(static_cast<size_t>(last_survivor + 1));
+}
+
+template<typename T>
+static void run_case(const char* type_name, size_t count, uint32_t cull_percent)
+{
+	hstl::Array<T> source{count};
+	bench::Random random;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		source[i] = static_cast<T>(random.next() % 100u);
+	}
+
+	// Values are uniform in [0, 100), so the threshold is the share that gets culled
+	const T threshold = static_cast<T>(cull_percent);
+	auto cull = [threshold](const T& x) { return x < threshold; };
+
+	hstl::Array<T> work;
+
+	// Every run starts from a fresh copy, the copy is timed separately and subtracted
+	double copy_ns = bench::ns_per_call([&]() { work = source; bench::do_not_optimize(work.buffer()); });
+	double previous_ns = bench::ns_per_call([&]() { work = source; previous_remove_if(work, cull); bench::do_not_optimize(work.size()); }) - copy_ns;
+	double unordered_ns = bench::ns_per_call([&]() { work = source; work.remove_if(cull); bench::do_not_optimize(work.size()); }) - copy_ns;
+	double ordered_ns = bench::ns_per_call([&]() { work = source; work.remove_if_ordered(cull); bench::do_not_optimize(work.size()); }) - copy_ns;
+
+	printf("%-8s %9zu elements, %3u%% culled | previous %8.3f ms | remove_if %8.3f ms (%5.2fx) | remove_if_ordered %8.3f ms (%5.2fx)\n",
+		type_name, count, cull_percent,
+		previous_ns * 1e-6,
+		unordered_ns * 1e-6, previous_ns / unordered_ns,
+		ordered_ns * 1e-6, previous_ns / ordered_ns);
+}
+
+int main(int argc, char** argv)
+{
+	size_t count = bench::max_count_from_args(argc, argv, 1'000'000u);
+
+	for (uint32_t cull_percent : { 10u, 50u, 90u })
+	{
+		run_case<int32_t>("int32_t", count, cull_percent);
+		run_case<float>("float", count, cull_percent);
+		run_case<uint64_t>("uint64_t", count, cull_percent);
+	}
+
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include "Bench.h"
+
+#include <Algorithms.h>
+
+#include <algorithm>
+#include <numeric>
+
+// Compares the hstl search/reduction kernels against the standard algorithms on 1K..100M elements
+// Usage: Search_Bench [max_count]
+
+template<typename T>
+static void run_case(const char* type_name, size_t count)
+{
+	hstl::Array<T> arr{count};
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		arr[i] = static_cast<T>(i % 1000u);
+	}
+
+	// Worst case for find: the needle is the very last element
+	const T needle = static_cast<T>(5000);
+	arr[count - 1] = needle;
+
+	double std_find = bench::ns_per_call([&]() { bench::do_not_optimize(std::find(arr.begin(), arr.end(), needle)); });
+	double hstl_find = bench::ns_per_call([&]() { bench::do_not_optimize(hstl::find(arr, needle)); });
+
+	double std_count = bench::ns_per_call([&]() { bench::do_not_optimize(std::count(arr.begin(), arr.end(), needle)); });
+	double hstl_count = bench::ns_per_call([&]() { bench::do_not_optimize(hstl::count(arr, needle)); });
+
+	double std_min = bench::ns_per_call([&]() { bench::do_not_optimize(std::min_element(arr.begin(), arr.end())); });
+	double hstl_min = bench::ns_per_call([&]() { bench::do_not_optimize(hstl::min_element(arr)); });
+
+	double std_sum = bench::ns_per_call([&]() { bench::do_not_optimize(std::accumulate(arr.begin(), arr.end(), T{})); });
+	double hstl_sum = bench::ns_per_call([&]() { bench::do_not_optimize(hstl::sum(arr)); });
+
+	printf("%-9s %11zu | find %6.2fx | count %6.2fx | min_element %6.2fx | sum %6.2fx\n",
+		type_name, count,
+		std_find / hstl_find,
+		std_count / hstl_count,
+		std_min / hstl_min,
+		std_sum / hstl_sum);
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 100'000'000u);
+
+#if defined(HSTL_SIMD_AVX2)
+	printf("Kernels: AVX2\n");
+#elif defined(HSTL_SIMD_SSE2)
+	printf("Kernels: SSE2\n");
+#else
+	printf("Kernels: scalar\n");
+#endif
+
+	printf("Speedup of hstl over the standard algorithm (higher is better)\n");
+
+	for (size_t count = 1'000u; count <= max_count; count *= 10u)
+	{
+		run_case<int32_t>("int32_t", count);
+		run_case<uint32_t>("uint32_t", count);
+		run_case<float>("float", count);
+	}
+
+	return 0;
+}
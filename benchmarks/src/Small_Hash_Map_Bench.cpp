@@ -0,0 +1,87 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+#include <Small_Hash_Map.h>
+#include <Str.h>
+
+#include <cstdio>
+
+// Lookups in many small maps, like per-entity property bags: 64 maps (all in the cache) or 4096 maps of
+// "count" elements each, every query picks a map and a key at random and half of the keys are missing.
+// Hash_Map against a Small_Hash_Map<..., 16>, with uint32_t keys and with short Str keys
+// Usage: Small_Hash_Map_Bench [max_count]
+
+static constexpr size_t QUERY_COUNT = 1u << 16u;
+
+template<typename Map, typename Key>
+static double ns_per_lookup(const hstl::Array<Key>& keys, size_t count, size_t map_count)
+{
+	hstl::Array<Map> maps{map_count};
+
+	for (size_t m = 0; m < map_count; ++m)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			maps[m].insert(keys[i * 2u], static_cast<uint32_t>(i));
+		}
+	}
+
+	bench::Random random;
+	hstl::Array<uint32_t> query_maps;
+	hstl::Array<uint32_t> query_keys;
+
+	for (size_t q = 0; q < QUERY_COUNT; ++q)
+	{
+		query_maps.push(static_cast<uint32_t>(random.next() % map_count));
+		query_keys.push(static_cast<uint32_t>(random.next() % (count * 2u))); // Odd ones are missing
+	}
+
+	return bench::ns_per_call([&]()
+	{
+		uint64_t sum = 0u;
+
+		for (size_t q = 0; q < QUERY_COUNT; ++q)
+		{
+			const uint32_t* value = maps[query_maps[q]].get(keys[query_keys[q]]);
+			sum += value != nullptr ? *value : 1u;
+		}
+
+		bench::do_not_optimize(sum);
+	}) / static_cast<double>(QUERY_COUNT);
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 16u);
+
+	hstl::Array<uint32_t> int_keys;
+	hstl::Array<hstl::Str> str_keys;
+	bench::Random random;
+
+	for (size_t i = 0; i < max_count * 2u; ++i)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "param_%zu", i);
+
+		int_keys.push(static_cast<uint32_t>(random.next()));
+		str_keys.push(hstl::Str{name});
+	}
+
+	printf("ns per lookup, Hash_Map -> Small_Hash_Map<16>\n");
+
+	for (size_t map_count : {64u, 4096u})
+	{
+		for (size_t count = 1u; count <= max_count; count *= 2u)
+		{
+			double int_map = ns_per_lookup<hstl::Hash_Map<uint32_t, uint32_t>>(int_keys, count, map_count);
+			double int_small = ns_per_lookup<hstl::Small_Hash_Map<uint32_t, uint32_t, 16>>(int_keys, count, map_count);
+			double str_map = ns_per_lookup<hstl::Hash_Map<hstl::Str, uint32_t>>(str_keys, count, map_count);
+			double str_small = ns_per_lookup<hstl::Small_Hash_Map<hstl::Str, uint32_t, 16>>(str_keys, count, map_count);
+
+			printf("%4zu maps, %2zu elements | uint32_t %5.1f -> %5.1f ns (%4.2fx) | Str %5.1f -> %5.1f ns (%4.2fx)\n",
+				map_count, count, int_map, int_small, int_map / int_small, str_map, str_small, str_map / str_small);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,191 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+#include <Sparse_Hash_Map.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Memory and speed of a Hash_Map against a Sparse_Hash_Map holding "count" random keys
+// Bytes per entry are measured by the global operator new below: "final" is what the filled map holds,
+// "peak" the most that was live while inserting (a rehash holds both tables). Allocator overhead per
+// block is not counted, the Sparse_Hash_Map makes one block per group of 64 slots
+// Lookups are random, of keys in the map (hits) and of keys that aren't (misses)
+// Each power of four is measured at 0.85x and 1x, see run()
+// Usage: Sparse_Hash_Map_Bench [max_count]
+
+static constexpr size_t QUERY_COUNT = 1u << 16u;
+
+static size_t live_bytes = 0u;
+static size_t peak_bytes = 0u;
+
+// Every allocation carries its size in front of it, so the deletes can count too
+static constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+	void* block = malloc(size + HEADER_SIZE);
+
+	if (block == nullptr)
+	{
+		throw std::bad_alloc{};
+	}
+
+	*static_cast<size_t*>(block) = size;
+	live_bytes += size;
+	peak_bytes = live_bytes > peak_bytes ? live_bytes : peak_bytes;
+
+	return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	if (pointer == nullptr)
+	{
+		return;
+	}
+
+	void* block = static_cast<char*>(pointer) - HEADER_SIZE;
+	live_bytes -= *static_cast<size_t*>(block);
+
+	free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	operator delete(pointer);
+}
+
+struct Measure
+{
+	double final_bytes_per_entry;
+	double peak_bytes_per_entry;
+	double insert_ns;
+	double hit_ns;
+	double miss_ns;
+};
+
+template<typename Map, typename T>
+static Measure measure(const hstl::Array<T>& keys, const hstl::Array<T>& hits, const hstl::Array<T>& misses)
+{
+	Measure result{};
+	size_t count = keys.size();
+	size_t base_bytes = live_bytes;
+
+	peak_bytes = live_bytes;
+
+	{
+		double start = bench::now_seconds();
+		Map map;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			map.insert(keys[i], keys[i]);
+		}
+
+		result.insert_ns = (bench::now_seconds() - start) * 1e9 / static_cast<double>(count);
+		result.final_bytes_per_entry = static_cast<double>(live_bytes - base_bytes) / static_cast<double>(count);
+		result.peak_bytes_per_entry = static_cast<double>(peak_bytes - base_bytes) / static_cast<double>(count);
+
+		result.hit_ns = bench::ns_per_call([&]()
+		{
+			T sum = 0;
+
+			for (size_t i = 0; i < QUERY_COUNT; ++i)
+			{
+				sum += *map.get(hits[i]);
+			}
+
+			bench::do_not_optimize(sum);
+		}) / static_cast<double>(QUERY_COUNT);
+
+		result.miss_ns = bench::ns_per_call([&]()
+		{
+			size_t found = 0;
+
+			for (size_t i = 0; i < QUERY_COUNT; ++i)
+			{
+				found += map.get(misses[i]) != nullptr;
+			}
+
+			bench::do_not_optimize(found);
+		}) / static_cast<double>(QUERY_COUNT);
+	}
+
+	return result;
+}
+
+// Smallest and largest final bytes per entry seen over the measured counts
+struct Bytes_Range
+{
+	double min{1e300};
+	double max{0.0};
+
+	void add(double bytes_per_entry)
+	{
+		min = bytes_per_entry < min ? bytes_per_entry : min;
+		max = bytes_per_entry > max ? bytes_per_entry : max;
+	}
+};
+
+template<typename T>
+static void run_count(size_t count, Bytes_Range& dense_range, Bytes_Range& sparse_range)
+{
+	bench::Random random;
+	hstl::Array<T> keys;
+	hstl::Array<T> hits;
+	hstl::Array<T> misses;
+
+	// Distinct scattered even keys (an odd multiplier is a permutation), the odd ones are never inserted
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys.push(static_cast<T>((i * 0x9E3779B97F4A7C15ull) << 1u));
+	}
+
+	for (size_t i = 0; i < QUERY_COUNT; ++i)
+	{
+		hits.push(keys[random.next() % count]);
+		misses.push(static_cast<T>(random.next() | 1u));
+	}
+
+	Measure dense = measure<hstl::Hash_Map<T, T>>(keys, hits, misses);
+	Measure sparse = measure<hstl::Sparse_Hash_Map<T, T>>(keys, hits, misses);
+
+	dense_range.add(dense.final_bytes_per_entry);
+	sparse_range.add(sparse.final_bytes_per_entry);
+
+	printf("%10zu | %5.1f (%5.1f) -> %5.1f (%5.1f) | %6.1f -> %6.1f | %6.1f -> %6.1f | %6.1f -> %6.1f\n", count,
+		dense.final_bytes_per_entry, dense.peak_bytes_per_entry, sparse.final_bytes_per_entry, sparse.peak_bytes_per_entry,
+		dense.insert_ns, sparse.insert_ns, dense.hit_ns, sparse.hit_ns, dense.miss_ns, sparse.miss_ns);
+}
+
+// Every power of two has just grown a Hash_Map to its lowest load (0.5), 0.85 of one sits just below its
+// growth point at 0.875, so the pair spans the best and the worst bytes per entry of a Hash_Map
+template<typename T>
+static void run(const char* name, size_t max_count)
+{
+	printf("%s: bytes per entry final (peak), Hash_Map -> Sparse_Hash_Map | ns per insert | ns per hit | ns per miss\n", name);
+
+	Bytes_Range dense_range;
+	Bytes_Range sparse_range;
+
+	for (size_t count = 1u << 16u; count <= max_count; count *= 4u)
+	{
+		run_count<T>(count * 85u / 100u, dense_range, sparse_range);
+		run_count<T>(count, dense_range, sparse_range);
+	}
+
+	printf("final bytes per entry, min - max: Hash_Map %.1f - %.1f, Sparse_Hash_Map %.1f - %.1f\n\n",
+		dense_range.min, dense_range.max, sparse_range.min, sparse_range.max);
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 1u << 24u);
+
+	run<uint64_t>("uint64_t -> uint64_t", max_count);
+	run<uint32_t>("uint32_t -> uint32_t", max_count);
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+
+// Hash_Map<uint64_t, Record> lookups with the key and the value side by side against SPLIT_SLOTS, for
+// records of a few sizes. Half of the queried keys are in the map, a get() hit reads one field of the
+// record, contains() never touches it
+// Usage: Split_Slots_Bench [max_count]
+
+template<size_t BYTES>
+struct Record
+{
+	uint64_t id;
+	uint8_t payload[BYTES - sizeof(uint64_t)];
+};
+
+template<typename Value, bool SPLIT>
+struct Layout : hstl::Hash_Map_Options<uint64_t, Value>
+{
+	static constexpr bool SPLIT_SLOTS = SPLIT;
+};
+
+template<typename Value, bool SPLIT>
+using Record_Map = hstl::Hash_Map<uint64_t, Value, hstl::Hash<uint64_t>, hstl::Equal_To<uint64_t>, Layout<Value, SPLIT>>;
+
+struct Lookup_Time
+{
+	double get_ns{0.0};
+	double contains_ns{0.0};
+};
+
+template<typename Value, bool SPLIT>
+static Lookup_Time ns_per_lookup(const hstl::Array<uint64_t>& keys, const hstl::Array<uint64_t>& queries)
+{
+	Record_Map<Value, SPLIT> map{keys.size()};
+
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		Value value{};
+		value.id = i;
+		map.insert(keys[i], value);
+	}
+
+	Lookup_Time time;
+
+	time.get_ns = bench::ns_per_call([&]()
+	{
+		uint64_t sum = 0u;
+
+		for (uint64_t query : queries)
+		{
+			const Value* value = map.get(query);
+			sum += value != nullptr ? value->id : 0u;
+		}
+
+		bench::do_not_optimize(sum);
+	}) / static_cast<double>(queries.size());
+
+	time.contains_ns = bench::ns_per_call([&]()
+	{
+		size_t found = 0u;
+
+		for (uint64_t query : queries)
+		{
+			found += map.contains(query);
+		}
+
+		bench::do_not_optimize(found);
+	}) / static_cast<double>(queries.size());
+
+	return time;
+}
+
+template<size_t BYTES>
+static void run(size_t max_count)
+{
+	constexpr size_t QUERY_COUNT = 100'000u;
+
+	using Value = Record<BYTES>;
+
+	printf("%zu-byte values\n", BYTES);
+
+	for (size_t count = 4'000u; count <= max_count; count *= 4u)
+	{
+		bench::Random random;
+
+		hstl::Array<uint64_t> keys;
+		keys.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys.push(random.next());
+		}
+
+		hstl::Array<uint64_t> queries;
+		queries.reserve(QUERY_COUNT);
+
+		for (size_t i = 0; i < QUERY_COUNT; ++i)
+		{
+			queries.push(i % 2u == 0u ? keys[random.next() % count] : random.next());
+		}
+
+		Lookup_Time packed = ns_per_lookup<Value, false>(keys, queries);
+		Lookup_Time split = ns_per_lookup<Value, true>(keys, queries);
+
+		printf("%8zu keys | get %6.1f -> %6.1f ns (%5.2fx) | contains %6.1f -> %6.1f ns (%5.2fx)\n", count,
+			packed.get_ns, split.get_ns, packed.get_ns / split.get_ns,
+			packed.contains_ns, split.contains_ns, packed.contains_ns / split.contains_ns);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t max_count = bench::max_count_from_args(argc, argv, 1'024'000u);
+
+	printf("Lookups, packed -> split slots (speedup, higher is better)\n");
+
+	run<32u>(max_count);
+	run<64u>(max_count);
+	run<128u>(max_count);
+	run<256u>(max_count);
+
+	return 0;
+}
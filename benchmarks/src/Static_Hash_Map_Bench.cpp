@@ -0,0 +1,98 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+#include <Static_Hash_Map.h>
+#include <Str.h>
+
+#include <cstdio>
+
+// A lexer classifying words against the 32 C keywords, 3 words out of 4 are identifiers
+// Hash_Map<Str_View, int> filled at startup against a constexpr Static_Hash_Map, the startup cost of the
+// Hash_Map is timed too (the Static_Hash_Map has none, it is in the binary)
+// Usage: Static_Hash_Map_Bench
+
+static constexpr size_t WORD_COUNT = 1u << 14u;
+
+static constexpr hstl::Static_Hash_Entry<hstl::Str_View, int> C_KEYWORDS[] = {
+	{"auto", 0}, {"break", 1}, {"case", 2}, {"char", 3}, {"const", 4}, {"continue", 5}, {"default", 6}, {"do", 7},
+	{"double", 8}, {"else", 9}, {"enum", 10}, {"extern", 11}, {"float", 12}, {"for", 13}, {"goto", 14}, {"if", 15},
+	{"int", 16}, {"long", 17}, {"register", 18}, {"return", 19}, {"short", 20}, {"signed", 21}, {"sizeof", 22}, {"static", 23},
+	{"struct", 24}, {"switch", 25}, {"typedef", 26}, {"union", 27}, {"unsigned", 28}, {"void", 29}, {"volatile", 30}, {"while", 31},
+};
+
+static constexpr auto KEYWORDS = hstl::make_static_hash_map(std::to_array(C_KEYWORDS));
+
+static const char* IDENTIFIERS[] = {"count", "index", "buffer", "result", "i", "node", "value", "length", "ptr", "data", "next", "size"};
+
+int main()
+{
+	constexpr size_t KEYWORD_COUNT = sizeof(C_KEYWORDS) / sizeof(C_KEYWORDS[0]);
+	constexpr size_t IDENTIFIER_COUNT = sizeof(IDENTIFIERS) / sizeof(IDENTIFIERS[0]);
+
+	bench::Random random;
+	hstl::Array<hstl::Str_View> words;
+
+	for (size_t i = 0; i < WORD_COUNT; ++i)
+	{
+		uint64_t pick = random.next();
+
+		if (pick % 4u == 0u)
+		{
+			words.push(C_KEYWORDS[(pick >> 8u) % KEYWORD_COUNT].key);
+		}
+		else
+		{
+			words.push(hstl::Str_View{IDENTIFIERS[(pick >> 8u) % IDENTIFIER_COUNT]});
+		}
+	}
+
+	double startup = bench::ns_per_call([&]()
+	{
+		hstl::Hash_Map<hstl::Str_View, int> map;
+
+		for (const auto& keyword : C_KEYWORDS)
+		{
+			map.insert(keyword.key, keyword.value);
+		}
+
+		bench::do_not_optimize(map.count());
+	});
+
+	hstl::Hash_Map<hstl::Str_View, int> map;
+
+	for (const auto& keyword : C_KEYWORDS)
+	{
+		map.insert(keyword.key, keyword.value);
+	}
+
+	double map_lookup = bench::ns_per_call([&]()
+	{
+		int sum = 0;
+
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			const int* token = map.get(words[i]);
+			sum += token != nullptr ? *token : -1;
+		}
+
+		bench::do_not_optimize(sum);
+	}) / static_cast<double>(WORD_COUNT);
+
+	double static_lookup = bench::ns_per_call([&]()
+	{
+		int sum = 0;
+
+		for (size_t i = 0; i < WORD_COUNT; ++i)
+		{
+			const int* token = KEYWORDS.get(words[i]);
+			sum += token != nullptr ? *token : -1;
+		}
+
+		bench::do_not_optimize(sum);
+	}) / static_cast<double>(WORD_COUNT);
+
+	printf("%zu keywords | startup %.0f -> 0 ns | %.1f -> %.1f ns per word (%.2fx)\n",
+		KEYWORD_COUNT, startup, map_lookup, static_lookup, map_lookup / static_lookup);
+
+	return 0;
+}
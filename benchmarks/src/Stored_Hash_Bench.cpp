@@ -0,0 +1,121 @@
+#include "Bench.h"
+
+#include <Hash_Map.h>
+
+// Str-keyed Hash_Map with long keys, with and without STORE_HASH: building the map from empty (every grow
+// rehashes all keys unless the hashes are stored), hit lookups, and removing every key (the backward
+// shift hashes every displaced key unless the hashes are stored)
+// Usage: Stored_Hash_Bench [count]
+
+struct With_Hashes : hstl::Hash_Map_Options<hstl::Str, uint32_t>
+{
+	static constexpr bool STORE_HASH = true;
+};
+
+struct Without_Hashes : hstl::Hash_Map_Options<hstl::Str, uint32_t>
+{
+	static constexpr bool STORE_HASH = false;
+};
+
+template<typename Options>
+using Str_Map = hstl::Hash_Map<hstl::Str, uint32_t, hstl::Str_Hash, hstl::Str_Equal, Options>;
+
+template<typename Options>
+static void measure(const hstl::Array<hstl::Str>& keys, double& build_ns, double& lookup_ns, double& remove_ns)
+{
+	size_t count = keys.size();
+
+	build_ns = bench::ns_per_call([&]()
+	{
+		Str_Map<Options> map;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			map.insert(keys[i], static_cast<uint32_t>(i));
+		}
+
+		bench::do_not_optimize(map.count());
+	}) / static_cast<double>(count);
+
+	Str_Map<Options> map;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		map.insert(keys[i], static_cast<uint32_t>(i));
+	}
+
+	lookup_ns = bench::ns_per_call([&]()
+	{
+		uint64_t sum = 0u;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			sum += *map.get(keys[i].view());
+		}
+
+		bench::do_not_optimize(sum);
+	}) / static_cast<double>(count);
+
+	// Removing needs a fresh map every time, the copy is timed separately and subtracted
+	Str_Map<Options> work;
+
+	double copy_ns = bench::ns_per_call([&]() { work = map; bench::do_not_optimize(work.count()); });
+	double copy_and_remove_ns = bench::ns_per_call([&]()
+	{
+		work = map;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			work.remove(keys[i].view());
+		}
+
+		bench::do_not_optimize(work.count());
+	});
+
+	remove_ns = (copy_and_remove_ns - copy_ns) / static_cast<double>(count);
+}
+
+static void run_case(size_t count, size_t key_length)
+{
+	hstl::Array<hstl::Str> keys;
+	keys.reserve(count);
+
+	bench::Random random;
+
+	// Long shared prefix like asset paths, the unique part is at the end
+	for (size_t i = 0; i < count; ++i)
+	{
+		hstl::Str key{'a', key_length - 16u};
+		char suffix[17];
+		snprintf(suffix, sizeof(suffix), "%016llx", static_cast<unsigned long long>(random.next()));
+		key.push(suffix);
+		keys.push(std::move(key));
+	}
+
+	double with_build, with_lookup, with_remove;
+	double without_build, without_lookup, without_remove;
+
+	measure<With_Hashes>(keys, with_build, with_lookup, with_remove);
+	measure<Without_Hashes>(keys, without_build, without_lookup, without_remove);
+
+	printf("%8zu keys of %4zu chars | build %7.1f -> %7.1f ns (%5.2fx) | lookup %7.1f -> %7.1f ns (%5.2fx) | remove %7.1f -> %7.1f ns (%5.2fx)\n",
+		count, key_length,
+		without_build, with_build, without_build / with_build,
+		without_lookup, with_lookup, without_lookup / with_lookup,
+		without_remove, with_remove, without_remove / with_remove);
+}
+
+int main(int argc, char** argv)
+{
+	size_t count = bench::max_count_from_args(argc, argv, 200'000u);
+
+	printf("Per-key cost without -> with STORE_HASH (speedup, higher is better)\n");
+
+	for (size_t key_length : { 32u, 128u, 512u })
+	{
+		run_case(count / 10u, key_length);
+		run_case(count, key_length);
+	}
+
+	return 0;
+}
@@ -0,0 +1,695 @@
+#pragma once
+
+#include "Array.h"
+#include "Str.h"
+#include "Simd.h"
+
+#include <type_traits>
+#include <functional>
+#include <cstring>
+
+namespace hstl
+{
+	namespace detail
+	{
+		enum class Simd_Lane
+		{
+			NONE,
+			I8,
+			I32,
+			U32,
+			F32,
+			I64,
+			U64,
+			F64
+		};
+
+		template<typename T>
+		constexpr Simd_Lane simd_lane_of()
+		{
+			if constexpr (std::is_same_v<T, float> && sizeof(float) == 4)
+			{
+				return Simd_Lane::F32;
+			}
+			else if constexpr (std::is_same_v<T, double> && sizeof(double) == 8)
+			{
+				return Simd_Lane::F64;
+			}
+			else if constexpr (std::is_integral_v<T> && std::is_same_v<T, bool> == false)
+			{
+				if constexpr (sizeof(T) == 1)
+				{
+					return Simd_Lane::I8;
+				}
+				else if constexpr (sizeof(T) == 4)
+				{
+					return std::is_signed_v<T> ? Simd_Lane::I32 : Simd_Lane::U32;
+				}
+				else if constexpr (sizeof(T) == 8)
+				{
+					return std::is_signed_v<T> ? Simd_Lane::I64 : Simd_Lane::U64;
+				}
+				else
+				{
+					return Simd_Lane::NONE;
+				}
+			}
+			else
+			{
+				return Simd_Lane::NONE;
+			}
+		}
+
+		// Every specialization exposes WIDTH elements per vector, load/splat and an equality mask with one bit per element
+		// Lanes that have HAS_MIN_MAX/HAS_SUM also expose min/max/add
+		template<Simd_Lane LANE>
+		struct Simd_Ops
+		{
+			static constexpr bool HAS_EQ = false;
+			static constexpr bool HAS_MIN_MAX = false;
+			static constexpr bool HAS_SUM = false;
+		};
+
+#if defined(HSTL_SIMD_AVX2)
+		template<>
+		struct Simd_Ops<Simd_Lane::I8>
+		{
+			using Vector = __m256i;
+			using Scalar = int8_t;
+
+			static constexpr size_t WIDTH = 32u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = false;
+			static constexpr bool HAS_SUM = false;
+
+			static Vector load(const void* ptr) { return _mm256_loadu_si256(static_cast<const __m256i*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm256_set1_epi8(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::I32>
+		{
+			using Vector = __m256i;
+			using Scalar = int32_t;
+
+			static constexpr size_t WIDTH = 8u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = true;
+			static constexpr bool HAS_SUM = true;
+
+			static Vector load(const void* ptr) { return _mm256_loadu_si256(static_cast<const __m256i*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm256_set1_epi32(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+			static Vector min(Vector a, Vector b) { return _mm256_min_epi32(a, b); }
+			static Vector max(Vector a, Vector b) { return _mm256_max_epi32(a, b); }
+			static Vector add(Vector a, Vector b) { return _mm256_add_epi32(a, b); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::U32> : Simd_Ops<Simd_Lane::I32>
+		{
+			using Scalar = uint32_t;
+
+			static Vector splat(Scalar value) { return _mm256_set1_epi32(static_cast<int32_t>(value)); }
+			static Vector min(Vector a, Vector b) { return _mm256_min_epu32(a, b); }
+			static Vector max(Vector a, Vector b) { return _mm256_max_epu32(a, b); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::F32>
+		{
+			using Vector = __m256;
+			using Scalar = float;
+
+			static constexpr size_t WIDTH = 8u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = true;
+			static constexpr bool HAS_SUM = true;
+
+			static Vector load(const void* ptr) { return _mm256_loadu_ps(static_cast<const float*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm256_set1_ps(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+			static Vector min(Vector a, Vector b) { return _mm256_min_ps(a, b); }
+			static Vector max(Vector a, Vector b) { return _mm256_max_ps(a, b); }
+			static Vector add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::I64>
+		{
+			using Vector = __m256i;
+			using Scalar = int64_t;
+
+			static constexpr size_t WIDTH = 4u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = false;
+			static constexpr bool HAS_SUM = true;
+
+			static Vector load(const void* ptr) { return _mm256_loadu_si256(static_cast<const __m256i*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm256_set1_epi64x(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))); }
+			static Vector add(Vector a, Vector b) { return _mm256_add_epi64(a, b); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::U64> : Simd_Ops<Simd_Lane::I64>
+		{
+			using Scalar = uint64_t;
+
+			static Vector splat(Scalar value) { return _mm256_set1_epi64x(static_cast<int64_t>(value)); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::F64>
+		{
+			using Vector = __m256d;
+			using Scalar = double;
+
+			static constexpr size_t WIDTH = 4u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = true;
+			static constexpr bool HAS_SUM = true;
+
+			static Vector load(const void* ptr) { return _mm256_loadu_pd(static_cast<const double*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm256_set1_pd(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+			static Vector min(Vector a, Vector b) { return _mm256_min_pd(a, b); }
+			static Vector max(Vector a, Vector b) { return _mm256_max_pd(a, b); }
+			static Vector add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+		};
+#elif defined(HSTL_SIMD_SSE2)
+		template<>
+		struct Simd_Ops<Simd_Lane::I8>
+		{
+			using Vector = __m128i;
+			using Scalar = int8_t;
+
+			static constexpr size_t WIDTH = 16u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = false;
+			static constexpr bool HAS_SUM = false;
+
+			static Vector load(const void* ptr) { return _mm_loadu_si128(static_cast<const __m128i*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm_set1_epi8(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::I32>
+		{
+			using Vector = __m128i;
+			using Scalar = int32_t;
+
+			static constexpr size_t WIDTH = 4u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = true;
+			static constexpr bool HAS_SUM = true;
+
+			static Vector load(const void* ptr) { return _mm_loadu_si128(static_cast<const __m128i*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm_set1_epi32(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+			static Vector add(Vector a, Vector b) { return _mm_add_epi32(a, b); }
+
+			// SSE2 has no 32-bit min/max, pick through a compare mask instead
+			static Vector select(Vector mask, Vector a, Vector b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+			static Vector min(Vector a, Vector b) { return select(_mm_cmplt_epi32(a, b), a, b); }
+			static Vector max(Vector a, Vector b) { return select(_mm_cmpgt_epi32(a, b), a, b); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::U32> : Simd_Ops<Simd_Lane::I32>
+		{
+			using Scalar = uint32_t;
+
+			static Vector splat(Scalar value) { return _mm_set1_epi32(static_cast<int32_t>(value)); }
+
+			// Flipping the sign bit maps unsigned order onto signed order
+			static Vector bias(Vector a) { return _mm_xor_si128(a, _mm_set1_epi32(INT32_MIN)); }
+			static Vector min(Vector a, Vector b) { return select(_mm_cmplt_epi32(bias(a), bias(b)), a, b); }
+			static Vector max(Vector a, Vector b) { return select(_mm_cmpgt_epi32(bias(a), bias(b)), a, b); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::F32>
+		{
+			using Vector = __m128;
+			using Scalar = float;
+
+			static constexpr size_t WIDTH = 4u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = true;
+			static constexpr bool HAS_SUM = true;
+
+			static Vector load(const void* ptr) { return _mm_loadu_ps(static_cast<const float*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm_set1_ps(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+			static Vector min(Vector a, Vector b) { return _mm_min_ps(a, b); }
+			static Vector max(Vector a, Vector b) { return _mm_max_ps(a, b); }
+			static Vector add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::I64>
+		{
+			using Vector = __m128i;
+			using Scalar = int64_t;
+
+			static constexpr size_t WIDTH = 2u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = false;
+			static constexpr bool HAS_SUM = true;
+
+			static Vector load(const void* ptr) { return _mm_loadu_si128(static_cast<const __m128i*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm_set1_epi64x(value); }
+			static Vector add(Vector a, Vector b) { return _mm_add_epi64(a, b); }
+
+			// SSE2 has no 64-bit compare, both 32-bit halves have to match
+			static uint32_t eq_mask(Vector a, Vector b)
+			{
+				Vector halves = _mm_cmpeq_epi32(a, b);
+				Vector both = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+
+				return static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(both)));
+			}
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::U64> : Simd_Ops<Simd_Lane::I64>
+		{
+			using Scalar = uint64_t;
+
+			static Vector splat(Scalar value) { return _mm_set1_epi64x(static_cast<int64_t>(value)); }
+		};
+
+		template<>
+		struct Simd_Ops<Simd_Lane::F64>
+		{
+			using Vector = __m128d;
+			using Scalar = double;
+
+			static constexpr size_t WIDTH = 2u;
+			static constexpr bool HAS_EQ = true;
+			static constexpr bool HAS_MIN_MAX = true;
+			static constexpr bool HAS_SUM = true;
+
+			static Vector load(const void* ptr) { return _mm_loadu_pd(static_cast<const double*>(ptr)); }
+			static Vector splat(Scalar value) { return _mm_set1_pd(value); }
+			static uint32_t eq_mask(Vector a, Vector b) { return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+			static Vector min(Vector a, Vector b) { return _mm_min_pd(a, b); }
+			static Vector max(Vector a, Vector b) { return _mm_max_pd(a, b); }
+			static Vector add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+		};
+#endif
+
+		template<typename T>
+		using Simd_Ops_For = Simd_Ops<simd_lane_of<T>()>;
+
+		template<typename T>
+		T wrapping_add(T a, T b)
+		{
+			if constexpr (std::is_integral_v<T>)
+			{
+				using Unsigned_T = std::make_unsigned_t<T>;
+
+				return static_cast<T>(static_cast<Unsigned_T>(a) + static_cast<Unsigned_T>(b));
+			}
+			else
+			{
+				return a + b;
+			}
+		}
+
+		// Reduces whole vectors with "vector_op" then folds the lanes with "scalar_op"
+		// Returns how many elements were consumed, the caller finishes the tail
+		template<typename T, typename Vector_Op, typename Scalar_Op>
+		size_t simd_reduce(const T* data, size_t count, T& result, Vector_Op vector_op, Scalar_Op scalar_op)
+		{
+			using Ops = Simd_Ops_For<T>;
+			using Scalar = typename Ops::Scalar;
+
+			constexpr size_t W = Ops::WIDTH;
+
+			if (count < 2u * W)
+			{
+				return 0u;
+			}
+
+			// Two accumulators to hide the latency of the vector op
+			auto acc0 = Ops::load(data);
+			auto acc1 = Ops::load(data + W);
+			size_t i = 2u * W;
+
+			for (; i + 2u * W <= count; i += 2u * W)
+			{
+				acc0 = vector_op(acc0, Ops::load(data + i));
+				acc1 = vector_op(acc1, Ops::load(data + i + W));
+			}
+
+			auto acc = vector_op(acc0, acc1);
+
+			Scalar lanes[W];
+			memcpy(lanes, &acc, sizeof(lanes));
+
+			Scalar folded = lanes[0];
+
+			for (size_t lane = 1u; lane < W; ++lane)
+			{
+				folded = scalar_op(folded, lanes[lane]);
+			}
+
+			result = static_cast<T>(folded);
+
+			return i;
+		}
+	}
+
+	template<typename T>
+	const T* find(const T* data, size_t count, const T& value)
+	{
+		size_t i = 0u;
+
+		if constexpr (detail::Simd_Ops_For<T>::HAS_EQ)
+		{
+			using Ops = detail::Simd_Ops_For<T>;
+
+			constexpr size_t W = Ops::WIDTH;
+			auto needle = Ops::splat(static_cast<typename Ops::Scalar>(value));
+
+			// Four vectors per iteration, the masks are only inspected one by one once something matched
+			for (; i + 4u * W <= count; i += 4u * W)
+			{
+				uint32_t m0 = Ops::eq_mask(Ops::load(data + i), needle);
+				uint32_t m1 = Ops::eq_mask(Ops::load(data + i + W), needle);
+				uint32_t m2 = Ops::eq_mask(Ops::load(data + i + 2u * W), needle);
+				uint32_t m3 = Ops::eq_mask(Ops::load(data + i + 3u * W), needle);
+
+				if ((m0 | m1 | m2 | m3) != 0u)
+				{
+					if (m0) return data + i + lowest_bit_index(m0);
+					if (m1) return data + i + W + lowest_bit_index(m1);
+					if (m2) return data + i + 2u * W + lowest_bit_index(m2);
+
+					return data + i + 3u * W + lowest_bit_index(m3);
+				}
+			}
+
+			for (; i + W <= count; i += W)
+			{
+				uint32_t mask = Ops::eq_mask(Ops::load(data + i), needle);
+
+				if (mask != 0u)
+				{
+					return data + i + lowest_bit_index(mask);
+				}
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			if (data[i] == value)
+			{
+				return data + i;
+			}
+		}
+
+		return data + count;
+	}
+
+	template<typename T>
+	size_t count(const T* data, size_t count, const T& value)
+	{
+		size_t result = 0u;
+		size_t i = 0u;
+
+		if constexpr (detail::Simd_Ops_For<T>::HAS_EQ)
+		{
+			using Ops = detail::Simd_Ops_For<T>;
+
+			constexpr size_t W = Ops::WIDTH;
+			auto needle = Ops::splat(static_cast<typename Ops::Scalar>(value));
+
+			for (; i + W <= count; i += W)
+			{
+				result += bit_count(Ops::eq_mask(Ops::load(data + i), needle));
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			result += data[i] == value;
+		}
+
+		return result;
+	}
+
+	template<typename T>
+	bool contains(const T* data, size_t count, const T& value)
+	{
+		return find(data, count, value) != data + count;
+	}
+
+	// The predicate is evaluated over blocks without an early exit per element, which lets
+	// the compiler vectorize simple predicates, the scan stops at the first block with a hit
+	template<typename T, typename F>
+	bool any_of(const T* data, size_t count, F f)
+	{
+		static_assert(std::is_invocable_r_v<bool, F, const T&>, "Predicate must be callable as bool(const T&)");
+
+		static constexpr size_t BLOCK_SIZE = 64u;
+
+		size_t i = 0u;
+
+		for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE)
+		{
+			bool hit = false;
+
+			for (size_t j = 0u; j < BLOCK_SIZE; ++j)
+			{
+				hit |= static_cast<bool>(f(data[i + j]));
+			}
+
+			if (hit)
+			{
+				return true;
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			if (f(data[i]))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Returns the first smallest element, or "data + count" when empty
+	// NOTE: For floating point ranges that hold NaNs the result is one of the elements, which one is unspecified
+	template<typename T>
+	const T* min_element(const T* data, size_t count)
+	{
+		if (count == 0u)
+		{
+			return data;
+		}
+
+		if constexpr (detail::Simd_Ops_For<T>::HAS_MIN_MAX)
+		{
+			using Ops = detail::Simd_Ops_For<T>;
+
+			if (count >= 2u * Ops::WIDTH)
+			{
+				T best{};
+				size_t i = detail::simd_reduce(data, count, best,
+					[](auto a, auto b) { return Ops::min(a, b); },
+					[](auto a, auto b) { return b < a ? b : a; });
+
+				for (; i < count; ++i)
+				{
+					best = data[i] < best ? data[i] : best;
+				}
+
+				// A NaN that wins the lane reductions matches nothing in find(), those ranges take the scalar loop
+				if (best == best)
+				{
+					// One more pass to find where the minimum lives, this is much cheaper than tracking indices per lane
+					return find(data, count, best);
+				}
+			}
+		}
+
+		const T* best = data;
+
+		for (size_t i = 1u; i < count; ++i)
+		{
+			if (data[i] < *best)
+			{
+				best = data + i;
+			}
+		}
+
+		return best;
+	}
+
+	// Returns the first largest element, or "data + count" when empty
+	// NOTE: For floating point ranges that hold NaNs the result is one of the elements, which one is unspecified
+	template<typename T>
+	const T* max_element(const T* data, size_t count)
+	{
+		if (count == 0u)
+		{
+			return data;
+		}
+
+		if constexpr (detail::Simd_Ops_For<T>::HAS_MIN_MAX)
+		{
+			using Ops = detail::Simd_Ops_For<T>;
+
+			if (count >= 2u * Ops::WIDTH)
+			{
+				T best{};
+				size_t i = detail::simd_reduce(data, count, best,
+					[](auto a, auto b) { return Ops::max(a, b); },
+					[](auto a, auto b) { return a < b ? b : a; });
+
+				for (; i < count; ++i)
+				{
+					best = best < data[i] ? data[i] : best;
+				}
+
+				if (best == best)
+				{
+					return find(data, count, best);
+				}
+			}
+		}
+
+		const T* best = data;
+
+		for (size_t i = 1u; i < count; ++i)
+		{
+			if (*best < data[i])
+			{
+				best = data + i;
+			}
+		}
+
+		return best;
+	}
+
+	// Integer sums wrap around on overflow, floating point sums are accumulated
+	// per lane so the rounding differs slightly from a sequential sum
+	template<typename T>
+	T sum(const T* data, size_t count)
+	{
+		T result{};
+		size_t i = 0u;
+
+		if constexpr (detail::Simd_Ops_For<T>::HAS_SUM)
+		{
+			using Ops = detail::Simd_Ops_For<T>;
+
+			i = detail::simd_reduce(data, count, result,
+				[](auto a, auto b) { return Ops::add(a, b); },
+				[](auto a, auto b) { return detail::wrapping_add(a, b); });
+		}
+
+		for (; i < count; ++i)
+		{
+			result = detail::wrapping_add(result, data[i]);
+		}
+
+		return result;
+	}
+
+	// First element that is not less than "key" in a sorted range, or "data + count"
+	// The halving loop has no data dependent branch, the compiler turns the select into a cmov
+	// and both candidate midpoints of the next step are prefetched
+	template<typename T, typename K, typename Less = std::less<>>
+	const T* lower_bound(const T* data, size_t count, const K& key, Less less = Less{})
+	{
+		if (count == 0u)
+		{
+			return data;
+		}
+
+		const T* base = data;
+		size_t n = count;
+
+		while (n > 1u)
+		{
+			size_t half = n / 2u;
+
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(base + (n - half) / 2u);
+			__builtin_prefetch(base + half + (n - half) / 2u);
+#endif
+
+			base = less(base[half], key) ? base + half : base;
+			n -= half;
+		}
+
+		return base + static_cast<size_t>(less(*base, key));
+	}
+
+	template<typename T>
+	const T* find(const Array<T>& array, const T& value)
+	{
+		return find(array.buffer(), array.size(), value);
+	}
+
+	template<typename T>
+	T* find(Array<T>& array, const T& value)
+	{
+		return const_cast<T*>(find(array.buffer(), array.size(), value));
+	}
+
+	template<typename T>
+	size_t count(const Array<T>& array, const T& value)
+	{
+		return count(array.buffer(), array.size(), value);
+	}
+
+	template<typename T>
+	bool contains(const Array<T>& array, const T& value)
+	{
+		return contains(array.buffer(), array.size(), value);
+	}
+
+	template<typename T, typename F>
+	bool any_of(const Array<T>& array, F f)
+	{
+		return any_of(array.buffer(), array.size(), f);
+	}
+
+	template<typename T>
+	const T* min_element(const Array<T>& array)
+	{
+		return min_element(array.buffer(), array.size());
+	}
+
+	template<typename T>
+	const T* max_element(const Array<T>& array)
+	{
+		return max_element(array.buffer(), array.size());
+	}
+
+	template<typename T>
+	T sum(const Array<T>& array)
+	{
+		return sum(array.buffer(), array.size());
+	}
+
+	inline size_t count(Str_View view, char ch)
+	{
+		return count(view.data(), view.count(), ch);
+	}
+
+	inline bool contains(Str_View view, char ch)
+	{
+		return contains(view.data(), view.count(), ch);
+	}
+};
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "Simd.h"
+
 #include <type_traits>
 #include <exception>
 #include <stdexcept>
 #include <memory>
 #include <algorithm>
+#include <cstring>
 
 namespace hstl
 {
@@ -238,48 +241,86 @@ namespace hstl
 			count--;
 		}
 
+		// Doesn't keep the order of the survivors, removed elements are replaced by survivors from the back
+		// which moves as few elements as possible
 		template<typename F>
 		void remove_if(F f)
 		{
-			// TODO: Rework this function and decide whether it should follow the standard and maintain order or not.
-
-			// NOTE: This type trait will check if the result of F is __convertable__ to bool
-			// I'm not sure if this is desired but roll with it for now
 			static_assert(std::is_invocable_r_v<bool, F, const T&>, "Predicate must be callable as bool(const T&)");
-			if (count == 0)
-				return;
 
-			// FIXME: int64_t here is a narrowing conversion used to avoid underflow
-			int64_t last_survivior = count - 1;
-			for (int64_t i = count - 1; i >= 0; --i)
+			if constexpr (std::is_trivially_copyable_v<T> == true)
+			{
+				// Compaction is branchless and keeps the order anyway
+				count = compact_trivially_copyable(f);
+			}
+			else
 			{
-				if (f(data[i]) == false)
-					continue;
+				static_assert(std::is_move_assignable_v<T>, "T must have a move assignment operator");
 
-				if(last_survivior != i)
+				size_t read = 0u;
+				size_t end = count;
+
+				while (read < end)
 				{
-					if constexpr (std::is_scalar_v<T> == true)
+					if (f(data[read]) == false)
 					{
-						memcpy(&data[i], &data[last_survivior], sizeof(T));
+						++read;
+						continue;
 					}
-					else
-					{
-						static_assert(std::is_move_assignable_v<T>, "T must have a move assignment operator");
 
-						data[i] = std::move(data[last_survivior]);
+					// Pull the last survivor into the hole
+					--end;
 
-						std::destroy_at(&data[last_survivior]);
+					while (end > read && f(data[end]))
+					{
+						--end;
+					}
+
+					if (end == read)
+					{
+						break;
 					}
+
+					data[read] = std::move(data[end]);
+					++read;
 				}
-				else
+
+				std::destroy_n(data + end, count - end);
+				count = end;
+			}
+		}
+
+		template<typename F>
+		void remove_if_ordered(F f)
+		{
+			static_assert(std::is_invocable_r_v<bool, F, const T&>, "Predicate must be callable as bool(const T&)");
+
+			if constexpr (std::is_trivially_copyable_v<T> == true)
+			{
+				count = compact_trivially_copyable(f);
+			}
+			else
+			{
+				static_assert(std::is_move_assignable_v<T>, "T must have a move assignment operator");
+
+				size_t write = 0u;
+
+				while (write < count && f(data[write]) == false)
 				{
-					std::destroy_at(&data[i]);
+					++write;
 				}
 
-				last_survivior--;
-			}
+				for (size_t read = write; read < count; ++read)
+				{
+					if (f(data[read]) == false)
+					{
+						data[write++] = std::move(data[read]);
+					}
+				}
 
-			count = last_survivior + 1;
+				std::destroy_n(data + write, count - write);
+				count = write;
+			}
 		}
 
 		const_iterator begin() const noexcept
@@ -329,6 +370,66 @@ namespace hstl
 		size_t capacity() const { return _capacity; }
 
 	private:
+		// Stream compaction for types that can be copied as bytes, every element is written
+		// to the current write position and the position only advances for survivors, so there is
+		// no branch per element. With AVX2, 4 and 8 byte elements are packed a vector at a time.
+		// Returns the number of survivors
+		template<typename F>
+		size_t compact_trivially_copyable(F& f)
+		{
+			size_t write = 0u;
+			size_t read = 0u;
+
+#if defined(HSTL_SIMD_AVX2)
+			if constexpr (sizeof(T) == 4u || sizeof(T) == 8u)
+			{
+				constexpr size_t LANES = 32u / sizeof(T);
+
+				for (; read + LANES <= count; read += LANES)
+				{
+					uint32_t keep = 0u;
+
+					for (size_t lane = 0u; lane < LANES; ++lane)
+					{
+						keep |= static_cast<uint32_t>(f(data[read + lane]) == false) << lane;
+					}
+
+					// 8 byte elements are moved as pairs of 32-bit lanes
+					uint32_t lane_mask = keep;
+
+					if constexpr (sizeof(T) == 8u)
+					{
+						lane_mask = 0u;
+
+						for (size_t lane = 0u; lane < LANES; ++lane)
+						{
+							lane_mask |= ((keep >> lane) & 1u) * (3u << (lane * 2u));
+						}
+					}
+
+					__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + read));
+
+					// NOTE: write <= read, so the full-width store only clobbers elements that were already loaded
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + write), compress_32x8(block, lane_mask));
+
+					write += bit_count(keep);
+				}
+			}
+#endif
+
+			for (; read < count; ++read)
+			{
+				// Copy first, "write" may alias "read"
+				T element = data[read];
+				bool keep = f(element) == false;
+
+				memcpy(&data[write], &element, sizeof(T));
+				write += keep;
+			}
+
+			return write;
+		}
+
 		void grow_memory(size_t _cap, bool discard_old_data = false)
 		{
 			if (_cap <= _capacity)
@@ -411,7 +512,10 @@ namespace hstl
 		{
 			if constexpr (std::is_scalar_v<T> == true)
 			{
-				memset(start, 0, sizeof(T) * count);
+				if (count > 0u)
+				{
+					memset(start, 0, sizeof(T) * count);
+				}
 			}
 			else
 			{
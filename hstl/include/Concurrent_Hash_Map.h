@@ -0,0 +1,290 @@
+#pragma once
+
+#include "Hash_Map.h"
+#include "Spin_Lock.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <type_traits>
+#include <bit>
+
+namespace hstl
+{
+	// Hash_Map shared between threads, split into SHARD_COUNT independent Hash_Maps that each sit behind
+	// their own Shared_Spin_Lock. Threads working on different shards never wait for each other, and the
+	// shards are padded to a cache line so their locks don't share one either
+	// The key is hashed once: the bits right below the fingerprint pick the shard, the shard's Hash_Map
+	// uses the low bits for the home slot and the top 7 for the fingerprint as usual
+	// Values are copied out or reached through visit(), a pointer into a shard would outlive its lock
+	template<typename Key, typename Value, typename Hash = hstl::Hash<Key>, typename Eq = Equal_To<Key>,
+		size_t SHARD_COUNT = 64u, typename Options = Hash_Map_Options<Key, Value>>
+	class Concurrent_Hash_Map
+	{
+	private:
+		static_assert(std::has_single_bit(SHARD_COUNT), "SHARD_COUNT must be a power of two");
+
+		static constexpr size_t SHARD_BITS = std::countr_zero(SHARD_COUNT);
+
+		static_assert(SHARD_BITS <= 16u, "The shard bits are taken from below the fingerprint, keep them few");
+
+		using Map = Hash_Map<Key, Value, Hash, Eq, Options>;
+
+		struct alignas(CACHE_LINE_SIZE) Shard
+		{
+			mutable Shared_Spin_Lock lock;
+			Map map;
+		};
+
+		Hash hasher;
+		Shard shards[SHARD_COUNT];
+
+	private:
+		static size_t shard_index(size_t hash)
+		{
+			return (hash >> (57u - SHARD_BITS)) & (SHARD_COUNT - 1u);
+		}
+
+		// Keys of another type are only looked up as is with a transparent Hash/Eq, otherwise they're
+		// converted to a Key first, like Hash_Map does
+		template<typename K>
+		static constexpr bool IS_LOOKUP_KEY = Transparent_Hash<Hash, Eq> || std::is_same_v<std::remove_cvref_t<K>, Key>;
+
+	public:
+		Concurrent_Hash_Map() = default;
+
+		// Sizes every shard for its share of "capacity_hint" elements
+		explicit Concurrent_Hash_Map(size_t capacity_hint)
+		{
+			reserve(capacity_hint);
+		}
+
+		// Shards hold locks, a copy or a move would have to take all of them
+		Concurrent_Hash_Map(const Concurrent_Hash_Map&) = delete;
+		Concurrent_Hash_Map& operator=(const Concurrent_Hash_Map&) = delete;
+
+	public:
+		// Copies the value of "key" into "out", returns false (and leaves "out" alone) when it's missing
+		template<typename K>
+		bool get(const K& key, Value& out) const
+		{
+			return visit(key, [&out](const Value& value) { out = value; });
+		}
+
+		template<typename K>
+		bool contains(const K& key) const
+		{
+			return visit(key, [](const Value&) {});
+		}
+
+		// Inserts or overwrites, returns true when "key" was new
+		template<typename K, typename V>
+		bool insert(K&& key, V&& value)
+		{
+			if constexpr (IS_LOOKUP_KEY<K> == false)
+			{
+				return insert(Key(std::forward<K>(key)), std::forward<V>(value));
+			}
+			else
+			{
+				size_t hash = hasher(key);
+				Shard& shard = shards[shard_index(hash)];
+
+				std::unique_lock lock{shard.lock};
+
+				size_t count = shard.map.count();
+				shard.map.insert_hashed(std::forward<K>(key), std::forward<V>(value), hash);
+
+				return shard.map.count() != count;
+			}
+		}
+
+		// Builds the value from "args" only when "key" is missing, returns true when it did
+		template<typename K, typename... Args>
+		bool try_emplace(K&& key, Args&&... args)
+		{
+			return visit_or_emplace(std::forward<K>(key), [](Value&) {}, std::forward<Args>(args)...);
+		}
+
+		// Calls fn(value) on the value of "key" under the exclusive lock of its shard, after building the
+		// value from "args" when "key" is missing, e.g. counting: visit_or_emplace(word, [](int& n) { n++; })
+		// Returns true when the value was built
+		template<typename K, typename F, typename... Args>
+		bool visit_or_emplace(K&& key, F&& fn, Args&&... args)
+		{
+			if constexpr (IS_LOOKUP_KEY<K> == false)
+			{
+				return visit_or_emplace(Key(std::forward<K>(key)), std::forward<F>(fn), std::forward<Args>(args)...);
+			}
+			else
+			{
+				size_t hash = hasher(key);
+				Shard& shard = shards[shard_index(hash)];
+
+				std::unique_lock lock{shard.lock};
+
+				auto [value, inserted] = shard.map.try_emplace_hashed(std::forward<K>(key), hash, std::forward<Args>(args)...);
+				fn(value);
+
+				return inserted;
+			}
+		}
+
+		template<typename K>
+		bool remove(const K& key)
+		{
+			if constexpr (IS_LOOKUP_KEY<K> == false)
+			{
+				return remove(Key(key));
+			}
+			else
+			{
+				size_t hash = hasher(key);
+				Shard& shard = shards[shard_index(hash)];
+
+				std::unique_lock lock{shard.lock};
+
+				return shard.map.remove_hashed(key, hash);
+			}
+		}
+
+		// Calls fn(value) under the shared lock of the shard, other readers of the shard go on meanwhile
+		// Returns false without calling "fn" when "key" is missing
+		// NOTE: "fn" must not call back into the map, the lock isn't reentrant
+		template<typename K, typename F>
+		bool visit(const K& key, F&& fn) const
+		{
+			if constexpr (IS_LOOKUP_KEY<K> == false)
+			{
+				return visit(Key(key), std::forward<F>(fn));
+			}
+			else
+			{
+				size_t hash = hasher(key);
+				const Shard& shard = shards[shard_index(hash)];
+
+				std::shared_lock lock{shard.lock};
+
+				const Value* value = shard.map.get_hashed(key, hash);
+
+				if (value == nullptr)
+				{
+					return false;
+				}
+
+				fn(*value);
+
+				return true;
+			}
+		}
+
+		// Calls fn(value) with a mutable value under the exclusive lock of the shard
+		template<typename K, typename F>
+		bool visit(const K& key, F&& fn)
+		{
+			if constexpr (IS_LOOKUP_KEY<K> == false)
+			{
+				return visit(Key(key), std::forward<F>(fn));
+			}
+			else
+			{
+				size_t hash = hasher(key);
+				Shard& shard = shards[shard_index(hash)];
+
+				std::unique_lock lock{shard.lock};
+
+				Value* value = shard.map.get_hashed(key, hash);
+
+				if (value == nullptr)
+				{
+					return false;
+				}
+
+				fn(*value);
+
+				return true;
+			}
+		}
+
+		// Calls fn(key, value) for every element, one shard at a time under its shared lock. Not a snapshot:
+		// the shards that were already visited can change while the others are
+		template<typename F>
+		void for_each(F&& fn) const
+		{
+			for (const Shard& shard : shards)
+			{
+				std::shared_lock lock{shard.lock};
+
+				shard.map.for_each(fn);
+			}
+		}
+
+		// Same with mutable values, under the exclusive lock of every shard in turn
+		template<typename F>
+		void for_each(F&& fn)
+		{
+			for (Shard& shard : shards)
+			{
+				std::unique_lock lock{shard.lock};
+
+				shard.map.for_each(fn);
+			}
+		}
+
+		// Makes room for "count" elements in total, assuming the hash spreads them evenly over the shards
+		void reserve(size_t count)
+		{
+			size_t per_shard = (count + SHARD_COUNT - 1u) / SHARD_COUNT;
+
+			for (Shard& shard : shards)
+			{
+				std::unique_lock lock{shard.lock};
+
+				shard.map.reserve(per_shard);
+			}
+		}
+
+		// Removes every element, the shards keep their tables (see Hash_Map::clear)
+		void clear()
+		{
+			for (Shard& shard : shards)
+			{
+				std::unique_lock lock{shard.lock};
+
+				shard.map.clear();
+			}
+		}
+
+		// Sum of the shard counts, only exact while no other thread inserts or removes
+		size_t count() const
+		{
+			size_t total = 0u;
+
+			for (const Shard& shard : shards)
+			{
+				std::shared_lock lock{shard.lock};
+
+				total += shard.map.count();
+			}
+
+			return total;
+		}
+
+		// Sum of the shard capacities
+		size_t capacity() const
+		{
+			size_t total = 0u;
+
+			for (const Shard& shard : shards)
+			{
+				std::shared_lock lock{shard.lock};
+
+				total += shard.map.capacity();
+			}
+
+			return total;
+		}
+
+		static constexpr size_t shard_count() { return SHARD_COUNT; }
+	};
+};
@@ -0,0 +1,514 @@
+#pragma once
+
+#include "Array.h"
+#include "Hash_Group.h"
+#include "Hash.h"
+
+#include <functional>
+#include <utility>
+#include <type_traits>
+#include <limits>
+#include <cstdint>
+#include <assert.h>
+
+namespace hstl
+{
+	// Hash map whose keys and values live packed in two Arrays, in insertion order until a remove moves the
+	// last element into the hole (swap-remove, like Array::remove). The hash table only holds a control
+	// byte and a 32-bit index per bucket, 5 bytes that stay in the cache long after the slots of a Hash_Map
+	// wouldn't. Iterating is a walk over the two Arrays, at the price of one more indirection per lookup
+	// Meant for the maps that get iterated every frame (loaded assets, active sounds), Hash_Map stays
+	// the better fit for lookup-heavy maps
+	template<typename Key, typename Value, typename Hash = hstl::Hash<Key>, typename Eq = Equal_To<Key>>
+	class Dense_Hash_Map
+	{
+	private:
+		static constexpr size_t MIN_CAPACITY = 16u;
+		static constexpr size_t GROWTH_FACTOR = 2u;
+		static constexpr float LOAD_FACTOR = 0.875f;
+		static constexpr uint8_t BIT_OCCUPIED = 0b10000000;
+		static constexpr size_t MAX_COUNT = std::numeric_limits<uint32_t>::max();
+
+		using Group = detail::Control_Group;
+
+		static_assert(MIN_CAPACITY % Group::WIDTH == 0u, "The table must be made of whole groups");
+
+		Eq equalizer;
+		Hash hasher;
+		Array<Key> keys;
+		Array<Value> values; // values[i] belongs to keys[i]
+		Array<uint8_t> states; // Control bytes of the buckets, see Hash_Group.h
+		Array<uint32_t> indices; // Parallel to "states", where the element of an occupied bucket is in keys/values
+
+	private:
+		static bool is_empty(uint8_t control_byte)
+		{
+			return (control_byte & BIT_OCCUPIED) == 0;
+		}
+
+		static uint8_t make_control_byte(size_t hash)
+		{
+			static_assert(sizeof(size_t) == 8, "The logic is built upon the assumption that size_t is 8 bytes");
+
+			uint8_t fingerprint = static_cast<uint8_t>(hash >> 57);
+
+			return fingerprint | BIT_OCCUPIED;
+		}
+
+		struct Probe_Result
+		{
+			size_t bucket; // Bucket of the key when found, otherwise the empty bucket where it would go
+			bool found;
+		};
+
+		// Linear probing a group at a time, see Hash_Map::probe. "is_target(element_index)" decides a
+		// fingerprint match, either by comparing keys or by looking for a known element
+		template<typename Is_Target>
+		Probe_Result probe_for(size_t hash, Is_Target is_target) const
+		{
+			size_t mask = states.size() - 1u;
+			size_t home = hash & mask;
+			size_t group_index = home & ~(Group::WIDTH - 1u);
+			uint8_t control_byte = make_control_byte(hash);
+			auto window = Group::bits_from(home - group_index);
+
+			while (true)
+			{
+				Group group{&states[group_index]};
+
+				auto empties = group.match_empty() & window;
+				auto matches = group.match(control_byte) & window & detail::bits_before_first(empties);
+
+				while (matches != 0u)
+				{
+					size_t bucket = group_index + Group::index_of(matches);
+
+					if (is_target(indices[bucket]))
+					{
+						return Probe_Result{bucket, true};
+					}
+
+					matches = clear_lowest_bit(matches);
+				}
+
+				if (empties != 0u)
+				{
+					return Probe_Result{group_index + Group::index_of(empties), false};
+				}
+
+				group_index = (group_index + Group::WIDTH) & mask;
+				window = Group::ALL;
+			}
+		}
+
+		template<typename K>
+		Probe_Result probe(const K& key, size_t hash) const
+		{
+			return probe_for(hash, [&](uint32_t index) { return equalizer(key, keys[index]); });
+		}
+
+		static size_t find_empty(const Array<uint8_t>& control_bytes, size_t hash)
+		{
+			size_t mask = control_bytes.size() - 1u;
+			size_t home = hash & mask;
+			size_t group_index = home & ~(Group::WIDTH - 1u);
+			auto window = Group::bits_from(home - group_index);
+
+			while (true)
+			{
+				auto empties = Group{&control_bytes[group_index]}.match_empty() & window;
+
+				if (empties != 0u)
+				{
+					return group_index + Group::index_of(empties);
+				}
+
+				group_index = (group_index + Group::WIDTH) & mask;
+				window = Group::ALL;
+			}
+		}
+
+		template<typename K>
+		const Value* find_value(const K& key) const
+		{
+			if (keys.size() == 0u)
+			{
+				return nullptr;
+			}
+
+			auto [bucket, found] = probe(key, hasher(key));
+
+			return found ? &values[indices[bucket]] : nullptr;
+		}
+
+		// Backward-shift deletion of a bucket, see Hash_Map::remove_key. The keys are hashed again to find
+		// the homes of the shifted buckets, they aren't stored
+		void erase_bucket(size_t hole)
+		{
+			size_t size = states.size();
+			size_t mask = size - 1u;
+			size_t current = (hole + 1u) & mask;
+
+			auto dist = [mask, size](size_t a, size_t b) { return (b + size - a) & mask; };
+
+			while (is_empty(states[current]) == false)
+			{
+				size_t home = hasher(keys[indices[current]]) & mask;
+
+				if (dist(home, hole) <= dist(home, current))
+				{
+					states[hole] = states[current];
+					indices[hole] = indices[current];
+					hole = current;
+				}
+
+				current = (current + 1u) & mask;
+			}
+
+			states[hole] = 0;
+		}
+
+		template<typename K>
+		bool remove_key(const K& key)
+		{
+			if (keys.size() == 0u)
+			{
+				return false;
+			}
+
+			auto [bucket, found] = probe(key, hasher(key));
+
+			if (found == false)
+			{
+				return false;
+			}
+
+			uint32_t index = indices[bucket];
+			uint32_t last = static_cast<uint32_t>(keys.size() - 1u);
+
+			erase_bucket(bucket);
+
+			// The last element moves into the hole, its bucket has to follow
+			if (index != last)
+			{
+				auto [last_bucket, last_found] = probe_for(hasher(keys[last]), [last](uint32_t other) { return other == last; });
+
+				assert(last_found);
+
+				indices[last_bucket] = index;
+			}
+
+			keys.remove(index);
+			values.remove(index);
+
+			return true;
+		}
+
+		// Smallest table that holds "count" elements without growing, nothing at all for zero elements
+		static size_t capacity_for(size_t count)
+		{
+			if (count == 0u)
+			{
+				return 0u;
+			}
+
+			size_t capacity = MIN_CAPACITY;
+
+			while (static_cast<size_t>(LOAD_FACTOR * capacity) < count)
+			{
+				capacity *= GROWTH_FACTOR;
+			}
+
+			return capacity;
+		}
+
+		// Rebuilds the index table with "new_size" buckets, the elements themselves don't move
+		void rehash(size_t new_size)
+		{
+			auto new_states = Array<uint8_t>{};
+			auto new_indices = Array<uint32_t>{};
+
+			if (new_size > 0u)
+			{
+				new_states = Array<uint8_t>{new_size};
+				new_indices = Array<uint32_t>{new_size};
+			}
+
+			for (size_t i = 0u; i < keys.size(); ++i)
+			{
+				size_t hash = hasher(keys[i]);
+				size_t bucket = find_empty(new_states, hash);
+
+				new_states[bucket] = make_control_byte(hash);
+				new_indices[bucket] = static_cast<uint32_t>(i);
+			}
+
+			states = std::move(new_states);
+			indices = std::move(new_indices);
+		}
+
+		struct Insert_Bucket
+		{
+			size_t bucket;
+			bool found;
+		};
+
+		template<typename K>
+		Insert_Bucket find_insert_bucket(const K& key, size_t hash)
+		{
+			if (keys.size() >= static_cast<size_t>(LOAD_FACTOR * states.size()))
+			{
+				rehash(states.size() > 0u ? states.size() * GROWTH_FACTOR : MIN_CAPACITY);
+			}
+
+			auto [bucket, found] = probe(key, hash);
+
+			return Insert_Bucket{bucket, found};
+		}
+
+		// Registers the element that was just pushed to keys/values in "bucket"
+		void occupy(size_t bucket, size_t hash)
+		{
+			assert(keys.size() <= MAX_COUNT);
+
+			states[bucket] = make_control_byte(hash);
+			indices[bucket] = static_cast<uint32_t>(keys.size() - 1u);
+		}
+
+	public:
+		// Allocates nothing, the table is created by the first insert
+		Dense_Hash_Map() = default;
+
+		// Sizes the table and the Arrays for "capacity_hint" elements up front
+		explicit Dense_Hash_Map(size_t capacity_hint)
+		{
+			reserve(capacity_hint);
+		}
+
+	public:
+		struct Insert_Result
+		{
+			Value& value;
+			bool inserted; // False when the key was already there and "value" is the existing one
+		};
+
+		// New keys go to the back of the Arrays, an existing key keeps its place and gets the new value
+		// With a transparent Hash/Eq the Key is only built when it's missing, see Hash_Map::insert
+		template<typename K, typename V>
+		Value& insert(K&& key, V&& value)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return insert(Key(std::forward<K>(key)), std::forward<V>(value));
+			}
+			else
+			{
+				auto hash = hasher(key);
+				auto [bucket, found] = find_insert_bucket(key, hash);
+
+				if (found)
+				{
+					Value& existing = values[indices[bucket]];
+					existing = std::forward<V>(value); // overwrite existing
+					return existing;
+				}
+
+				keys.push(Key(std::forward<K>(key)));
+				Value& inserted = values.push(Value(std::forward<V>(value)));
+				occupy(bucket, hash);
+
+				return inserted;
+			}
+		}
+
+		// Builds the value from "args" only when "key" is missing, see Hash_Map::try_emplace
+		template<typename K, typename... Args>
+		Insert_Result try_emplace(K&& key, Args&&... args)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return try_emplace(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+			}
+			else
+			{
+				auto hash = hasher(key);
+				auto [bucket, found] = find_insert_bucket(key, hash);
+
+				if (found)
+				{
+					return Insert_Result{values[indices[bucket]], false};
+				}
+
+				keys.push(Key(std::forward<K>(key)));
+				Value& inserted = values.emplace(std::forward<Args>(args)...);
+				occupy(bucket, hash);
+
+				return Insert_Result{inserted, true};
+			}
+		}
+
+		template<typename K>
+		Insert_Result get_or_insert_default(K&& key)
+		{
+			return try_emplace(std::forward<K>(key));
+		}
+
+		const Value* get(const Key& key) const
+		{
+			return find_value(key);
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		const Value* get(const K& key) const
+		{
+			return find_value(key);
+		}
+
+		Value* get(const Key& key)
+		{
+			return const_cast<Value*>(find_value(key));
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		Value* get(const K& key)
+		{
+			return const_cast<Value*>(find_value(key));
+		}
+
+		bool contains(const Key& key) const
+		{
+			return find_value(key) != nullptr;
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool contains(const K& key) const
+		{
+			return find_value(key) != nullptr;
+		}
+
+		// Moves the last element into the place of the removed one
+		bool remove(const Key& key)
+		{
+			return remove_key(key);
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool remove(const K& key)
+		{
+			return remove_key(key);
+		}
+
+		// Makes room for "count" elements in total, in the table and in the Arrays
+		void reserve(size_t count)
+		{
+			size_t new_size = capacity_for(count);
+
+			if (new_size > states.size())
+			{
+				rehash(new_size);
+			}
+
+			keys.reserve(count);
+			values.reserve(count);
+		}
+
+		// Keeps the memory of the table and the Arrays
+		void clear()
+		{
+			keys.clear();
+			values.clear();
+
+			for (uint8_t& state : states)
+			{
+				state = 0u;
+			}
+		}
+
+		size_t count() const { return keys.size(); }
+		size_t capacity() const { return states.size(); } // Buckets of the index table
+
+		// Packed views of the storage, keys[i] goes with values[i]
+		const Array<Key>& key_array() const { return keys; }
+		const Array<Value>& value_array() const { return values; }
+		Array<Value>& value_array() { return values; }
+
+	public: // Iterator-related, walks the elements in storage order
+		template<typename V>
+		struct Basic_Entry
+		{
+			const Key& key;
+			V& value;
+		};
+
+		using Entry = Basic_Entry<Value>;
+		using Const_Entry = Basic_Entry<const Value>;
+
+		// Calls fn(key, value) for every element in storage order, with a mutable value on a non-const map
+		// NOTE: must not insert into or remove from the map
+		template<typename F>
+		void for_each(F&& fn)
+		{
+			for (size_t i = 0u; i < keys.size(); ++i)
+			{
+				fn(static_cast<const Key&>(keys[i]), values[i]);
+			}
+		}
+
+		template<typename F>
+		void for_each(F&& fn) const
+		{
+			for (size_t i = 0u; i < keys.size(); ++i)
+			{
+				fn(keys[i], values[i]);
+			}
+		}
+
+		template<typename V>
+		class Basic_Iterator // Input Iterator, yields Basic_Entry by value like Flat_Map's iterator
+		{
+		public:
+			Basic_Iterator(const Key* key_ptr, V* value_ptr):
+				key_ptr{key_ptr},
+				value_ptr{value_ptr}
+			{
+
+			}
+
+			Basic_Iterator& operator++()
+			{
+				++key_ptr;
+				++value_ptr;
+
+				return *this;
+			}
+
+			bool operator!=(const Basic_Iterator& other) const
+			{
+				return key_ptr != other.key_ptr;
+			}
+
+			bool operator==(const Basic_Iterator& other) const
+			{
+				return key_ptr == other.key_ptr;
+			}
+
+			Basic_Entry<V> operator*() const
+			{
+				return Basic_Entry<V>{*key_ptr, *value_ptr};
+			}
+
+		private:
+			const Key* key_ptr{nullptr};
+			V* value_ptr{nullptr};
+		};
+
+		using Iterator = Basic_Iterator<const Value>;
+		using Mutable_Iterator = Basic_Iterator<Value>;
+
+		Iterator begin() const { return Iterator{keys.begin(), values.begin()}; }
+		Iterator end() const { return Iterator{keys.end(), values.end()}; }
+
+		Mutable_Iterator begin() { return Mutable_Iterator{keys.begin(), values.begin()}; }
+		Mutable_Iterator end() { return Mutable_Iterator{keys.end(), values.end()}; }
+	};
+};
@@ -0,0 +1,245 @@
+#pragma once
+
+#include "Array.h"
+#include "Spin_Lock.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+
+namespace hstl
+{
+	// Epoch-based reclamation: lets lock-free readers keep using memory that a writer already unlinked.
+	// A reader pins the current epoch for the duration of its read (a Guard), a writer retires what it
+	// unlinked instead of deleting it, and retired memory is freed once every pinned reader has moved two
+	// epochs past the retirement, by then nobody can still hold a pointer to it
+	// Pinning is one load, one store and one fence: it never waits, so readers stay wait-free. Writers pay
+	// for the reclamation, a scan of the thread slots every so often
+	// There is one domain for the whole process, every thread that reads takes one of its MAX_THREADS
+	// slots on first use and gives it back when it exits
+	// NOTE: past MAX_THREADS live reading threads, the first pin of a new thread blocks until one exits
+	class Epoch_Domain
+	{
+	public:
+		static constexpr size_t MAX_THREADS = 256u;
+
+		static Epoch_Domain& get()
+		{
+			static Epoch_Domain domain;
+
+			return domain;
+		}
+
+		Epoch_Domain(const Epoch_Domain&) = delete;
+		Epoch_Domain& operator=(const Epoch_Domain&) = delete;
+
+		~Epoch_Domain()
+		{
+			for (const Retired& retired_object : retired)
+			{
+				retired_object.deleter(retired_object.object);
+			}
+		}
+
+	private:
+		// The slot of the calling thread, claimed the first time it pins and released when it exits
+		struct Thread_Entry
+		{
+			size_t slot{get().claim_slot()};
+			uint32_t depth{0u};
+
+			Thread_Entry() = default;
+			Thread_Entry(const Thread_Entry&) = delete;
+			Thread_Entry& operator=(const Thread_Entry&) = delete;
+
+			~Thread_Entry()
+			{
+				get().release_slot(slot);
+			}
+		};
+
+		static Thread_Entry& local_entry()
+		{
+			thread_local Thread_Entry entry;
+
+			return entry;
+		}
+
+	public:
+		// Pins the epoch of the calling thread while it lives, nests freely
+		class Guard
+		{
+		public:
+			Guard():
+				entry{local_entry()}
+			{
+				if (entry.depth++ == 0u)
+				{
+					Epoch_Domain& domain = get();
+
+					domain.slots[entry.slot].epoch.store(domain.global_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+					// The pin must be visible to a writer's scan before this thread reads any shared pointer
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+				}
+			}
+
+			~Guard()
+			{
+				if (--entry.depth == 0u)
+				{
+					get().slots[entry.slot].epoch.store(QUIESCENT, std::memory_order_release);
+				}
+			}
+
+			Guard(const Guard&) = delete;
+			Guard& operator=(const Guard&) = delete;
+
+		private:
+			Thread_Entry& entry;
+		};
+
+		// Hands "object" over to the domain, deleter(object) runs once no reader can reach it anymore
+		// "object" must already be unlinked, "bytes" is its size, a few large objects trigger a collection
+		// as soon as many small ones
+		void retire(void* object, void (*deleter)(void*), size_t bytes)
+		{
+			std::lock_guard lock{retired_mutex};
+
+			retired.push(Retired{object, deleter, global_epoch.load(std::memory_order_acquire)});
+			retired_bytes += bytes;
+
+			if (retired.size() >= COLLECT_COUNT || retired_bytes >= COLLECT_BYTES)
+			{
+				collect_locked();
+			}
+		}
+
+		template<typename T>
+		void retire(T* object)
+		{
+			retire(object, [](void* pointer) { delete static_cast<T*>(pointer); }, sizeof(T));
+		}
+
+		// Frees what can be freed right now, e.g. after a burst of writes
+		void collect()
+		{
+			std::lock_guard lock{retired_mutex};
+
+			collect_locked();
+		}
+
+		size_t retired_count() const
+		{
+			std::lock_guard lock{retired_mutex};
+
+			return retired.size();
+		}
+
+	private:
+		static constexpr uint64_t QUIESCENT = 0u; // Slot value of a thread outside any Guard
+		static constexpr size_t COLLECT_COUNT = 64u;
+		static constexpr size_t COLLECT_BYTES = 1u << 20u;
+
+		struct alignas(CACHE_LINE_SIZE) Thread_Slot
+		{
+			std::atomic<uint64_t> epoch{QUIESCENT};
+			std::atomic<bool> claimed{false};
+		};
+
+		struct Retired
+		{
+			void* object;
+			void (*deleter)(void*);
+			uint64_t epoch;
+		};
+
+		Epoch_Domain() = default;
+
+		// Two threads on one slot would unpin each other, so with every slot taken this waits for a reading
+		// thread to exit
+		size_t claim_slot()
+		{
+			while (true)
+			{
+				for (size_t i = 0u; i < MAX_THREADS; ++i)
+				{
+					bool expected = false;
+
+					if (slots[i].claimed.load(std::memory_order_relaxed) == false &&
+						slots[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+					{
+						return i;
+					}
+				}
+
+				std::this_thread::yield();
+			}
+		}
+
+		void release_slot(size_t slot)
+		{
+			slots[slot].claimed.store(false, std::memory_order_release);
+		}
+
+		// The epoch moves on once every pinned thread has seen the current one
+		bool try_advance()
+		{
+			uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			for (const Thread_Slot& slot : slots)
+			{
+				uint64_t pinned = slot.epoch.load(std::memory_order_acquire);
+
+				if (pinned != QUIESCENT && pinned != epoch)
+				{
+					return false;
+				}
+			}
+
+			global_epoch.store(epoch + 1u, std::memory_order_release);
+
+			return true;
+		}
+
+		// Objects retired in epoch E are unreachable once the epoch reaches E + 2: every reader that could
+		// have seen them has left its Guard, the readers since then started after the unlink
+		void collect_locked()
+		{
+			for (int i = 0; i < 2 && try_advance(); ++i)
+			{
+			}
+
+			uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+
+			size_t kept = 0u;
+
+			for (size_t i = 0u; i < retired.size(); ++i)
+			{
+				if (retired[i].epoch + 2u <= epoch)
+				{
+					retired[i].deleter(retired[i].object);
+				}
+				else
+				{
+					retired[kept++] = retired[i];
+				}
+			}
+
+			retired.resize(kept);
+
+			retired_bytes = 0u; // Only used to pace the collections, restarts from what is still retired
+		}
+
+		std::atomic<uint64_t> global_epoch{1u};
+		Thread_Slot slots[MAX_THREADS];
+
+		mutable std::mutex retired_mutex;
+		Array<Retired> retired;
+		size_t retired_bytes{0u};
+	};
+};
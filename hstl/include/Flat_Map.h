@@ -0,0 +1,212 @@
+#pragma once
+
+#include "Array.h"
+#include "Algorithms.h"
+
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <assert.h>
+
+namespace hstl
+{
+	// Sorted map on two parallel Arrays, lookups are a branchless binary search over the keys only
+	// Meant for small to medium tables that are read much more often than they are written,
+	// insert/remove are O(N) because they shift the tail
+	template<typename Key, typename Value, typename Less = std::less<Key>>
+	class Flat_Map
+	{
+	private:
+		Less less;
+		Array<Key> keys;
+		Array<Value> values;
+
+	private:
+		size_t lower_bound_index(const Key& key) const
+		{
+			return static_cast<size_t>(hstl::lower_bound(keys.buffer(), keys.size(), key, less) - keys.buffer());
+		}
+
+		bool is_match(size_t index, const Key& key) const
+		{
+			return index < keys.size() && less(key, keys[index]) == false;
+		}
+
+		template<typename T>
+		static void insert_at(Array<T>& array, size_t index, T&& element)
+		{
+			array.push(std::move(element));
+			std::rotate(array.begin() + index, array.end() - 1, array.end());
+		}
+
+	public:
+		Flat_Map() = default;
+
+		// Bulk build: takes unsorted parallel arrays, sorts them once and drops duplicated keys
+		// When a key shows up more than once the last value wins, like repeated insert() calls
+		Flat_Map(Array<Key>&& unsorted_keys, Array<Value>&& unsorted_values, Less _less = Less{}):
+			less{std::move(_less)}
+		{
+			assert(unsorted_keys.size() == unsorted_values.size());
+
+			size_t count = unsorted_keys.size();
+
+			Array<size_t> order{count};
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				order[i] = i;
+			}
+
+			// Stable so that duplicates stay in insertion order and the last one can win
+			std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+			{
+				return less(unsorted_keys[a], unsorted_keys[b]);
+			});
+
+			keys.reserve(count);
+			values.reserve(count);
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				size_t source = order[i];
+
+				if (keys.size() > 0u && less(keys[keys.size() - 1u], unsorted_keys[source]) == false)
+				{
+					values[values.size() - 1u] = std::move(unsorted_values[source]);
+					continue;
+				}
+
+				keys.push(std::move(unsorted_keys[source]));
+				values.push(std::move(unsorted_values[source]));
+			}
+		}
+
+	public:
+		template<typename K, typename V>
+		Value& insert(K&& key, V&& value)
+		{
+			size_t index = lower_bound_index(key);
+
+			if (is_match(index, key))
+			{
+				values[index] = std::forward<V>(value); // overwrite existing
+				return values[index];
+			}
+
+			insert_at(keys, index, Key(std::forward<K>(key)));
+			insert_at(values, index, Value(std::forward<V>(value)));
+
+			return values[index];
+		}
+
+		const Value* get(const Key& key) const
+		{
+			size_t index = lower_bound_index(key);
+
+			return is_match(index, key) ? &values[index] : nullptr;
+		}
+
+		Value* get(const Key& key)
+		{
+			size_t index = lower_bound_index(key);
+
+			return is_match(index, key) ? &values[index] : nullptr;
+		}
+
+		bool contains(const Key& key) const
+		{
+			return is_match(lower_bound_index(key), key);
+		}
+
+		bool remove(const Key& key)
+		{
+			size_t index = lower_bound_index(key);
+
+			if (is_match(index, key) == false)
+			{
+				return false;
+			}
+
+			keys.remove_ordered(index);
+			values.remove_ordered(index);
+
+			return true;
+		}
+
+		void reserve(size_t capacity)
+		{
+			keys.reserve(capacity);
+			values.reserve(capacity);
+		}
+
+		void clear()
+		{
+			keys.clear();
+			values.clear();
+		}
+
+		size_t count() const { return keys.size(); }
+		size_t capacity() const { return keys.capacity(); }
+
+		// Sorted views of the storage
+		const Array<Key>& key_array() const { return keys; }
+		const Array<Value>& value_array() const { return values; }
+
+	public: // Iterator-related
+		struct Entry
+		{
+			const Key& key;
+			const Value& value;
+		};
+
+		class Iterator // Input Iterator, walks the entries in key order
+		{
+		public:
+			Iterator(const Key* key_ptr, const Value* value_ptr):
+				key_ptr{key_ptr},
+				value_ptr{value_ptr}
+			{
+
+			}
+
+			Iterator& operator++()
+			{
+				++key_ptr;
+				++value_ptr;
+
+				return *this;
+			}
+
+			bool operator!=(const Iterator& other) const
+			{
+				return key_ptr != other.key_ptr;
+			}
+
+			bool operator==(const Iterator& other) const
+			{
+				return key_ptr == other.key_ptr;
+			}
+
+			Entry operator*() const
+			{
+				return Entry{*key_ptr, *value_ptr};
+			}
+
+		private:
+			const Key* key_ptr{nullptr};
+			const Value* value_ptr{nullptr};
+		};
+
+		Iterator begin() const
+		{
+			return Iterator{keys.begin(), values.begin()};
+		}
+
+		Iterator end() const
+		{
+			return Iterator{keys.end(), values.end()};
+		}
+	};
+};
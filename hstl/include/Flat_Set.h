@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Array.h"
+#include "Algorithms.h"
+
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+namespace hstl
+{
+	// Sorted set on a single Array, see Flat_Map
+	template<typename T, typename Less = std::less<T>>
+	class Flat_Set
+	{
+	private:
+		Less less;
+		Array<T> values;
+
+	private:
+		size_t lower_bound_index(const T& key) const
+		{
+			return static_cast<size_t>(hstl::lower_bound(values.buffer(), values.size(), key, less) - values.buffer());
+		}
+
+		bool is_match(size_t index, const T& key) const
+		{
+			return index < values.size() && less(key, values[index]) == false;
+		}
+
+	public:
+		Flat_Set() = default;
+
+		// Bulk build: sorts the unsorted values once and drops the duplicates
+		Flat_Set(Array<T>&& unsorted_values, Less _less = Less{}):
+			less{std::move(_less)}
+		{
+			std::sort(unsorted_values.begin(), unsorted_values.end(), less);
+
+			values.reserve(unsorted_values.size());
+
+			for (auto& value : unsorted_values)
+			{
+				if (values.size() > 0u && less(values[values.size() - 1u], value) == false)
+				{
+					continue;
+				}
+
+				values.push(std::move(value));
+			}
+		}
+
+	public:
+		template<typename K>
+		const T& insert(K&& key)
+		{
+			size_t index = lower_bound_index(key);
+
+			if (is_match(index, key))
+			{
+				return values[index];
+			}
+
+			values.push(T(std::forward<K>(key)));
+			std::rotate(values.begin() + index, values.end() - 1, values.end());
+
+			return values[index];
+		}
+
+		const T* get(const T& key) const
+		{
+			size_t index = lower_bound_index(key);
+
+			return is_match(index, key) ? &values[index] : nullptr;
+		}
+
+		bool contains(const T& key) const
+		{
+			return is_match(lower_bound_index(key), key);
+		}
+
+		bool remove(const T& key)
+		{
+			size_t index = lower_bound_index(key);
+
+			if (is_match(index, key) == false)
+			{
+				return false;
+			}
+
+			values.remove_ordered(index);
+
+			return true;
+		}
+
+		void reserve(size_t capacity) { values.reserve(capacity); }
+		void clear() { values.clear(); }
+
+		size_t count() const { return values.size(); }
+		size_t capacity() const { return values.capacity(); }
+
+		// Sorted view of the storage
+		const Array<T>& value_array() const { return values; }
+
+	public: // Iterator-related, walks the values in order
+		const T* begin() const { return values.begin(); }
+		const T* end() const { return values.end(); }
+	};
+};
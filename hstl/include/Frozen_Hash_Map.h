@@ -0,0 +1,544 @@
+#pragma once
+
+#include "Array.h"
+#include "Hash.h"
+#include "Result.h"
+#include "Str.h"
+#include "Simd.h"
+
+#include <type_traits>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace hstl
+{
+	namespace detail
+	{
+		inline constexpr uint32_t FROZEN_MAGIC = 0x5A524648u; // "HFRZ"
+		inline constexpr uint32_t FROZEN_VERSION = 1u;
+
+		// Average number of keys per displacement bucket, fewer is a faster build and a bigger blob
+		inline constexpr size_t FROZEN_KEYS_PER_BUCKET = 4u;
+
+		// Attempts with a fresh seed when a bucket can't be placed, each attempt starts over
+		inline constexpr uint64_t FROZEN_MAX_SEED_ATTEMPTS = 16u;
+		inline constexpr uint32_t FROZEN_MAX_D0 = 1u << 16u;
+
+		// Start of a blob, every offset is from the start of the blob and a multiple of 8
+		// NOTE: integers and keys are stored in the byte order of the machine that built the blob, the
+		// blob is read as-is on a target with the same byte order
+		struct Frozen_Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t key_size; // 0 for string keys
+			uint32_t value_size;
+			uint64_t seed;
+			uint64_t count; // Also the number of slots, the hash is minimal
+			uint64_t bucket_count;
+			uint64_t displacements_offset; // Frozen_Displacement[bucket_count]
+			uint64_t keys_offset; // Key[count], or Frozen_String[count] for string keys
+			uint64_t values_offset; // Value[count]
+			uint64_t strings_offset; // Characters of the string keys, back to back
+			uint64_t size; // Of the whole blob
+		};
+
+		// Where the keys of a bucket go: slot = (base(hash, d0) + d1) % count
+		struct Frozen_Displacement
+		{
+			uint32_t d0;
+			uint32_t d1;
+		};
+
+		// A string key, "tag" is the low half of its hash so that most misses don't read the characters
+		struct Frozen_String
+		{
+			uint64_t offset; // From strings_offset
+			uint32_t size;
+			uint32_t tag;
+		};
+
+		HSTL_FORCE_INLINE constexpr uint32_t frozen_range(uint32_t value, uint64_t range)
+		{
+			return static_cast<uint32_t>((static_cast<uint64_t>(value) * range) >> 32u);
+		}
+
+		HSTL_FORCE_INLINE constexpr uint32_t frozen_bucket(uint64_t hash, uint64_t bucket_count)
+		{
+			return frozen_range(static_cast<uint32_t>(hash >> 32u), bucket_count);
+		}
+
+		// First slot candidate of a key for a given d0, every d0 is an independent draw
+		HSTL_FORCE_INLINE constexpr uint32_t frozen_base(uint64_t hash, uint32_t d0, uint64_t count)
+		{
+			return frozen_range(static_cast<uint32_t>(mix(hash ^ HASH_SECRET[2] ^ d0, HASH_SECRET[0])), count);
+		}
+
+		HSTL_FORCE_INLINE constexpr uint32_t frozen_slot(uint32_t base, uint32_t d1, uint64_t count)
+		{
+			uint64_t slot = static_cast<uint64_t>(base) + d1;
+
+			return static_cast<uint32_t>(slot >= count ? slot - count : slot);
+		}
+
+		inline constexpr uint64_t frozen_align(uint64_t offset)
+		{
+			return (offset + 7u) & ~uint64_t{7u};
+		}
+	}
+
+	// Read-only hash map over a flat blob, for tables that are built offline and only queried at runtime
+	// (asset names to file offsets). build() computes a minimal perfect hash in the style of CHD (hash,
+	// displace and compress): keys are split into buckets of about 4 and every bucket gets a displacement
+	// that sends its keys to free slots, so each key owns exactly one of "count" slots. A lookup is one
+	// hash, one displacement read and one key compare, with no probing
+	// The blob has no pointers and no padding to fix up: view() checks the header and points into it, so a
+	// table can be memory mapped (see Mapped_File) and queried right away, nothing is parsed or allocated
+	// Keys are either Str_View (strings, copied into the blob) or trivially copyable types without
+	// padding, which are hashed and compared as bytes. Values are trivially copyable
+	// NOTE: view() checks that the header and the sections fit in the blob but trusts their contents, only
+	// view blobs that build() produced
+	template<typename Key, typename Value>
+	class Frozen_Hash_Map
+	{
+	private:
+		static constexpr bool STRING_KEYS = std::is_same_v<Key, Str_View>;
+
+		static_assert(STRING_KEYS || (std::is_trivially_copyable_v<Key> && std::has_unique_object_representations_v<Key>),
+			"Frozen_Hash_Map keys are Str_View or trivially copyable types without padding");
+		static_assert(std::is_trivially_copyable_v<Value>, "Frozen_Hash_Map values must be trivially copyable");
+		static_assert(alignof(Key) <= 8u && alignof(Value) <= 8u, "The blob sections are only 8-byte aligned");
+
+		using Header = detail::Frozen_Header;
+		using Displacement = detail::Frozen_Displacement;
+		using Stored_Key = std::conditional_t<STRING_KEYS, detail::Frozen_String, Key>;
+
+		const Displacement* displacements{nullptr};
+		const Stored_Key* keys{nullptr};
+		const Value* values{nullptr};
+		const char* strings{nullptr};
+		uint64_t seed{0u};
+		uint64_t _count{0u};
+		uint64_t bucket_count{0u};
+
+	private:
+		static uint64_t hash_key(const Key& key, uint64_t seed)
+		{
+			if constexpr (STRING_KEYS)
+			{
+				return hash_bytes(key.data(), key.count(), seed);
+			}
+			else
+			{
+				return hash_bytes(&key, sizeof(Key), seed);
+			}
+		}
+
+		static bool equal_keys(const Key& a, const Key& b)
+		{
+			if constexpr (STRING_KEYS)
+			{
+				return a == b;
+			}
+			else
+			{
+				return memcmp(&a, &b, sizeof(Key)) == 0;
+			}
+		}
+
+		Key key_at(size_t slot) const
+		{
+			if constexpr (STRING_KEYS)
+			{
+				return Str_View{strings + keys[slot].offset, keys[slot].size};
+			}
+			else
+			{
+				return keys[slot];
+			}
+		}
+
+		enum class Place_Status
+		{
+			PLACED,
+			RETRY, // Two keys can't be told apart with this seed
+			DUPLICATE,
+		};
+
+		// One attempt at a perfect hash of "keys" with "seed", fills "slots" (slot of each key) and "placed"
+		static Place_Status place(const Key* keys, size_t count, uint64_t seed, uint64_t bucket_count, Array<uint32_t>& slots, Array<Displacement>& placed)
+		{
+			Array<uint64_t> hashes{count};
+			Array<uint32_t> bucket_starts{bucket_count + 1u};
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				hashes[i] = hash_key(keys[i], seed);
+				bucket_starts[detail::frozen_bucket(hashes[i], bucket_count) + 1u]++;
+			}
+
+			size_t max_bucket_size = 0u;
+
+			for (size_t b = 0u; b < bucket_count; ++b)
+			{
+				max_bucket_size = bucket_starts[b + 1u] > max_bucket_size ? bucket_starts[b + 1u] : max_bucket_size;
+				bucket_starts[b + 1u] += bucket_starts[b];
+			}
+
+			// Keys grouped by bucket
+			Array<uint32_t> members{count};
+			Array<uint32_t> fill{bucket_count};
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				uint32_t bucket = detail::frozen_bucket(hashes[i], bucket_count);
+				members[bucket_starts[bucket] + fill[bucket]++] = static_cast<uint32_t>(i);
+			}
+
+			// Keys with the same 64-bit hash land on the same slots whatever the displacement
+			for (size_t b = 0u; b < bucket_count; ++b)
+			{
+				for (uint32_t i = bucket_starts[b]; i < bucket_starts[b + 1u]; ++i)
+				{
+					for (uint32_t j = i + 1u; j < bucket_starts[b + 1u]; ++j)
+					{
+						if (hashes[members[i]] == hashes[members[j]])
+						{
+							return equal_keys(keys[members[i]], keys[members[j]]) ? Place_Status::DUPLICATE : Place_Status::RETRY;
+						}
+					}
+				}
+			}
+
+			// Largest buckets first, while most slots are still free
+			Array<uint32_t> size_starts{max_bucket_size + 2u};
+
+			for (size_t b = 0u; b < bucket_count; ++b)
+			{
+				size_starts[max_bucket_size - (bucket_starts[b + 1u] - bucket_starts[b]) + 1u]++;
+			}
+
+			for (size_t s = 0u; s <= max_bucket_size; ++s)
+			{
+				size_starts[s + 1u] += size_starts[s];
+			}
+
+			Array<uint32_t> order{bucket_count};
+
+			for (size_t b = 0u; b < bucket_count; ++b)
+			{
+				order[size_starts[max_bucket_size - (bucket_starts[b + 1u] - bucket_starts[b])]++] = static_cast<uint32_t>(b);
+			}
+
+			// One bit per taken slot, the bits past the last slot are taken
+			size_t word_count = (count + 63u) / 64u;
+			Array<uint64_t> taken{word_count};
+
+			if (count % 64u != 0u)
+			{
+				taken[word_count - 1u] = ~uint64_t{0u} << (count % 64u);
+			}
+
+			auto is_taken = [&](uint32_t slot)
+			{
+				return (taken[slot / 64u] >> (slot % 64u)) & 1u;
+			};
+
+			Array<uint32_t> bases{max_bucket_size};
+
+			for (size_t o = 0u; o < bucket_count; ++o)
+			{
+				uint32_t bucket = order[o];
+				uint32_t first = bucket_starts[bucket];
+				uint32_t size = bucket_starts[bucket + 1u] - first;
+
+				if (size == 0u)
+				{
+					break; // Only empty buckets left, their displacement is never read
+				}
+
+				bool found = false;
+
+				for (uint32_t d0 = 0u; d0 < detail::FROZEN_MAX_D0 && found == false; ++d0)
+				{
+					bool distinct = true;
+
+					for (uint32_t i = 0u; i < size && distinct; ++i)
+					{
+						bases[i] = detail::frozen_base(hashes[members[first + i]], d0, count);
+
+						for (uint32_t j = 0u; j < i; ++j)
+						{
+							distinct = distinct && bases[j] != bases[i];
+						}
+					}
+
+					if (distinct == false)
+					{
+						continue;
+					}
+
+					// d1 lines the first key up with each free slot in turn, only the others need checking. The
+					// scan starts at the first key's own slot, starting every bucket at slot 0 would pack the low
+					// slots and leave the free ones clustered at the end, where whole buckets rarely fit
+					size_t start_word = bases[0] / 64u;
+
+					for (size_t scanned = 0u; scanned < word_count && found == false; ++scanned)
+					{
+						size_t w = start_word + scanned < word_count ? start_word + scanned : start_word + scanned - word_count;
+						uint64_t free_bits = ~taken[w];
+
+						while (free_bits != 0u)
+						{
+							uint32_t free_slot = static_cast<uint32_t>(w * 64u + lowest_bit_index(free_bits));
+							free_bits = clear_lowest_bit(free_bits);
+
+							uint32_t d1 = free_slot >= bases[0] ? free_slot - bases[0] : static_cast<uint32_t>(free_slot + count - bases[0]);
+							bool fits = true;
+
+							for (uint32_t i = 1u; i < size && fits; ++i)
+							{
+								fits = is_taken(detail::frozen_slot(bases[i], d1, count)) == false;
+							}
+
+							if (fits)
+							{
+								for (uint32_t i = 0u; i < size; ++i)
+								{
+									uint32_t slot = detail::frozen_slot(bases[i], d1, count);
+									taken[slot / 64u] |= uint64_t{1u} << (slot % 64u);
+									slots[members[first + i]] = slot;
+								}
+
+								placed[bucket] = Displacement{d0, d1};
+								found = true;
+
+								break;
+							}
+						}
+					}
+				}
+
+				if (found == false)
+				{
+					return Place_Status::RETRY;
+				}
+			}
+
+			return Place_Status::PLACED;
+		}
+
+	public:
+		// Builds the blob of a table that maps keys[i] to values[i], "seed" only changes the hash
+		// Fails on a duplicate key or on more than 2^32 - 1 keys
+		static Result<Array<uint8_t>> build(const Key* keys, const Value* values, size_t count, uint64_t seed = 0u)
+		{
+			if (count >= (uint64_t{1u} << 32u))
+			{
+				return Err{"Frozen_Hash_Map: too many keys"};
+			}
+
+			uint64_t bucket_count = count > 0u ? (count + detail::FROZEN_KEYS_PER_BUCKET - 1u) / detail::FROZEN_KEYS_PER_BUCKET : 0u;
+
+			Array<uint32_t> slots{count};
+			Array<Displacement> placed{bucket_count};
+			bool found = count == 0u;
+
+			for (uint64_t attempt = 0u; attempt < detail::FROZEN_MAX_SEED_ATTEMPTS && found == false; ++attempt)
+			{
+				Place_Status status = place(keys, count, seed, bucket_count, slots, placed);
+
+				if (status == Place_Status::DUPLICATE)
+				{
+					return Err{"Frozen_Hash_Map: duplicate key"};
+				}
+
+				if (status == Place_Status::RETRY)
+				{
+					seed = hash_combine(seed, attempt);
+
+					continue;
+				}
+
+				found = true;
+			}
+
+			if (found == false)
+			{
+				return Err{"Frozen_Hash_Map: no perfect hash found"};
+			}
+
+			uint64_t string_bytes = 0u;
+
+			if constexpr (STRING_KEYS)
+			{
+				for (size_t i = 0u; i < count; ++i)
+				{
+					if (keys[i].count() > UINT32_MAX)
+					{
+						return Err{"Frozen_Hash_Map: key too long"};
+					}
+
+					string_bytes += keys[i].count();
+				}
+			}
+
+			Header header{};
+			header.magic = detail::FROZEN_MAGIC;
+			header.version = detail::FROZEN_VERSION;
+			header.key_size = STRING_KEYS ? 0u : static_cast<uint32_t>(sizeof(Key));
+			header.value_size = static_cast<uint32_t>(sizeof(Value));
+			header.seed = seed;
+			header.count = count;
+			header.bucket_count = bucket_count;
+			header.displacements_offset = detail::frozen_align(sizeof(Header));
+			header.keys_offset = detail::frozen_align(header.displacements_offset + bucket_count * sizeof(Displacement));
+			header.values_offset = detail::frozen_align(header.keys_offset + count * sizeof(Stored_Key));
+			header.strings_offset = detail::frozen_align(header.values_offset + count * sizeof(Value));
+			header.size = detail::frozen_align(header.strings_offset + string_bytes);
+
+			Array<uint8_t> blob{header.size};
+			uint8_t* bytes = blob.buffer();
+
+			memcpy(bytes, &header, sizeof(Header));
+
+			if (bucket_count > 0u)
+			{
+				memcpy(bytes + header.displacements_offset, placed.buffer(), bucket_count * sizeof(Displacement));
+			}
+
+			uint64_t string_offset = 0u;
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				if constexpr (STRING_KEYS)
+				{
+					uint64_t tag = hash_key(keys[i], seed);
+					detail::Frozen_String entry{string_offset, static_cast<uint32_t>(keys[i].count()), static_cast<uint32_t>(tag)};
+
+					memcpy(bytes + header.keys_offset + slots[i] * sizeof(Stored_Key), &entry, sizeof(Stored_Key));
+					memcpy(bytes + header.strings_offset + string_offset, keys[i].data(), keys[i].count());
+					string_offset += keys[i].count();
+				}
+				else
+				{
+					memcpy(bytes + header.keys_offset + slots[i] * sizeof(Stored_Key), &keys[i], sizeof(Stored_Key));
+				}
+
+				memcpy(bytes + header.values_offset + slots[i] * sizeof(Value), &values[i], sizeof(Value));
+			}
+
+			return blob;
+		}
+
+		// A map over "blob" (a build() result, usually memory mapped), which must stay alive and unchanged
+		// while the map is used. Only the header is read, it must match the Key and Value types
+		static Result<Frozen_Hash_Map> view(const void* blob, size_t size)
+		{
+			if (blob == nullptr || size < sizeof(Header))
+			{
+				return Err{"Frozen_Hash_Map: blob too small"};
+			}
+
+			if (reinterpret_cast<uintptr_t>(blob) % 8u != 0u)
+			{
+				return Err{"Frozen_Hash_Map: the blob must be 8-byte aligned"};
+			}
+
+			const uint8_t* bytes = static_cast<const uint8_t*>(blob);
+			Header header;
+			memcpy(&header, bytes, sizeof(Header));
+
+			if (header.magic != detail::FROZEN_MAGIC || header.version != detail::FROZEN_VERSION)
+			{
+				return Err{"Frozen_Hash_Map: not a frozen hash map blob"};
+			}
+
+			if (header.key_size != (STRING_KEYS ? 0u : sizeof(Key)) || header.value_size != sizeof(Value))
+			{
+				return Err{"Frozen_Hash_Map: the blob was built for other key or value types"};
+			}
+
+			bool sections_fit = header.size <= size &&
+				header.count < (uint64_t{1u} << 32u) &&
+				header.bucket_count < (uint64_t{1u} << 32u) &&
+				(header.count == 0u || header.bucket_count > 0u) &&
+				header.displacements_offset % 8u == 0u && header.keys_offset % 8u == 0u && header.values_offset % 8u == 0u &&
+				header.displacements_offset >= sizeof(Header) &&
+				header.displacements_offset <= header.size && header.bucket_count * sizeof(Displacement) <= header.size - header.displacements_offset &&
+				header.keys_offset <= header.size && header.count * sizeof(Stored_Key) <= header.size - header.keys_offset &&
+				header.values_offset <= header.size && header.count * sizeof(Value) <= header.size - header.values_offset &&
+				header.strings_offset <= header.size;
+
+			if (sections_fit == false)
+			{
+				return Err{"Frozen_Hash_Map: corrupted header"};
+			}
+
+			Frozen_Hash_Map map;
+			map.displacements = reinterpret_cast<const Displacement*>(bytes + header.displacements_offset);
+			map.keys = reinterpret_cast<const Stored_Key*>(bytes + header.keys_offset);
+			map.values = reinterpret_cast<const Value*>(bytes + header.values_offset);
+			map.strings = reinterpret_cast<const char*>(bytes + header.strings_offset);
+			map.seed = header.seed;
+			map._count = header.count;
+			map.bucket_count = header.bucket_count;
+
+			return map;
+		}
+
+		// Empty map
+		Frozen_Hash_Map() = default;
+
+	public:
+		const Value* get(const Key& key) const
+		{
+			if (_count == 0u)
+			{
+				return nullptr;
+			}
+
+			uint64_t hash = hash_key(key, seed);
+			Displacement displacement = displacements[detail::frozen_bucket(hash, bucket_count)];
+			uint32_t slot = detail::frozen_slot(detail::frozen_base(hash, displacement.d0, _count), displacement.d1, _count);
+
+			if constexpr (STRING_KEYS)
+			{
+				const detail::Frozen_String& entry = keys[slot];
+
+				if (entry.tag != static_cast<uint32_t>(hash) || entry.size != key.count() || memcmp(strings + entry.offset, key.data(), key.count()) != 0)
+				{
+					return nullptr;
+				}
+			}
+			else if (equal_keys(keys[slot], key) == false)
+			{
+				return nullptr;
+			}
+
+			return &values[slot];
+		}
+
+		bool contains(const Key& key) const
+		{
+			return get(key) != nullptr;
+		}
+
+		size_t count() const
+		{
+			return static_cast<size_t>(_count);
+		}
+
+		// Calls fn(key, value) for every element, in slot order
+		template<typename F>
+		void for_each(F&& fn) const
+		{
+			for (size_t slot = 0u; slot < _count; ++slot)
+			{
+				fn(key_at(slot), values[slot]);
+			}
+		}
+	};
+};
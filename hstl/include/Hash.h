@@ -0,0 +1,341 @@
+#pragma once
+
+#include "Str.h"
+#include "Simd.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <concepts>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+#endif
+
+namespace hstl
+{
+	// Hash_Map and Hash_Set accept lookups by any type when both the Hash and the Eq say they are
+	// transparent (declare "using is_transparent = void;", like std::less<>), e.g. a Str-keyed map
+	// can be queried with a Str_View or a string literal without building a Str
+	template<typename Hash, typename Eq>
+	concept Transparent_Hash = requires
+	{
+		typename Hash::is_transparent;
+		typename Eq::is_transparent;
+	};
+
+	namespace detail
+	{
+		inline constexpr uint64_t HASH_SECRET[3] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull};
+
+		// Full 64x64 -> 128 bit product, "a" gets the low half and "b" the high half
+		HSTL_FORCE_INLINE constexpr void multiply_128(uint64_t& a, uint64_t& b)
+		{
+#if defined(__SIZEOF_INT128__)
+			__uint128_t product = static_cast<__uint128_t>(a) * b;
+			a = static_cast<uint64_t>(product);
+			b = static_cast<uint64_t>(product >> 64u);
+#else
+	#if defined(_MSC_VER) && defined(_M_X64)
+			if (std::is_constant_evaluated() == false)
+			{
+				a = _umul128(a, b, &b);
+
+				return;
+			}
+	#endif
+			uint64_t a_high = a >> 32u, a_low = static_cast<uint32_t>(a);
+			uint64_t b_high = b >> 32u, b_low = static_cast<uint32_t>(b);
+			uint64_t high_high = a_high * b_high, high_low = a_high * b_low;
+			uint64_t low_high = a_low * b_high, low_low = a_low * b_low;
+			uint64_t middle = (low_low >> 32u) + static_cast<uint32_t>(high_low) + static_cast<uint32_t>(low_high);
+			a = (middle << 32u) | static_cast<uint32_t>(low_low);
+			b = high_high + (high_low >> 32u) + (low_high >> 32u) + (middle >> 32u);
+#endif
+		}
+
+		// Folded multiply, every input bit reaches every output bit in one multiplication
+		HSTL_FORCE_INLINE constexpr uint64_t mix(uint64_t a, uint64_t b)
+		{
+			multiply_128(a, b);
+
+			return a ^ b;
+		}
+
+		// "Byte" is uint8_t or char, the constant-evaluated path assembles the little-endian value byte by byte
+		template<typename Byte>
+		HSTL_FORCE_INLINE constexpr uint64_t read_bytes(const Byte* bytes, size_t count)
+		{
+			uint64_t value = 0u;
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				value |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (i * 8u);
+			}
+
+			return value;
+		}
+
+		template<typename Byte>
+		HSTL_FORCE_INLINE constexpr uint64_t read_64(const Byte* bytes)
+		{
+			if (std::is_constant_evaluated())
+			{
+				return read_bytes(bytes, 8u);
+			}
+
+			uint64_t value;
+			memcpy(&value, bytes, sizeof(value));
+
+			return value;
+		}
+
+		template<typename Byte>
+		HSTL_FORCE_INLINE constexpr uint64_t read_32(const Byte* bytes)
+		{
+			if (std::is_constant_evaluated())
+			{
+				return read_bytes(bytes, 4u);
+			}
+
+			uint32_t value;
+			memcpy(&value, bytes, sizeof(value));
+
+			return value;
+		}
+
+		// Byte hasher in the style of wyhash/rapidhash: short inputs are two overlapping reads and one
+		// multiply, long inputs run three independent multiply chains over 48 bytes per step
+		// "Byte" is uint8_t for hash_bytes and char for hash_chars, both hash the same bytes the same way
+		template<typename Byte>
+		constexpr uint64_t hash_byte_range(const Byte* bytes, size_t length, uint64_t seed)
+		{
+			seed ^= mix(seed ^ HASH_SECRET[0], HASH_SECRET[1]) ^ length;
+
+			uint64_t a = 0u;
+			uint64_t b = 0u;
+
+			if (length <= 16u)
+			{
+				if (length >= 4u)
+				{
+					size_t middle = (length >> 3u) << 2u;
+
+					a = (read_32(bytes) << 32u) | read_32(bytes + middle);
+					b = (read_32(bytes + length - 4u) << 32u) | read_32(bytes + length - 4u - middle);
+				}
+				else if (length > 0u)
+				{
+					a = (static_cast<uint64_t>(static_cast<uint8_t>(bytes[0])) << 56u) | (static_cast<uint64_t>(static_cast<uint8_t>(bytes[length >> 1u])) << 32u) | static_cast<uint8_t>(bytes[length - 1u]);
+				}
+			}
+			else
+			{
+				size_t remaining = length;
+
+				if (remaining > 48u)
+				{
+					uint64_t seed_1 = seed;
+					uint64_t seed_2 = seed;
+
+					do
+					{
+						seed = mix(read_64(bytes) ^ HASH_SECRET[0], read_64(bytes + 8u) ^ seed);
+						seed_1 = mix(read_64(bytes + 16u) ^ HASH_SECRET[1], read_64(bytes + 24u) ^ seed_1);
+						seed_2 = mix(read_64(bytes + 32u) ^ HASH_SECRET[2], read_64(bytes + 40u) ^ seed_2);
+
+						bytes += 48u;
+						remaining -= 48u;
+					}
+					while (remaining > 48u);
+
+					seed ^= seed_1 ^ seed_2;
+				}
+
+				while (remaining > 16u)
+				{
+					seed = mix(read_64(bytes) ^ HASH_SECRET[1], read_64(bytes + 8u) ^ seed);
+
+					bytes += 16u;
+					remaining -= 16u;
+				}
+
+				// The last 16 bytes, overlapping what was already consumed when the tail is short
+				a = read_64(bytes + remaining - 16u);
+				b = read_64(bytes + remaining - 8u);
+			}
+
+			a ^= HASH_SECRET[1];
+			b ^= seed;
+
+			multiply_128(a, b);
+
+			return mix(a ^ HASH_SECRET[0] ^ length, b ^ HASH_SECRET[1]);
+		}
+	}
+
+	// Mixes an integer into a 64-bit hash, the low bits (table index) and the high bits (fingerprint)
+	// both depend on all the input bits, so sequential and strided keys spread out
+	HSTL_FORCE_INLINE constexpr uint64_t hash_u64(uint64_t value)
+	{
+		return detail::mix(value ^ detail::HASH_SECRET[0], detail::HASH_SECRET[1]);
+	}
+
+	// See detail::hash_byte_range
+	inline uint64_t hash_bytes(const void* data, size_t length, uint64_t seed = 0u)
+	{
+		return detail::hash_byte_range(static_cast<const uint8_t*>(data), length, seed);
+	}
+
+	// hash_bytes over characters, also usable in constant expressions (compile-time tables)
+	constexpr uint64_t hash_chars(const char* data, size_t length, uint64_t seed = 0u)
+	{
+		return detail::hash_byte_range(data, length, seed);
+	}
+
+	// Folds "value" into "seed", the order matters: combine(combine(s, x), y) != combine(combine(s, y), x)
+	HSTL_FORCE_INLINE constexpr uint64_t hash_combine(uint64_t seed, uint64_t value)
+	{
+		return detail::mix(seed ^ value ^ detail::HASH_SECRET[0], detail::HASH_SECRET[2]);
+	}
+
+	namespace detail
+	{
+		// True when std::hash<T> is specialized for T (the primary template is disabled for class types)
+		template<typename T>
+		concept Has_Std_Hash = requires(const T& value)
+		{
+			{ std::hash<T>{}(value) } -> std::convertible_to<size_t>;
+		};
+	}
+
+	// Class types whose value is exactly their bytes (no padding, no floats, no pointers to follow),
+	// e.g. struct Point { int32_t x, y, z; }. They are hashed and compared as a block of memory
+	// A type that specializes std::hash keeps its std::hash and its operator==, those may ignore some bytes
+	template<typename T>
+	concept Bytewise_Key = std::is_class_v<T> && std::has_unique_object_representations_v<T> && detail::Has_Std_Hash<T> == false;
+
+	// Default hasher of Hash_Map and Hash_Set
+	// Integers, enums and pointers go through hash_u64, floats hash their bits (with -0.0 == 0.0),
+	// strings hash their characters with hash_bytes, Bytewise_Key types hash their whole object with
+	// hash_bytes, anything else takes std::hash and mixes its result since std::hash is often the identity
+	template<typename T>
+	struct Hash
+	{
+		size_t operator()(const T& value) const
+		{
+			if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+			{
+				return hash_u64(static_cast<uint64_t>(value));
+			}
+			else if constexpr (std::is_pointer_v<T>)
+			{
+				return hash_u64(reinterpret_cast<uintptr_t>(value));
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				T normalized = value == T{0} ? T{0} : value;
+
+				if constexpr (sizeof(T) == sizeof(uint64_t))
+				{
+					return hash_u64(std::bit_cast<uint64_t>(normalized));
+				}
+				else if constexpr (sizeof(T) == sizeof(uint32_t))
+				{
+					return hash_u64(std::bit_cast<uint32_t>(normalized));
+				}
+				else
+				{
+					return hash_bytes(&normalized, sizeof(T));
+				}
+			}
+			else if constexpr (Bytewise_Key<T>)
+			{
+				return hash_bytes(&value, sizeof(T));
+			}
+			else
+			{
+				return hash_u64(std::hash<T>{}(value));
+			}
+		}
+	};
+
+	// Hashes several values into one, e.g. for the Hash of a struct: hash_values(point.x, point.y)
+	template<typename... Ts>
+	uint64_t hash_values(const Ts&... values)
+	{
+		uint64_t seed = detail::HASH_SECRET[1];
+
+		((seed = hash_combine(seed, Hash<Ts>{}(values))), ...);
+
+		return seed;
+	}
+
+	// Default key comparison of Hash_Map and Hash_Set: operator== except for the string types and
+	// Bytewise_Key types, which are a single memcmp and don't need an operator== at all
+	// NOTE: a Bytewise_Key type with an operator== that isn't bitwise equality needs its own Eq (or a std::hash)
+	template<typename T>
+	struct Equal_To
+	{
+		bool operator()(const T& a, const T& b) const
+		{
+			if constexpr (Bytewise_Key<T>)
+			{
+				return memcmp(&a, &b, sizeof(T)) == 0;
+			}
+			else
+			{
+				return a == b;
+			}
+		}
+	};
+
+	namespace detail
+	{
+		inline Str_View as_str_view(const Str& str) { return str.view(); }
+		inline Str_View as_str_view(const Str_View& view) { return view; }
+		inline Str_View as_str_view(const char* c_str) { return Str_View{c_str}; }
+		inline Str_View as_str_view(const std::string& str) { return Str_View{str.data(), str.size()}; }
+		inline Str_View as_str_view(const std::string_view& view) { return Str_View{view.data() ? view.data() : "", view.size()}; }
+	}
+
+	// Hashes the characters, so a Str, a Str_View and a const char* with the same content hash the same
+	struct Str_Hash
+	{
+		using is_transparent = void;
+
+		template<typename S>
+		size_t operator()(const S& str) const
+		{
+			Str_View view = detail::as_str_view(str);
+
+			return hash_bytes(view.data(), view.count());
+		}
+	};
+
+	struct Str_Equal
+	{
+		using is_transparent = void;
+
+		template<typename A, typename B>
+		bool operator()(const A& a, const B& b) const
+		{
+			return detail::as_str_view(a) == detail::as_str_view(b);
+		}
+	};
+
+	// String keys are transparent by default, a Hash_Map<Str, T> can be queried with a Str_View or a literal
+	template<> struct Hash<Str> : Str_Hash {};
+	template<> struct Hash<Str_View> : Str_Hash {};
+	template<> struct Hash<std::string> : Str_Hash {};
+	template<> struct Hash<std::string_view> : Str_Hash {};
+
+	template<> struct Equal_To<Str> : Str_Equal {};
+	template<> struct Equal_To<Str_View> : Str_Equal {};
+	template<> struct Equal_To<std::string> : Str_Equal {};
+	template<> struct Equal_To<std::string_view> : Str_Equal {};
+};
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "Array.h"
+#include "Simd.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace hstl
+{
+	namespace detail
+	{
+		// A window of control bytes that is tested in one go, Hash_Map and Hash_Set probe group by group
+		// instead of byte by byte. Control bytes are 0b1xxxxxxx for an occupied slot (7-bit fingerprint)
+		// and 0b0xxxxxxx for an empty one.
+		// Groups are aligned to WIDTH inside the control bytes, so a probe never reads past the end and the
+		// table needs no mirrored tail, the slots before the home slot are masked off in the first group.
+		// Every query returns a bitmask, iterate it with index_of() and clear_lowest_bit()
+#if defined(HSTL_SIMD_SSE2)
+		struct Control_Group
+		{
+			static constexpr size_t WIDTH = 16u;
+
+			using Mask = uint32_t;
+
+			static constexpr Mask ALL = 0xFFFFu;
+
+			__m128i control;
+
+			explicit Control_Group(const uint8_t* control_bytes):
+				control{_mm_loadu_si128(reinterpret_cast<const __m128i*>(control_bytes))}
+			{
+
+			}
+
+			Mask match(uint8_t control_byte) const
+			{
+				return static_cast<Mask>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(static_cast<char>(control_byte)))));
+			}
+
+			Mask match_empty() const
+			{
+				return static_cast<Mask>(_mm_movemask_epi8(control)) ^ ALL;
+			}
+
+			Mask match_occupied() const
+			{
+				return static_cast<Mask>(_mm_movemask_epi8(control));
+			}
+
+			static size_t index_of(Mask mask)
+			{
+				return lowest_bit_index(mask);
+			}
+
+			// Bits of the slots at "offset" and after
+			static Mask bits_from(size_t offset)
+			{
+				return (ALL << offset) & ALL;
+			}
+		};
+#else
+		// Portable fallback, 8 control bytes in a 64-bit word with one flag per byte in its top bit
+		// NOTE: assumes a little-endian target so that the lowest set bit is the first slot
+		struct Control_Group
+		{
+			static constexpr size_t WIDTH = 8u;
+
+			using Mask = uint64_t;
+
+			static constexpr Mask ALL = 0x8080808080808080ull;
+			static constexpr uint64_t LSB = 0x0101010101010101ull;
+
+			uint64_t control;
+
+			explicit Control_Group(const uint8_t* control_bytes)
+			{
+				memcpy(&control, control_bytes, sizeof(control));
+			}
+
+			// Has rare false positives (a byte right above a true match can show up too), callers compare
+			// keys anyway, so they only cost an extra key compare
+			Mask match(uint8_t control_byte) const
+			{
+				uint64_t x = control ^ (LSB * control_byte);
+
+				return (x - LSB) & ~x & ALL;
+			}
+
+			Mask match_empty() const
+			{
+				return ~control & ALL;
+			}
+
+			Mask match_occupied() const
+			{
+				return control & ALL;
+			}
+
+			static size_t index_of(Mask mask)
+			{
+				return lowest_bit_index(mask) >> 3u;
+			}
+
+			static Mask bits_from(size_t offset)
+			{
+				return (ALL << (offset * 8u)) & ALL;
+			}
+		};
+#endif
+
+		// How many keys ahead the batched lookups (get_many & co.) hash and prefetch, enough misses in
+		// flight to cover the DRAM latency without evicting the prefetched lines before they're used
+		inline constexpr size_t PREFETCH_DISTANCE = 16u;
+
+		// Tables smaller than this stay in the L2 cache, the batched lookups don't prefetch for them
+		inline constexpr size_t PREFETCH_MIN_TABLE_BYTES = 1u << 20u;
+
+		// Control bytes of a group with nothing in it, what a stale group reads as
+		inline constexpr uint8_t EMPTY_GROUP[Control_Group::WIDTH] = {};
+
+		// Read-only side of the generation tags of a table that clear() empties in O(1), see Group_Generations
+		struct Generation_View
+		{
+			const uint32_t* tags{nullptr}; // Null for a table without generations
+			uint32_t current{0u};
+
+			bool is_stale(size_t group_index) const
+			{
+				return tags != nullptr && tags[group_index / Control_Group::WIDTH] != current;
+			}
+
+			// The control bytes of the group at "group_index", all empty when the group is stale
+			const uint8_t* group(const uint8_t* control_bytes, size_t group_index) const
+			{
+				return is_stale(group_index) ? EMPTY_GROUP : control_bytes + group_index;
+			}
+
+			uint8_t control_byte(const uint8_t* control_bytes, size_t index) const
+			{
+				return is_stale(index & ~(Control_Group::WIDTH - 1u)) ? uint8_t{0u} : control_bytes[index];
+			}
+		};
+
+		// One tag per group and a table-wide generation (GENERATIONAL_CLEAR): a group whose tag isn't the
+		// current generation is empty whatever its control bytes say. Clearing is then bumping the generation,
+		// and the first insert into a stale group wipes its control bytes and tags it again
+		struct Group_Generations
+		{
+			Array<uint32_t> tags;
+			uint32_t current{0u};
+
+			// For a new table of "capacity" slots, whose control bytes are all empty
+			void reset(size_t capacity)
+			{
+				tags = Array<uint32_t>{capacity / Control_Group::WIDTH};
+				current = 0u;
+			}
+
+			// Empties every group at once
+			void advance()
+			{
+				if (current == UINT32_MAX)
+				{
+					// Once every 4 billion clears, a tag could otherwise come back to life
+					memset(tags.buffer(), 0, tags.size() * sizeof(uint32_t));
+					current = 0u;
+				}
+
+				current++;
+			}
+
+			// Called before the slot at "index" gets occupied
+			void claim(uint8_t* control_bytes, size_t index)
+			{
+				size_t group_index = index & ~(Control_Group::WIDTH - 1u);
+				uint32_t& tag = tags[group_index / Control_Group::WIDTH];
+
+				if (tag != current)
+				{
+					memset(control_bytes + group_index, 0, Control_Group::WIDTH);
+					tag = current;
+				}
+			}
+
+			Generation_View view() const
+			{
+				return Generation_View{tags.buffer(), current};
+			}
+		};
+
+		struct No_Group_Generations
+		{
+			void reset(size_t)
+			{
+			}
+
+			void claim(uint8_t*, size_t)
+			{
+			}
+
+			Generation_View view() const
+			{
+				return Generation_View{};
+			}
+		};
+
+		// First occupied slot in [index, end), or "end". "end" is a multiple of WIDTH (a whole table), so
+		// every group that gets loaded is inside it. Empty runs are skipped a group per iteration
+		inline size_t next_occupied(const uint8_t* control_bytes, size_t index, size_t end, Generation_View generations = {})
+		{
+			while (index < end)
+			{
+				size_t group_index = index & ~(Control_Group::WIDTH - 1u);
+				auto occupied = Control_Group{generations.group(control_bytes, group_index)}.match_occupied() & Control_Group::bits_from(index - group_index);
+
+				if (occupied != 0u)
+				{
+					return group_index + Control_Group::index_of(occupied);
+				}
+
+				index = group_index + Control_Group::WIDTH;
+			}
+
+			return end;
+		}
+
+		// Calls visit(index) for every occupied slot of a whole table, a group at a time
+		template<typename F>
+		void for_each_occupied(const uint8_t* control_bytes, size_t count, F&& visit, Generation_View generations = {})
+		{
+			for (size_t group_index = 0u; group_index < count; group_index += Control_Group::WIDTH)
+			{
+				auto occupied = Control_Group{generations.group(control_bytes, group_index)}.match_occupied();
+
+				while (occupied != 0u)
+				{
+					visit(group_index + Control_Group::index_of(occupied));
+					occupied = clear_lowest_bit(occupied);
+				}
+			}
+		}
+
+		// Stands in for the stored hashes when a table doesn't keep them
+		struct No_Hash_Store
+		{
+		};
+
+		// Bits below the lowest set bit of "mask", everything when "mask" is zero
+		// Used to drop the matches that sit after the first empty slot, they belong to another probe sequence
+		template<typename Mask>
+		HSTL_FORCE_INLINE Mask bits_before_first(Mask mask)
+		{
+			return mask != 0u ? (mask & (~mask + 1u)) - 1u : ~Mask{0u};
+		}
+	}
+};
@@ -1,413 +1,1626 @@
+#pragma once
+
 #include "Array.h"
+#include "Hash_Group.h"
+#include "Hash.h"
+#include "Hash_Stats.h"
 
 #include <functional>
 #include <utility>
 #include <type_traits>
 #include <new>
+#include <cstring>
 
 namespace hstl
 {
-	template<typename Key, typename Value, typename Hash = std::hash<Key>, typename Eq = std::equal_to<Key>>
+	namespace detail
+	{
+		// Where a Hash_Map keeps its elements, indexed like its control bytes. A layout is a non-owning
+		// handle that doesn't know which slots are occupied, the map constructs and destroys through it
+
+		// Key and value side by side, a hit usually reads a single cache line
+		template<typename Key, typename Value>
+		struct Packed_Slots
+		{
+			struct Slot
+			{
+				Key key;
+				Value value;
+			};
+
+			static constexpr size_t SLOT_BYTES = sizeof(Slot);
+			static constexpr bool TRIVIALLY_COPYABLE = std::is_trivially_copyable_v<Slot>;
+			static constexpr bool TRIVIALLY_DESTRUCTIBLE = std::is_trivially_destructible_v<Slot>;
+
+			Slot* slots{nullptr};
+
+			static Packed_Slots allocate(size_t capacity)
+			{
+				return Packed_Slots{static_cast<Slot*>(::operator new(capacity * sizeof(Slot)))};
+			}
+
+			void deallocate() const
+			{
+				::operator delete(slots);
+			}
+
+			Key& key(size_t index) const { return slots[index].key; }
+			Value& value(size_t index) const { return slots[index].value; }
+
+			// The value is built from "args", in place
+			template<typename K, typename... Args>
+			void construct(size_t index, K&& key, Args&&... args) const
+			{
+				new (&slots[index]) Slot{Key(std::forward<K>(key)), Value(std::forward<Args>(args)...)};
+			}
+
+			void copy_construct(size_t index, const Packed_Slots& source, size_t source_index) const
+			{
+				new (&slots[index]) Slot(source.slots[source_index]);
+			}
+
+			// Only when TRIVIALLY_COPYABLE, both tables have "capacity" slots
+			void copy_all(const Packed_Slots& source, size_t capacity) const
+			{
+				memcpy(slots, source.slots, sizeof(Slot) * capacity);
+			}
+
+			// Move-constructs the element at "index" from "source[source_index]" and destroys that one
+			void relocate(size_t index, const Packed_Slots& source, size_t source_index) const
+			{
+				Slot& from = source.slots[source_index];
+
+				new (&slots[index]) Slot{std::move(from.key), std::move(from.value)};
+				std::destroy_at(&from);
+			}
+
+			// Both elements are alive, "from" is left moved-from
+			void move_assign(size_t to, size_t from) const
+			{
+				slots[to] = std::move(slots[from]);
+			}
+
+			void destroy(size_t index) const
+			{
+				std::destroy_at(&slots[index]);
+			}
+
+			void prefetch_key(size_t index) const
+			{
+				prefetch(&slots[index]);
+			}
+		};
+
+		// Keys and values in two parallel arrays of one allocation: probing compares keys that are packed
+		// together instead of keys spread between large values, the value is only read on a hit
+		template<typename Key, typename Value>
+		struct Split_Slots
+		{
+			static constexpr size_t SLOT_BYTES = sizeof(Key) + sizeof(Value);
+			static constexpr bool TRIVIALLY_COPYABLE = std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>;
+			static constexpr bool TRIVIALLY_DESTRUCTIBLE = std::is_trivially_destructible_v<Key> && std::is_trivially_destructible_v<Value>;
+
+			Key* keys{nullptr};
+			Value* values{nullptr}; // Right after the keys
+
+			static size_t values_offset(size_t capacity)
+			{
+				constexpr size_t ALIGNMENT = alignof(Value);
+
+				return (capacity * sizeof(Key) + ALIGNMENT - 1u) / ALIGNMENT * ALIGNMENT;
+			}
+
+			static size_t allocation_bytes(size_t capacity)
+			{
+				return values_offset(capacity) + capacity * sizeof(Value);
+			}
+
+			static Split_Slots allocate(size_t capacity)
+			{
+				uint8_t* bytes = static_cast<uint8_t*>(::operator new(allocation_bytes(capacity)));
+
+				return Split_Slots{reinterpret_cast<Key*>(bytes), reinterpret_cast<Value*>(bytes + values_offset(capacity))};
+			}
+
+			void deallocate() const
+			{
+				::operator delete(keys);
+			}
+
+			Key& key(size_t index) const { return keys[index]; }
+			Value& value(size_t index) const { return values[index]; }
+
+			template<typename K, typename... Args>
+			void construct(size_t index, K&& key, Args&&... args) const
+			{
+				new (&keys[index]) Key(std::forward<K>(key));
+				new (&values[index]) Value(std::forward<Args>(args)...);
+			}
+
+			void copy_construct(size_t index, const Split_Slots& source, size_t source_index) const
+			{
+				new (&keys[index]) Key(source.keys[source_index]);
+				new (&values[index]) Value(source.values[source_index]);
+			}
+
+			void copy_all(const Split_Slots& source, size_t capacity) const
+			{
+				memcpy(keys, source.keys, allocation_bytes(capacity));
+			}
+
+			void relocate(size_t index, const Split_Slots& source, size_t source_index) const
+			{
+				new (&keys[index]) Key(std::move(source.keys[source_index]));
+				new (&values[index]) Value(std::move(source.values[source_index]));
+				source.destroy(source_index);
+			}
+
+			void move_assign(size_t to, size_t from) const
+			{
+				keys[to] = std::move(keys[from]);
+				values[to] = std::move(values[from]);
+			}
+
+			void destroy(size_t index) const
+			{
+				std::destroy_at(&keys[index]);
+				std::destroy_at(&values[index]);
+			}
+
+			void prefetch_key(size_t index) const
+			{
+				prefetch(&keys[index]);
+			}
+		};
+	}
+
+	// Compile-time knobs of Hash_Map, derive from it and override the constants to change them:
+	// struct My_Options : hstl::Hash_Map_Options<Str, int> { static constexpr bool STORE_HASH = false; };
+	template<typename Key, typename Value>
+	struct Hash_Map_Options
+	{
+		// Keeps the full hash of every slot in a side array, growing and removing never call the hasher again
+		// and lookups compare the hashes before the keys. Costs 8 bytes per slot, so it's only on by default
+		// for keys that are expensive to hash and compare (anything that isn't trivially copyable, e.g. Str)
+		static constexpr bool STORE_HASH = std::is_trivially_copyable_v<Key> == false;
+
+		// Grows without a stall: the old table is kept next to the new one and every insert/remove (or an
+		// explicit step()) moves a bounded number of its slots over, lookups check both until it's drained.
+		// Worst-case insert latency stops depending on the map size, at the price of a slower lookup miss and
+		// both tables being alive during the migration
+		static constexpr bool INCREMENTAL_REHASH = false;
+
+		// Counts probes, loaded groups and key compares as they happen, see stats(). Costs a few relaxed atomic
+		// increments per lookup, so several threads may still read a const map at once. Meant for profiling
+		// and telemetry builds (HSTL_HASH_PROBE_COUNTERS=1 turns it on everywhere)
+		static constexpr bool PROBE_COUNTERS = HSTL_HASH_PROBE_COUNTERS != 0;
+
+		// Keeps the keys and the values in two parallel arrays instead of side by side, so a probe only
+		// loads control bytes and keys. Pays off for large values (64 bytes and up) that are mostly probed
+		// with contains() or looked up rarely, the keys stay in the cache instead of one line per key. A hit
+		// that reads its value loads one more cache line, so it's off by default. The iterator then yields
+		// entries instead of slots
+		static constexpr bool SPLIT_SLOTS = false;
+
+		// Makes clear() O(1) for maps that are refilled over and over (per-frame scratch maps): every control
+		// group gets a generation tag, clear() bumps the generation and a group with an older tag reads as
+		// empty until the next insert into it wipes it. Costs 4 bytes per group and a tag compare per probed
+		// group. Only pays off when the table is much larger than what gets inserted between two clears, a
+		// plain clear() is a memset of 1 byte per slot. Only for trivially destructible keys and values, and
+		// not with INCREMENTAL_REHASH
+		static constexpr bool GENERATIONAL_CLEAR = false;
+	};
+
+	template<typename Key, typename Value, typename Hash = hstl::Hash<Key>, typename Eq = Equal_To<Key>, typename Options = Hash_Map_Options<Key, Value>>
 	class Hash_Map
 	{
 	private:
-		static constexpr size_t GROWTH_SIZE = 1024;
+		static constexpr bool STORE_HASH = Options::STORE_HASH;
+		static constexpr bool INCREMENTAL_REHASH = Options::INCREMENTAL_REHASH;
+		static constexpr bool PROBE_COUNTERS = Options::PROBE_COUNTERS;
+		static constexpr bool SPLIT_SLOTS = Options::SPLIT_SLOTS;
+		static constexpr bool GENERATIONAL_CLEAR = Options::GENERATIONAL_CLEAR;
+		static constexpr size_t MIN_CAPACITY = 16u;
 		static constexpr size_t GROWTH_FACTOR = 2u;
-		static constexpr float LOAD_FACTOR = 0.7f;
+		static constexpr float LOAD_FACTOR = 0.875f;
 		static constexpr uint8_t BIT_OCCUPIED = 0b10000000;
 
-		struct Slot
+		using Group = detail::Control_Group;
+
+		static_assert(MIN_CAPACITY % Group::WIDTH == 0u, "The table must be made of whole groups");
+		static_assert(GENERATIONAL_CLEAR == false || (std::is_trivially_destructible_v<Key> && std::is_trivially_destructible_v<Value>),
+			"GENERATIONAL_CLEAR skips the destructors, Key and Value must be trivially destructible");
+		static_assert(GENERATIONAL_CLEAR == false || INCREMENTAL_REHASH == false, "GENERATIONAL_CLEAR and INCREMENTAL_REHASH don't combine");
+
+	public:
+		// Old slots migrated by every insert/remove in INCREMENTAL_REHASH mode, the old table is drained
+		// long before the new one fills up as long as this is more than 1 / LOAD_FACTOR
+		static constexpr size_t REHASH_STEP = 4u * Group::WIDTH;
+
+	private:
+		using Slot_Table = std::conditional_t<SPLIT_SLOTS, detail::Split_Slots<Key, Value>, detail::Packed_Slots<Key, Value>>;
+
+		static bool is_empty(uint8_t control_byte)
+		{
+			return (control_byte & BIT_OCCUPIED) == 0;
+		}
+
+		static bool is_match(uint8_t control_byte, uint8_t fingerprint)
+		{
+			return control_byte == (fingerprint | BIT_OCCUPIED);
+		}
+
+		static uint8_t make_control_byte(size_t hash)
+		{
+			static_assert(sizeof(size_t) == 8, "The logic is built upon the assumption that size_t is 8 bytes");
+			uint8_t fingerprint = static_cast<uint8_t>(hash >> 57);
+			return fingerprint | BIT_OCCUPIED;
+		}
+
+		using Hash_Store = std::conditional_t<STORE_HASH, Array<size_t>, detail::No_Hash_Store>;
+
+		// The table being drained by an incremental rehash. Its control bytes are never touched so that the
+		// probe sequences stay intact: slots before "cursor" were moved out and removed slots are flagged
+		// in "dead", both are skipped by lookups
+		struct Old_Table
+		{
+			Array<uint8_t> states;
+			Slot_Table slots;
+			[[no_unique_address]] Hash_Store hashes;
+			Array<uint64_t> dead;
+			size_t cursor{0u};
+			size_t live{0u};
+		};
+
+		struct No_Old_Table
+		{
+		};
+
+		using Old_Store = std::conditional_t<INCREMENTAL_REHASH, Old_Table, No_Old_Table>;
+		using Counter_Store = std::conditional_t<PROBE_COUNTERS, detail::Live_Probe_Counters, detail::No_Probe_Counters>;
+		using Generation_Store = std::conditional_t<GENERATIONAL_CLEAR, detail::Group_Generations, detail::No_Group_Generations>;
+
+		Eq equalizer;
+		Hash hasher;
+		size_t filled_buckets{0u}; // Elements in both tables
+		Array<uint8_t> states;
+		Slot_Table slots;
+		[[no_unique_address]] Hash_Store hashes; // Parallel to "states" with STORE_HASH, empty otherwise
+		[[no_unique_address]] Old_Store old; // Only with INCREMENTAL_REHASH
+		[[no_unique_address]] mutable Counter_Store counters; // Only with PROBE_COUNTERS
+		[[no_unique_address]] Generation_Store generations; // Only with GENERATIONAL_CLEAR
+		size_t rehashes{0u};
+
+	private:
+		struct Probe_Result
 		{
-			Key key;
-			Value value;
+			size_t index; // Slot of the key when found, otherwise the empty slot where it would go
+			bool found;
 		};
 
-		static bool is_empty(uint8_t control_byte)
+		// Linear probing a group at a time: every group is one compare for the fingerprint and one for the
+		// empty slots, the key can only sit before the first empty slot after its home
+		// "is_gone" drops the occupied slots that don't hold an element anymore (only in the old table)
+		template<typename K, typename Is_Gone>
+		Probe_Result probe_table(const Array<uint8_t>& control_bytes, const Slot_Table& table_slots, const Hash_Store& table_hashes,
+			const K& key, size_t hash, Is_Gone is_gone) const
+		{
+			size_t mask = control_bytes.size() - 1u;
+			size_t home = hash & mask;
+			size_t group_index = home & ~(Group::WIDTH - 1u);
+			uint8_t control_byte = make_control_byte(hash);
+			auto window = Group::bits_from(home - group_index);
+
+			if constexpr (PROBE_COUNTERS)
+			{
+				counters.count_probe();
+			}
+
+			while (true)
+			{
+				Group group{generations.view().group(control_bytes.buffer(), group_index)}; // Only "states" has generations
+
+				auto empties = group.match_empty() & window;
+				auto matches = group.match(control_byte) & window & detail::bits_before_first(empties);
+
+				if constexpr (PROBE_COUNTERS)
+				{
+					counters.count_group();
+				}
+
+				while (matches != 0u)
+				{
+					size_t index = group_index + Group::index_of(matches);
+
+					if (is_gone(index) == false && hash_matches(table_hashes, index, hash))
+					{
+						if constexpr (PROBE_COUNTERS)
+						{
+							counters.count_compare();
+						}
+
+						if (equalizer(key, table_slots.key(index)))
+						{
+							return Probe_Result{index, true};
+						}
+					}
+
+					matches = clear_lowest_bit(matches);
+				}
+
+				if (empties != 0u)
+				{
+					return Probe_Result{group_index + Group::index_of(empties), false};
+				}
+
+				group_index = (group_index + Group::WIDTH) & mask;
+				window = Group::ALL;
+			}
+		}
+
+		template<typename K>
+		Probe_Result probe(const K& key, size_t hash) const
+		{
+			return probe_table(states, slots, hashes, key, hash, [](size_t) { return false; });
+		}
+
+		static bool hash_matches(const Hash_Store& table_hashes, size_t index, size_t hash)
+		{
+			if constexpr (STORE_HASH)
+			{
+				return table_hashes[index] == hash;
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		// Control byte of the slot at "index" of the current table, empty in a group left stale by clear()
+		uint8_t control_byte(size_t index) const
+		{
+			if constexpr (GENERATIONAL_CLEAR)
+			{
+				return generations.view().control_byte(states.buffer(), index);
+			}
+			else
+			{
+				return states[index];
+			}
+		}
+
+		size_t slot_hash(size_t index) const
+		{
+			if constexpr (STORE_HASH)
+			{
+				return hashes[index];
+			}
+			else
+			{
+				return hasher(slots.key(index));
+			}
+		}
+
+		static size_t find_empty(const Array<uint8_t>& control_bytes, size_t hash)
+		{
+			size_t mask = control_bytes.size() - 1u;
+			size_t home = hash & mask;
+			size_t group_index = home & ~(Group::WIDTH - 1u);
+			auto window = Group::bits_from(home - group_index);
+
+			while (true)
+			{
+				auto empties = Group{&control_bytes[group_index]}.match_empty() & window;
+
+				if (empties != 0u)
+				{
+					return group_index + Group::index_of(empties);
+				}
+
+				group_index = (group_index + Group::WIDTH) & mask;
+				window = Group::ALL;
+			}
+		}
+
+		// Runs the destructors of the elements of both tables, leaves the slots allocated
+		void destroy_elements()
+		{
+			if constexpr (Slot_Table::TRIVIALLY_DESTRUCTIBLE == false)
+			{
+				if (filled_buckets > 0u)
+				{
+					size_t count = states.size();
+
+					for (size_t i = 0; i < count; ++i)
+					{
+						if (is_empty(states[i]))
+							continue;
+
+						slots.destroy(i);
+					}
+
+					if constexpr (INCREMENTAL_REHASH)
+					{
+						for (size_t i = old.cursor; i < old.states.size(); ++i)
+						{
+							if (is_empty(old.states[i]) || is_dead(i))
+								continue;
+
+							old.slots.destroy(i);
+						}
+					}
+				}
+			}
+		}
+
+		void destroy_slots()
+		{
+			destroy_elements();
+
+			slots.deallocate();
+
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				old.slots.deallocate();
+			}
+		}
+
+		// Leaves an empty map without a table
+		void release_tables()
+		{
+			destroy_slots();
+
+			filled_buckets = 0u;
+			states = Array<uint8_t>{};
+			slots = Slot_Table{};
+			hashes = Hash_Store{};
+			old = Old_Store{};
+			generations = Generation_Store{};
+		}
+
+		// Copies the elements of "other" into this map, which has no table
+		void copy_tables(const Hash_Map& other)
+		{
+			if (other.is_rehashing())
+			{
+				// Both tables of a migration aren't worth reproducing, the copy gets a single table
+				reserve(other.filled_buckets);
+
+				other.for_each([this](const Key& key, const Value& value)
+				{
+					insert(key, value);
+				});
+
+				return;
+			}
+
+			size_t count = other.states.size();
+
+			filled_buckets = other.filled_buckets;
+			states = other.states;
+			hashes = other.hashes;
+			generations = other.generations;
+			slots = count > 0u ? Slot_Table::allocate(count) : Slot_Table{};
+
+			if constexpr (Slot_Table::TRIVIALLY_COPYABLE)
+			{
+				if (count > 0u)
+				{
+					slots.copy_all(other.slots, count);
+				}
+			}
+			else
+			{
+				for (size_t i = 0u; i < count; ++i)
+				{
+					if (!is_empty(other.control_byte(i)))
+					{
+						slots.copy_construct(i, other.slots, i);
+					}
+				}
+			}
+		}
+
+		template<typename K>
+		const Value* find_value(const K& key) const
+		{
+			if (filled_buckets == 0)
+			{
+				return nullptr;
+			}
+
+			return find_value(key, hasher(key));
+		}
+
+		// "hash" must be hasher(key) and the map must not be empty
+		template<typename K>
+		const Value* find_value(const K& key, size_t hash) const
+		{
+			auto [index, found] = probe(key, hash);
+
+			if (found)
+			{
+				return &slots.value(index);
+			}
+
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				if (is_rehashing())
+				{
+					auto [old_index, old_found] = probe_old(key, hash);
+
+					return old_found ? &old.slots.value(old_index) : nullptr;
+				}
+			}
+
+			return nullptr;
+		}
+
+		template<typename K>
+		bool remove_key(const K& key, size_t hash)
+		{
+			if (filled_buckets == 0)
+			{
+				return false;
+			}
+
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				if (is_rehashing())
+				{
+					migrate(REHASH_STEP);
+				}
+
+				if (is_rehashing())
+				{
+					auto [old_index, old_found] = probe_old(key, hash);
+
+					// No backward shift in the old table, the slot keeps its control byte and is flagged instead
+					if (old_found)
+					{
+						old.slots.destroy(old_index);
+						old.dead[old_index / 64u] |= uint64_t{1u} << (old_index % 64u);
+						old.live--;
+						filled_buckets--;
+
+						return true;
+					}
+				}
+			}
+
+			auto _size = states.size();
+			auto mask = _size - 1u;
+
+			auto [hole_index, found] = probe(key, hash);
+
+			if (found == false)
+			{
+				return false;
+			}
+
+			auto current_index = (hole_index + 1u) & mask;
+			auto dist = [mask, _size](size_t a, size_t b) { return (b + _size - a) & mask; };
+
+			while(!is_empty(control_byte(current_index)))
+			{
+				auto home_hash = slot_hash(current_index);
+				auto home_index = home_hash & mask;
+
+				auto dist_home_to_hole = dist(home_index, hole_index);
+				auto dist_home_to_current = dist(home_index, current_index);
+
+				if (dist_home_to_hole <= dist_home_to_current)
+				{
+					slots.move_assign(hole_index, current_index);
+					states[hole_index] = states[current_index];
+
+					if constexpr (STORE_HASH)
+					{
+						hashes[hole_index] = hashes[current_index];
+					}
+
+					hole_index = current_index;
+				}
+
+				current_index = (current_index + 1u) & mask;
+			}
+
+			states[hole_index] = 0;
+			slots.destroy(hole_index);
+			filled_buckets--;
+
+			return true;
+		}
+
+		// Smallest table that holds "count" elements without growing, nothing at all for zero elements
+		static size_t capacity_for(size_t count)
+		{
+			if (count == 0u)
+			{
+				return 0u;
+			}
+
+			size_t capacity = MIN_CAPACITY;
+
+			while (static_cast<size_t>(LOAD_FACTOR * capacity) < count)
+			{
+				capacity *= GROWTH_FACTOR;
+			}
+
+			return capacity;
+		}
+
+		void grow_then_rehash()
+		{
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				if (states.size() > 0u)
+				{
+					finish_rehash(); // never needed while REHASH_STEP drains the old table in time, kept as a safety net
+					begin_rehash(states.size() * GROWTH_FACTOR);
+
+					return;
+				}
+			}
+
+			rehash(states.size() > 0u ? states.size() * GROWTH_FACTOR : MIN_CAPACITY);
+		}
+
+		// Moves every element into a table of "new_size" slots, zero frees the table
+		// A running incremental rehash is finished first, so reserve() and shrink_to_fit() see a single table
+		void rehash(size_t new_size)
+		{
+			finish_rehash();
+
+			rehashes++;
+
+			auto new_states_list = Array<uint8_t>{};
+			auto new_hashes_list = Hash_Store{};
+			Slot_Table new_slots_list;
+
+			if (new_size > 0u)
+			{
+				new_states_list = Array<uint8_t>{new_size};
+				new_slots_list = Slot_Table::allocate(new_size);
+
+				if constexpr (STORE_HASH)
+				{
+					new_hashes_list = Array<size_t>{new_size};
+				}
+			}
+
+			for (size_t i = 0u; i < states.size(); ++i)
+			{
+				uint8_t old_control_byte = control_byte(i);
+
+				if (!is_empty(old_control_byte))
+				{
+					auto hash = slot_hash(i);
+					auto new_index = find_empty(new_states_list, hash);
+
+					new_states_list[new_index] = old_control_byte;
+
+					if constexpr (STORE_HASH)
+					{
+						new_hashes_list[new_index] = hash;
+					}
+					new_slots_list.relocate(new_index, slots, i);
+				}
+			}
+			slots.deallocate();
+
+			states = std::move(new_states_list);
+			hashes = std::move(new_hashes_list);
+			slots = new_slots_list;
+			generations.reset(new_size);
+		}
+
+		// Starts loading the first group and the home slot of "hash", the table must not be empty
+		void prefetch_home(size_t hash) const
+		{
+			size_t home = hash & (states.size() - 1u);
+
+			prefetch(&states[home & ~(Group::WIDTH - 1u)]);
+			slots.prefetch_key(home);
+		}
+
+		// Resolves the keys in order while the keys PREFETCH_DISTANCE places ahead are hashed and their homes
+		// prefetched, so the cache misses of consecutive lookups overlap instead of each one waiting for the
+		// previous one. A table that fits in the cache doesn't miss, there the prefetching is skipped
+		template<typename K, typename F>
+		void for_each_batched(const K* keys, size_t count, F&& resolve) const
+		{
+			constexpr size_t DISTANCE = detail::PREFETCH_DISTANCE;
+
+			if (states.size() * (Slot_Table::SLOT_BYTES + 1u) < detail::PREFETCH_MIN_TABLE_BYTES)
+			{
+				for (size_t i = 0u; i < count; ++i)
+				{
+					resolve(i, hasher(keys[i]));
+				}
+
+				return;
+			}
+
+			size_t ahead_hashes[DISTANCE];
+			size_t ahead = count < DISTANCE ? count : DISTANCE;
+
+			for (size_t i = 0u; i < ahead; ++i)
+			{
+				ahead_hashes[i] = hasher(keys[i]);
+				prefetch_home(ahead_hashes[i]);
+			}
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				size_t hash = ahead_hashes[i % DISTANCE];
+
+				if (i + DISTANCE < count)
+				{
+					size_t next_hash = hasher(keys[i + DISTANCE]);
+
+					ahead_hashes[i % DISTANCE] = next_hash;
+					prefetch_home(next_hash);
+				}
+
+				resolve(i, hash);
+			}
+		}
+
+		struct Insert_Slot
+		{
+			Slot_Table table; // Holds the existing element at "index" when found, otherwise the uninitialized slot
+			size_t index;
+			bool found;
+		};
+
+		// Shared by all the inserting functions: grows if needed and finds either the slot of "key" or the
+		// empty slot it goes into. A new element must be constructed in place and then occupy() its slot
+		template<typename K>
+		Insert_Slot find_insert_slot(const K& key, size_t hash)
+		{
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				if (is_rehashing())
+				{
+					migrate(REHASH_STEP);
+				}
+			}
+
+			if (filled_buckets - old_count() >= static_cast<size_t>(LOAD_FACTOR * states.size()))
+			{
+				grow_then_rehash();
+			}
+
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				if (is_rehashing())
+				{
+					auto [old_index, old_found] = probe_old(key, hash);
+
+					if (old_found)
+					{
+						return Insert_Slot{old.slots, old_index, true};
+					}
+				}
+			}
+
+			auto [index, found] = probe(key, hash);
+
+			return Insert_Slot{slots, index, found};
+		}
+
+		void occupy(size_t index, size_t hash)
+		{
+			generations.claim(states.buffer(), index);
+			states[index] = make_control_byte(hash);
+
+			if constexpr (STORE_HASH)
+			{
+				hashes[index] = hash;
+			}
+
+			filled_buckets++;
+		}
+
+	private: // Incremental rehash, only instantiated with INCREMENTAL_REHASH
+		bool is_dead(size_t index) const
+		{
+			return (old.dead[index / 64u] >> (index % 64u)) & 1u;
+		}
+
+		template<typename K>
+		Probe_Result probe_old(const K& key, size_t hash) const
+		{
+			return probe_table(old.states, old.slots, old.hashes, key, hash, [this](size_t index)
+			{
+				return index < old.cursor || is_dead(index);
+			});
+		}
+
+		// Turns the current table into the old one and starts filling an empty table of "new_size" slots
+		void begin_rehash(size_t new_size)
+		{
+			rehashes++;
+
+			old.states = std::move(states);
+			old.slots = slots;
+			old.hashes = std::move(hashes);
+			old.dead = Array<uint64_t>{(old.states.size() + 63u) / 64u};
+			old.cursor = 0u;
+			old.live = filled_buckets;
+
+			states = Array<uint8_t>{new_size};
+			slots = Slot_Table::allocate(new_size);
+
+			if constexpr (STORE_HASH)
+			{
+				hashes = Array<size_t>{new_size};
+			}
+		}
+
+		// Moves the next "slot_budget" slots of the old table into the new one, frees the old table once
+		// the cursor reaches its end
+		void migrate(size_t slot_budget)
+		{
+			size_t old_size = old.states.size();
+			size_t end = old_size - old.cursor > slot_budget ? old.cursor + slot_budget : old_size;
+
+			for (size_t i = old.cursor; i < end; ++i)
+			{
+				if (is_empty(old.states[i]) || is_dead(i))
+					continue;
+
+				size_t hash;
+
+				if constexpr (STORE_HASH)
+				{
+					hash = old.hashes[i];
+				}
+				else
+				{
+					hash = hasher(old.slots.key(i));
+				}
+
+				auto new_index = find_empty(states, hash);
+
+				states[new_index] = old.states[i];
+
+				if constexpr (STORE_HASH)
+				{
+					hashes[new_index] = hash;
+				}
+				slots.relocate(new_index, old.slots, i);
+				old.live--;
+			}
+
+			old.cursor = end;
+
+			if (end == old_size)
+			{
+				old.slots.deallocate();
+				old = Old_Table{};
+			}
+		}
+
+		void finish_rehash()
+		{
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				if (is_rehashing())
+				{
+					migrate(old.states.size());
+				}
+			}
+		}
+
+		// Elements still waiting in the old table
+		size_t old_count() const
+		{
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				return old.live;
+			}
+			else
+			{
+				return 0u;
+			}
+		}
+
+	public:
+		// Allocates nothing, the table is created by the first insert
+		Hash_Map() = default;
+
+		// Sizes the table for "capacity_hint" elements up front
+		explicit Hash_Map(size_t capacity_hint)
+		{
+			reserve(capacity_hint);
+		}
+
+		Hash_Map(const Hash_Map& other):
+			equalizer{other.equalizer},
+			hasher{other.hasher}
+		{
+			copy_tables(other);
+		}
+
+		Hash_Map& operator=(const Hash_Map& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			release_tables();
+
+			equalizer = other.equalizer;
+			hasher = other.hasher;
+
+			copy_tables(other);
+
+			return *this;
+		}
+
+		Hash_Map(Hash_Map&& other):
+			equalizer{std::move(other.equalizer)},
+			hasher{std::move(other.hasher)},
+			filled_buckets{other.filled_buckets},
+			states{std::move(other.states)},
+			slots{other.slots},
+			hashes{std::move(other.hashes)},
+			old{std::move(other.old)},
+			counters{other.counters},
+			generations{std::move(other.generations)},
+			rehashes{other.rehashes}
+		{
+			other.slots = Slot_Table{};
+			other.filled_buckets = 0u;
+			other.old = Old_Store{};
+		}
+
+		Hash_Map& operator=(Hash_Map&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			destroy_slots();
+
+			equalizer = std::move(other.equalizer);
+			hasher = std::move(other.hasher);
+			filled_buckets = other.filled_buckets;
+			states = std::move(other.states);
+			slots = other.slots;
+			hashes = std::move(other.hashes);
+			old = std::move(other.old);
+			counters = other.counters;
+			generations = std::move(other.generations);
+			rehashes = other.rehashes;
+
+			other.slots = Slot_Table{};
+			other.filled_buckets = 0u;
+			other.old = Old_Store{};
+
+			return *this;
+		}
+
+		~Hash_Map()
+		{
+			destroy_slots();
+		}
+
+	public:
+		struct Insert_Result
+		{
+			Value& value;
+			bool inserted; // False when the key was already there and "value" is the existing one
+		};
+
+		// With a transparent Hash/Eq "key" can be anything they accept and the Key is only built when it
+		// actually gets inserted, otherwise it's converted to a Key first so that it's hashed only once
+		template<typename K, typename V>
+		Value& insert(K&& key, V&& value)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return insert(Key(std::forward<K>(key)), std::forward<V>(value));
+			}
+			else
+			{
+				auto hash = hasher(key);
+
+				return insert_hashed(std::forward<K>(key), std::forward<V>(value), hash);
+			}
+		}
+
+		// Builds the value from "args" only when "key" is missing, an existing value is left untouched
+		// One hash and one probe either way, unlike a get() followed by an insert()
+		template<typename K, typename... Args>
+		Insert_Result try_emplace(K&& key, Args&&... args)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return try_emplace(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+			}
+			else
+			{
+				auto hash = hasher(key);
+
+				return try_emplace_hashed(std::forward<K>(key), hash, std::forward<Args>(args)...);
+			}
+		}
+
+		// The "counts[word]++" pattern: the value of "key", default constructed first if it's missing
+		template<typename K>
+		Insert_Result get_or_insert_default(K&& key)
+		{
+			return try_emplace(std::forward<K>(key));
+		}
+
+		const Value* get(const Key& key) const
+		{
+			return find_value(key);
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		const Value* get(const K& key) const
+		{
+			return find_value(key);
+		}
+
+		// Mutable access for updating a value in place, the pointer is invalidated by the next insert or remove
+		Value* get(const Key& key)
+		{
+			return const_cast<Value*>(find_value(key));
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		Value* get(const K& key)
+		{
+			return const_cast<Value*>(find_value(key));
+		}
+
+		bool contains(const Key& key) const
+		{
+			return find_value(key) != nullptr;
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool contains(const K& key) const
+		{
+			return find_value(key) != nullptr;
+		}
+
+		bool remove(const Key& key)
+		{
+			return remove_key(key, hasher(key));
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool remove(const K& key)
+		{
+			return remove_key(key, hasher(key));
+		}
+
+		// Batched lookups for many independent keys, e.g. resolving thousands of ids at once: the slots of
+		// the next keys are prefetched while the current one is resolved, which hides part of the memory
+		// latency once the table doesn't fit in the cache
+		// "keys" are Keys, or anything the Hash/Eq accept when they are transparent
+
+		// results[i] = get(keys[i])
+		template<typename K>
+		void get_many(const K* keys, size_t count, const Value** results) const
+		{
+			static_assert(std::is_same_v<K, Key> || Transparent_Hash<Hash, Eq>, "Keys of another type need a transparent Hash and Eq");
+
+			if (filled_buckets == 0u)
+			{
+				for (size_t i = 0u; i < count; ++i)
+				{
+					results[i] = nullptr;
+				}
+
+				return;
+			}
+
+			for_each_batched(keys, count, [&](size_t i, size_t hash)
+			{
+				results[i] = find_value(keys[i], hash);
+			});
+		}
+
+		// results[i] = contains(keys[i]), returns how many were found
+		template<typename K>
+		size_t contains_many(const K* keys, size_t count, bool* results) const
+		{
+			static_assert(std::is_same_v<K, Key> || Transparent_Hash<Hash, Eq>, "Keys of another type need a transparent Hash and Eq");
+
+			size_t found = 0u;
+
+			if (filled_buckets == 0u)
+			{
+				for (size_t i = 0u; i < count; ++i)
+				{
+					results[i] = false;
+				}
+
+				return found;
+			}
+
+			for_each_batched(keys, count, [&](size_t i, size_t hash)
+			{
+				results[i] = find_value(keys[i], hash) != nullptr;
+				found += results[i];
+			});
+
+			return found;
+		}
+
+		// insert(keys[i], values[i]) for every i, a key that shows up twice keeps its last value
+		// Growing isn't anticipated, reserve() first when most of the keys are new
+		void insert_many(const Key* keys, const Value* values, size_t count)
 		{
-			return (control_byte & BIT_OCCUPIED) == 0;
+			for_each_batched(keys, count, [&](size_t i, size_t hash)
+			{
+				insert_hashed(keys[i], values[i], hash);
+			});
 		}
 
-		static bool is_match(uint8_t control_byte, uint8_t fingerprint)
+		// The same with a precomputed hash, for a caller that already hashed the key, e.g. to pick a shard of
+		// a Concurrent_Hash_Map. "hash" must be hasher(key) and "key" a Key, or anything the Hash/Eq accept
+		// when they are transparent
+		template<typename K>
+		const Value* get_hashed(const K& key, size_t hash) const
 		{
-			return control_byte == (fingerprint | BIT_OCCUPIED);
+			return filled_buckets > 0u ? find_value(key, hash) : nullptr;
 		}
 
-		static uint8_t make_control_byte(size_t hash)
+		template<typename K>
+		Value* get_hashed(const K& key, size_t hash)
 		{
-			static_assert(sizeof(size_t) == 8, "The logic is built upon the assumption that size_t is 8 bytes");
-			uint8_t fingerprint = static_cast<uint8_t>(hash >> 57);
-			return fingerprint | BIT_OCCUPIED;
+			return filled_buckets > 0u ? const_cast<Value*>(find_value(key, hash)) : nullptr;
 		}
 
-		Eq equalizer;
-		Hash hasher;
-		size_t filled_buckets{0u};
-		Array<uint8_t> states;
-		Slot* slots{nullptr};
-
-	private:
-		void destroy_slots()
+		template<typename K, typename V>
+		Value& insert_hashed(K&& key, V&& value, size_t hash)
 		{
-			if constexpr (std::is_trivially_destructible_v<Slot> == false)
+			auto [table, index, found] = find_insert_slot(key, hash);
+
+			if (found)
 			{
-				if (filled_buckets > 0u)
-				{
-					size_t count = states.size();
+				table.value(index) = std::forward<V>(value); // overwrite existing
+				return table.value(index);
+			}
 
-					for (size_t i = 0; i < count; ++i)
-					{
-						if (is_empty(states[i]))
-							continue;
+			table.construct(index, std::forward<K>(key), std::forward<V>(value));
+			occupy(index, hash);
 
-						std::destroy_at(&slots[i]);
-					}
-				}
-			}
-			::operator delete(slots);
+			return table.value(index);
 		}
 
-		void grow_then_rehash()
+		template<typename K, typename... Args>
+		Insert_Result try_emplace_hashed(K&& key, size_t hash, Args&&... args)
 		{
-			size_t new_size = states.size() * GROWTH_FACTOR;
-			auto new_states_list = Array<uint8_t>{new_size};
-			auto new_slots_list = static_cast<Slot*>(::operator new(new_size * sizeof(Slot)));
+			auto [table, index, found] = find_insert_slot(key, hash);
 
-			for (size_t i = 0u; i < states.size(); ++i)
+			if (found)
 			{
-				if (!is_empty(states[i]))
-				{
-					auto new_hash = hasher(slots[i].key);
-					auto new_index = new_hash & (new_size - 1u);
-
-					while (!is_empty(new_states_list[new_index]))
-					{
-						new_index = (new_index + 1u) & (new_size - 1u);
-					}
-
-					new_states_list[new_index] = states[i];
-					new (&new_slots_list[new_index]) Slot{std::move(slots[i].key), std::move(slots[i].value)};
-
-					std::destroy_at(&slots[i]);
-				}
+				return Insert_Result{table.value(index), false};
 			}
-			::operator delete(slots);
 
-			states = std::move(new_states_list);
-			slots = new_slots_list;
+			table.construct(index, std::forward<K>(key), std::forward<Args>(args)...);
+			occupy(index, hash);
+
+			return Insert_Result{table.value(index), true};
 		}
 
-	public:
-		Hash_Map()
+		template<typename K>
+		bool remove_hashed(const K& key, size_t hash)
 		{
-			size_t count = GROWTH_SIZE * GROWTH_FACTOR;
-
-			states.resize(count);
-
-			slots = static_cast<Slot*>(::operator new(count * sizeof(Slot)));
+			return remove_key(key, hash);
 		}
 
-		Hash_Map(const Hash_Map& other):
-			equalizer{other.equalizer},
-			hasher{other.hasher},
-			filled_buckets{other.filled_buckets},
-			states{other.states}
+		// Makes room for "count" elements in total, so that many inserts don't grow the table
+		void reserve(size_t count)
 		{
-			size_t count = other.states.size();
+			size_t new_size = capacity_for(count);
 
-			slots = static_cast<Slot*>(::operator new(sizeof(Slot) * count));
+			if (new_size > states.size())
+			{
+				rehash(new_size);
+			}
+		}
 
-			if constexpr (std::is_trivially_copyable_v<Slot>)
+		// Removes every element and keeps the table for the next ones, e.g. for a map that's refilled every
+		// frame. Destroys the elements and zeroes the control bytes, or only bumps the generation with
+		// GENERATIONAL_CLEAR. The old table of a running incremental rehash is freed
+		void clear()
+		{
+			if constexpr (GENERATIONAL_CLEAR)
 			{
-				memcpy(slots, other.slots, sizeof(Slot) * count);
+				generations.advance();
 			}
 			else
 			{
-				for (size_t i = 0u; i < count; ++i)
+				destroy_elements();
+
+				if constexpr (INCREMENTAL_REHASH)
 				{
-					if (!is_empty(other.states[i]))
+					if (is_rehashing())
 					{
-						new (&slots[i]) Slot(other.slots[i]);
+						old.slots.deallocate();
+						old = Old_Table{};
 					}
 				}
-			}
-		}
 
-		Hash_Map& operator=(const Hash_Map& other)
-		{
-			if (this == &other)
-			{
-				return *this;
+				if (states.size() > 0u)
+				{
+					memset(states.buffer(), 0, states.size());
+				}
 			}
 
-			destroy_slots();
-
-			size_t count = other.states.size();
+			filled_buckets = 0u;
+		}
 
-			slots = static_cast<Slot*>(::operator new(sizeof(Slot) * count));
+		// Rehashes into the smallest table that holds the current elements, an empty map frees everything
+		void shrink_to_fit()
+		{
+			size_t new_size = capacity_for(filled_buckets);
 
-			if constexpr (std::is_trivially_copyable_v<Slot>)
+			if (new_size < states.size())
 			{
-				memcpy(slots, other.slots, sizeof(Slot) * count);
+				rehash(new_size);
 			}
 			else
 			{
-				for (size_t i = 0u; i < count; ++i)
+				finish_rehash();
+			}
+		}
+
+		// Migrates up to "slot_budget" slots of a running incremental rehash, e.g. once per frame to finish
+		// it sooner than the inserts alone would. Returns whether the migration is still running
+		bool step(size_t slot_budget = REHASH_STEP)
+		{
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				if (is_rehashing())
 				{
-					if (!is_empty(other.states[i]))
-					{
-						new (&slots[i]) Slot(other.slots[i]);
-					}
+					migrate(slot_budget);
 				}
 			}
 
-			equalizer = other.equalizer;
-			hasher = other.hasher;
-			filled_buckets = other.filled_buckets;
-			states = other.states;
-
-			return *this;
+			return is_rehashing();
 		}
 
-		Hash_Map(Hash_Map&& other):
-			equalizer{std::move(other.equalizer)},
-			hasher{std::move(other.hasher)},
-			filled_buckets{other.filled_buckets},
-			states{std::move(other.states)},
-			slots{other.slots}
+		// True while an incremental rehash keeps two tables, always false without INCREMENTAL_REHASH
+		bool is_rehashing() const
 		{
-			other.slots = nullptr;
-			other.filled_buckets = 0u;
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				return old.states.size() > 0u;
+			}
+			else
+			{
+				return false;
+			}
 		}
 
-		Hash_Map& operator=(Hash_Map&& other)
+		size_t count() const { return filled_buckets; }
+		size_t capacity() const { return states.size(); } // Of the new table during an incremental rehash
+
+		// Walks the whole table, meant for tuning and telemetry rather than for every frame
+		Hash_Stats stats() const
 		{
-			if (this == &other)
+			constexpr size_t SLOT_BYTES = Slot_Table::SLOT_BYTES + 1u + (STORE_HASH ? sizeof(size_t) : 0u);
+
+			Hash_Stats result;
+
+			result.count = filled_buckets;
+			result.capacity = states.size();
+			result.load_factor = states.size() > 0u ? static_cast<float>(filled_buckets - old_count()) / static_cast<float>(states.size()) : 0.0f;
+			result.rehash_count = rehashes;
+			result.bytes_used = filled_buckets * SLOT_BYTES;
+			result.bytes_reserved = states.size() * SLOT_BYTES;
+
+			if constexpr (INCREMENTAL_REHASH)
 			{
-				return *this;
+				result.bytes_reserved += old.states.size() * SLOT_BYTES + old.dead.size() * sizeof(uint64_t);
 			}
 
-			destroy_slots();
+			if constexpr (PROBE_COUNTERS)
+			{
+				result.probe_counters = counters.load();
+			}
 
-			equalizer = std::move(other.equalizer);
-			hasher = std::move(other.hasher);
-			filled_buckets = other.filled_buckets;
-			states = std::move(other.states);
-			slots = other.slots;
+			detail::collect_probe_stats(states, [this](size_t index) { return slot_hash(index); }, result, generations.view());
 
-			other.slots = nullptr;
-			other.filled_buckets = 0u;
+			return result;
+		}
 
-			return *this;
+		// Zeroes the live counters of PROBE_COUNTERS, e.g. at the start of every frame
+		void reset_probe_counters()
+		{
+			if constexpr (PROBE_COUNTERS)
+			{
+				counters.store(Hash_Probe_Counters{});
+			}
 		}
 
-		~Hash_Map()
+	public: // Iterator-related
+		// What the mutable iterator yields, the key stays read-only
+		struct Entry
 		{
-			destroy_slots();
+			const Key& key;
+			Value& value;
+		};
+
+		// What the iterator yields with SPLIT_SLOTS, there is no slot holding both
+		struct Const_Entry
+		{
+			const Key& key;
+			const Value& value;
+		};
+
+		// Calls fn(key, value) for every element, with a mutable value on a non-const map. Cheaper than the
+		// iterators, the occupied slots of every control group are visited straight from its bitmask
+		// NOTE: must not insert into or remove from the map
+		template<typename F>
+		void for_each(F&& fn)
+		{
+			visit_slots([&](Key& key, Value& value) { fn(static_cast<const Key&>(key), value); });
 		}
 
-	public:
-		template<typename K, typename V>
-		Value& insert(K&& key, V&& value)
+		template<typename F>
+		void for_each(F&& fn) const
 		{
-			if (filled_buckets >= static_cast<size_t>(LOAD_FACTOR * states.size()))
-			{
-				grow_then_rehash();
-			}
+			visit_slots([&](const Key& key, const Value& value) { fn(key, value); });
+		}
 
-			auto hash = hasher(key);
-			uint8_t control_byte = make_control_byte(hash);
-			size_t index = hash & (states.size() - 1u);
+	private:
+		template<typename F>
+		void visit_slots(F&& visit) const
+		{
+			detail::for_each_occupied(states.buffer(), states.size(), [&](size_t index) { visit(slots.key(index), slots.value(index)); }, generations.view());
 
-			while (!is_empty(states[index]))
+			if constexpr (INCREMENTAL_REHASH)
 			{
-				if (states[index] == control_byte)
+				for (size_t index = detail::next_occupied(old.states.buffer(), old.cursor, old.states.size());
+					index < old.states.size();
+					index = detail::next_occupied(old.states.buffer(), index + 1u, old.states.size()))
 				{
-					if (equalizer(key, slots[index].key))
+					if (is_dead(index) == false)
 					{
-						slots[index].value = std::forward<V>(value); // overwrite existing
-						return slots[index].value;
+						visit(old.slots.key(index), old.slots.value(index));
 					}
 				}
-
-				index = (index + 1u) & (states.size() - 1u);
 			}
-
-			states[index] = control_byte;
-			new (&slots[index]) Slot{std::forward<K>(key), std::forward<V>(value)};
-
-			filled_buckets++;
-
-			return slots[index].value;
 		}
 
-		const Value* get(const Key& key) const
+		// Position of the iterators: the occupied slots of the table, then the ones left in the old table
+		// during an incremental rehash. Empty slots are skipped a control group at a time
+		class Slot_Cursor
 		{
-			if (filled_buckets == 0)
+		public:
+			struct Range
 			{
-				return nullptr;
+				const uint8_t* states{nullptr};
+				Slot_Table table;
+				size_t index{0u};
+				size_t end{0u};
+				const uint64_t* dead{nullptr}; // Removed-slot flags of the old table
+				detail::Generation_View generations{};
+			};
+
+			Slot_Cursor(Range range, Range next_range = Range{}):
+				current{range},
+				next{next_range}
+			{
+				skip_empty();
 			}
 
-			auto hash = hasher(key);
-			uint8_t control_byte = make_control_byte(hash);
-			size_t index = hash & (states.size() - 1u);
-
-			while (!is_empty(states[index]))
+			void advance()
 			{
-				if (states[index] == control_byte)
+				if (current.index != current.end)
 				{
-					if (equalizer(key, slots[index].key))
-					{
-						return &slots[index].value;
-					}
+					++current.index;
 				}
 
-				index = (index + 1u) & (states.size() - 1u);
+				skip_empty();
 			}
 
-			return nullptr;
-		}
+			bool operator==(const Slot_Cursor& other) const
+			{
+				return current.states + current.index == other.current.states + other.current.index;
+			}
 
-		bool contains(const Key& key) const
-		{
-			return get(key) != nullptr;
-		}
+			Key& key() const
+			{
+				return current.table.key(current.index);
+			}
 
-		bool remove(const Key& key)
-		{
-			if (filled_buckets == 0)
+			Value& value() const
 			{
-				return false;
+				return current.table.value(current.index);
 			}
 
-			auto _size = states.size();
-			auto mask = _size - 1u;
+			// Without SPLIT_SLOTS only
+			auto& slot() const
+			{
+				return current.table.slots[current.index];
+			}
 
-			auto hash = hasher(key);
-			auto hole_control_byte = make_control_byte(hash);
-			auto hole_index = hash & mask;
-			auto found = false;
+		private:
+			bool is_dead(size_t index) const
+			{
+				return current.dead != nullptr && ((current.dead[index / 64u] >> (index % 64u)) & 1u);
+			}
 
-			while (!is_empty(states[hole_index]))
+			void skip_empty()
 			{
-				if (states[hole_index] == hole_control_byte)
+				while (true)
 				{
-					if (equalizer(key, slots[hole_index].key))
+					current.index = detail::next_occupied(current.states, current.index, current.end, current.generations);
+
+					while (current.index != current.end && is_dead(current.index))
 					{
-						found = true;
-						break;
+						current.index = detail::next_occupied(current.states, current.index + 1u, current.end, current.generations);
 					}
-				}
 
-				hole_index = (hole_index + 1u) & mask;
-			}
+					if (current.index != current.end || next.index == next.end)
+					{
+						return;
+					}
 
-			if (found == false)
-			{
-				return false;
+					current = next;
+					next = Range{};
+				}
 			}
 
-			auto current_index = (hole_index + 1u) & mask;
-			auto dist = [mask, _size](size_t a, size_t b) { return (b + _size - a) & mask; };
+			Range current;
+			Range next;
+		};
+
+		Slot_Cursor first_slot() const
+		{
+			typename Slot_Cursor::Range table{states.buffer(), slots, 0u, states.size(), nullptr, generations.view()};
 
-			while(!is_empty(states[current_index]))
+			if constexpr (INCREMENTAL_REHASH)
 			{
-				auto home_hash = hasher(slots[current_index].key);
-				auto home_index = home_hash & mask;
+				if (is_rehashing())
+				{
+					return Slot_Cursor{table, {old.states.buffer(), old.slots, old.cursor, old.states.size(), old.dead.buffer()}};
+				}
+			}
 
-				auto dist_home_to_hole = dist(home_index, hole_index);
-				auto dist_home_to_current = dist(home_index, current_index);
+			return Slot_Cursor{table};
+		}
 
-				if (dist_home_to_hole <= dist_home_to_current)
+		Slot_Cursor past_last_slot() const
+		{
+			if constexpr (INCREMENTAL_REHASH)
+			{
+				if (is_rehashing())
 				{
-					slots[hole_index] = std::move(slots[current_index]);
-					states[hole_index] = states[current_index];
-
-					hole_index = current_index;
+					return Slot_Cursor{{old.states.buffer(), old.slots, old.states.size(), old.states.size()}};
 				}
-
-				current_index = (current_index + 1u) & mask;
 			}
 
-			states[hole_index] = 0;
-			std::destroy_at(&slots[hole_index]);
-			filled_buckets--;
-
-			return true;
+			return Slot_Cursor{{states.buffer(), slots, states.size(), states.size()}};
 		}
 
-		size_t count() const { return filled_buckets; }
-		size_t capacity() const { return states.size(); }
+		// operator-> of the iterators that yield entries by value
+		template<typename E>
+		struct Arrow_Proxy
+		{
+			E entry;
 
-	public: // Iterator-related
+			const E* operator->() const { return &entry; }
+		};
+
+	public:
+		// Yields the slot itself, or a Const_Entry with SPLIT_SLOTS. Both have "key" and "value" members
 		class Iterator // Input Iterator
 		{
 		public:
-			Iterator(const uint8_t* state_ptr, const Slot* slot_ptr, const uint8_t* state_end):
-				state_ptr{state_ptr},
-				slot_ptr{slot_ptr},
-				state_end{state_end}
+			explicit Iterator(Slot_Cursor cursor):
+				cursor{cursor}
 			{
-				skip_empty();
+
 			}
 
 			Iterator& operator++()
 			{
-				if (state_ptr != state_end)
-				{
-					++state_ptr;
-					++slot_ptr;
-				}
-
-				skip_empty();
+				cursor.advance();
 
 				return *this;
 			}
 
 			bool operator!=(const Iterator& other) const
 			{
-				return state_ptr != other.state_ptr;
+				return !(cursor == other.cursor);
 			}
 
 			bool operator==(const Iterator& other) const
 			{
-				return state_ptr == other.state_ptr;
+				return cursor == other.cursor;
 			}
 
-			const Slot& operator*() const
+			decltype(auto) operator*() const
 			{
-				return *slot_ptr;
-			}
-
-			const Slot* operator->() const
-			{
-				return slot_ptr;
+				if constexpr (SPLIT_SLOTS)
+				{
+					return Const_Entry{cursor.key(), cursor.value()};
+				}
+				else
+				{
+					return static_cast<const typename Slot_Table::Slot&>(cursor.slot());
+				}
 			}
 
-		private:
-			void skip_empty()
+			auto operator->() const
 			{
-				while (state_ptr != state_end && is_empty(*state_ptr))
+				if constexpr (SPLIT_SLOTS)
+				{
+					return Arrow_Proxy<Const_Entry>{**this};
+				}
+				else
 				{
-					state_ptr++;
-					slot_ptr++;
+					return static_cast<const typename Slot_Table::Slot*>(&cursor.slot());
 				}
 			}
 
-			const uint8_t* state_ptr{nullptr};
-			const Slot* slot_ptr{nullptr};
-			const uint8_t* state_end{nullptr};
+		private:
+			Slot_Cursor cursor;
 		};
 
-		Iterator begin() const
+		// Yields Entry by value like Flat_Map's iterator, so it's "auto" or "const auto&" in a range-for
+		class Mutable_Iterator // Input Iterator
 		{
-			return Iterator{states.begin(), slots, states.end()};
-		}
+		public:
+			using Arrow = Arrow_Proxy<Entry>;
 
-		Iterator end() const
-		{
-			auto s_end = states.end();
+			explicit Mutable_Iterator(Slot_Cursor cursor):
+				cursor{cursor}
+			{
 
-			return Iterator{s_end, slots + states.size(), s_end};
-		}
+			}
+
+			Mutable_Iterator& operator++()
+			{
+				cursor.advance();
+
+				return *this;
+			}
+
+			bool operator!=(const Mutable_Iterator& other) const
+			{
+				return !(cursor == other.cursor);
+			}
+
+			bool operator==(const Mutable_Iterator& other) const
+			{
+				return cursor == other.cursor;
+			}
+
+			Entry operator*() const
+			{
+				return Entry{cursor.key(), cursor.value()};
+			}
+
+			Arrow operator->() const
+			{
+				return Arrow{**this};
+			}
+
+		private:
+			Slot_Cursor cursor;
+		};
+
+		Iterator begin() const { return Iterator{first_slot()}; }
+		Iterator end() const { return Iterator{past_last_slot()}; }
+
+		Mutable_Iterator begin() { return Mutable_Iterator{first_slot()}; }
+		Mutable_Iterator end() { return Mutable_Iterator{past_last_slot()}; }
 	};
 };
@@ -1,30 +1,64 @@
 #pragma once
 
 #include "Array.h"
+#include "Hash_Group.h"
+#include "Hash.h"
+#include "Hash_Stats.h"
 
 #include <functional>
 #include <cstddef>
+#include <cstring>
 #include <type_traits>
 
 namespace hstl
 {
-	template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<T>>
+	// Compile-time knobs of Hash_Set, see Hash_Map_Options
+	template<typename T>
+	struct Hash_Set_Options
+	{
+		// Keeps the full hash of every slot in a side array, see Hash_Map_Options::STORE_HASH
+		static constexpr bool STORE_HASH = std::is_trivially_copyable_v<T> == false;
+
+		// Live probe counters, see Hash_Map_Options::PROBE_COUNTERS
+		static constexpr bool PROBE_COUNTERS = HSTL_HASH_PROBE_COUNTERS != 0;
+
+		// O(1) clear() through generation tags, see Hash_Map_Options::GENERATIONAL_CLEAR
+		static constexpr bool GENERATIONAL_CLEAR = false;
+	};
+
+	template<typename T, typename Hash = hstl::Hash<T>, typename Eq = Equal_To<T>, typename Options = Hash_Set_Options<T>>
 	class Hash_Set
 	{
 	private:
-		static constexpr size_t GROWTH_SIZE = 1024;
+		static constexpr bool STORE_HASH = Options::STORE_HASH;
+		static constexpr bool PROBE_COUNTERS = Options::PROBE_COUNTERS;
+		static constexpr bool GENERATIONAL_CLEAR = Options::GENERATIONAL_CLEAR;
+		static constexpr size_t MIN_CAPACITY = 16u;
 		static constexpr size_t GROWTH_FACTOR = 2u;
-		static constexpr float LOAD_FACTOR = 0.7f;
+		static constexpr float LOAD_FACTOR = 0.875f;
 		// The MSB (Most Significant Bit) marks a slot as OCCUPIED.
 		// 0b1xxxxxxx = Occupied
 		// 0b0xxxxxxx = Empty
 		static constexpr uint8_t BIT_OCCUPIED = 0b10000000;
 
+		using Group = detail::Control_Group;
+
+		static_assert(MIN_CAPACITY % Group::WIDTH == 0u, "The table must be made of whole groups");
+		static_assert(GENERATIONAL_CLEAR == false || std::is_trivially_destructible_v<T>, "GENERATIONAL_CLEAR skips the destructors, T must be trivially destructible");
+
+		using Hash_Store = std::conditional_t<STORE_HASH, Array<size_t>, detail::No_Hash_Store>;
+		using Counter_Store = std::conditional_t<PROBE_COUNTERS, detail::Live_Probe_Counters, detail::No_Probe_Counters>;
+		using Generation_Store = std::conditional_t<GENERATIONAL_CLEAR, detail::Group_Generations, detail::No_Group_Generations>;
+
 		Eq equalizer;
 		Hash hasher;
 		size_t filled_buckets{0u};
 		Array<uint8_t> states;
 		T* values{nullptr};
+		[[no_unique_address]] Hash_Store hashes; // Parallel to "states" with STORE_HASH, empty otherwise
+		[[no_unique_address]] mutable Counter_Store counters; // Only with PROBE_COUNTERS
+		[[no_unique_address]] Generation_Store generations; // Only with GENERATIONAL_CLEAR
+		size_t rehashes{0u};
 
 	private:
 		static bool is_empty(uint8_t control_byte)
@@ -46,25 +80,335 @@ namespace hstl
 			return control_byte | BIT_OCCUPIED;
 		}
 
+		struct Probe_Result
+		{
+			size_t index; // Slot of the key when found, otherwise the empty slot where it would go
+			bool found;
+		};
+
+		// Linear probing a group at a time, see Hash_Map::probe
+		template<typename K>
+		Probe_Result probe(const K& key, size_t hash) const
+		{
+			size_t mask = states.size() - 1u;
+			size_t home = hash & mask;
+			size_t group_index = home & ~(Group::WIDTH - 1u);
+			uint8_t control_byte = make_control_byte(hash);
+			auto window = Group::bits_from(home - group_index);
+
+			if constexpr (PROBE_COUNTERS)
+			{
+				counters.count_probe();
+			}
+
+			while (true)
+			{
+				Group group{generations.view().group(states.buffer(), group_index)};
+
+				auto empties = group.match_empty() & window;
+				auto matches = group.match(control_byte) & window & detail::bits_before_first(empties);
+
+				if constexpr (PROBE_COUNTERS)
+				{
+					counters.count_group();
+				}
+
+				while (matches != 0u)
+				{
+					size_t index = group_index + Group::index_of(matches);
+
+					if (hash_matches(index, hash))
+					{
+						if constexpr (PROBE_COUNTERS)
+						{
+							counters.count_compare();
+						}
+
+						if (equalizer(key, values[index]))
+						{
+							return Probe_Result{index, true};
+						}
+					}
+
+					matches = clear_lowest_bit(matches);
+				}
+
+				if (empties != 0u)
+				{
+					return Probe_Result{group_index + Group::index_of(empties), false};
+				}
+
+				group_index = (group_index + Group::WIDTH) & mask;
+				window = Group::ALL;
+			}
+		}
+
+		bool hash_matches(size_t index, size_t hash) const
+		{
+			if constexpr (STORE_HASH)
+			{
+				return hashes[index] == hash;
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		// Control byte of the slot at "index", empty in a group left stale by clear()
+		uint8_t control_byte(size_t index) const
+		{
+			if constexpr (GENERATIONAL_CLEAR)
+			{
+				return generations.view().control_byte(states.buffer(), index);
+			}
+			else
+			{
+				return states[index];
+			}
+		}
+
+		size_t slot_hash(size_t index) const
+		{
+			if constexpr (STORE_HASH)
+			{
+				return hashes[index];
+			}
+			else
+			{
+				return hasher(values[index] /*key*/);
+			}
+		}
+
+		static size_t find_empty(const Array<uint8_t>& control_bytes, size_t hash)
+		{
+			size_t mask = control_bytes.size() - 1u;
+			size_t home = hash & mask;
+			size_t group_index = home & ~(Group::WIDTH - 1u);
+			auto window = Group::bits_from(home - group_index);
+
+			while (true)
+			{
+				auto empties = Group{&control_bytes[group_index]}.match_empty() & window;
+
+				if (empties != 0u)
+				{
+					return group_index + Group::index_of(empties);
+				}
+
+				group_index = (group_index + Group::WIDTH) & mask;
+				window = Group::ALL;
+			}
+		}
+
+		template<typename K>
+		const T* find_value(const K& key) const
+		{
+			if (filled_buckets == 0)
+			{
+				return nullptr;
+			}
+
+			return find_value(key, hasher(key));
+		}
+
+		// "hash" must be hasher(key) and the set must not be empty
+		template<typename K>
+		const T* find_value(const K& key, size_t hash) const
+		{
+			auto [index, found] = probe(key, hash);
+
+			return found ? &values[index] : nullptr;
+		}
+
+		// Starts loading the first group and the home slot of "hash", the table must not be empty
+		void prefetch_home(size_t hash) const
+		{
+			size_t home = hash & (states.size() - 1u);
+
+			prefetch(&states[home & ~(Group::WIDTH - 1u)]);
+			prefetch(&values[home]);
+		}
+
+		// See Hash_Map::for_each_batched
+		template<typename K, typename F>
+		void for_each_batched(const K* keys, size_t count, F&& resolve) const
+		{
+			constexpr size_t DISTANCE = detail::PREFETCH_DISTANCE;
+
+			if (states.size() * (sizeof(T) + 1u) < detail::PREFETCH_MIN_TABLE_BYTES)
+			{
+				for (size_t i = 0u; i < count; ++i)
+				{
+					resolve(i, hasher(keys[i]));
+				}
+
+				return;
+			}
+
+			size_t ahead_hashes[DISTANCE];
+			size_t ahead = count < DISTANCE ? count : DISTANCE;
+
+			for (size_t i = 0u; i < ahead; ++i)
+			{
+				ahead_hashes[i] = hasher(keys[i]);
+				prefetch_home(ahead_hashes[i]);
+			}
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				size_t hash = ahead_hashes[i % DISTANCE];
+
+				if (i + DISTANCE < count)
+				{
+					size_t next_hash = hasher(keys[i + DISTANCE]);
+
+					ahead_hashes[i % DISTANCE] = next_hash;
+					prefetch_home(next_hash);
+				}
+
+				resolve(i, hash);
+			}
+		}
+
+		template<typename K>
+		T& insert_hashed(K&& key, size_t hash)
+		{
+			if (filled_buckets >= static_cast<size_t>(LOAD_FACTOR * states.size()))
+			{
+				grow_then_rehash();
+			}
+
+			auto [index, found] = probe(key, hash);
+
+			if (found)
+			{
+				return values[index];
+			}
+
+			generations.claim(states.buffer(), index);
+			states[index] = make_control_byte(hash);
+			new (&values[index]) T(std::forward<K>(key));
+
+			if constexpr (STORE_HASH)
+			{
+				hashes[index] = hash;
+			}
+
+			filled_buckets++;
+
+			return values[index];
+		}
+
+		template<typename K>
+		bool remove_key(const K& key)
+		{
+			if (filled_buckets == 0)
+			{
+				return false;
+			}
+
+			auto _size = states.size();
+			auto mask = (_size - 1u);
+			auto [hole_index, found] = probe(key, hasher(key));
+
+			if (found == false)
+			{
+				return false;
+			}
+
+			auto current_index = (hole_index + 1u) & mask;
+			auto dist = [mask, _size](size_t a, size_t b) { return (b + _size - a) & mask; };
+
+			while(!is_empty(control_byte(current_index)))
+			{
+				auto home_hash = slot_hash(current_index);
+				auto home_index = home_hash & mask;
+				auto dist_home_to_hole = dist(home_index, hole_index);
+				auto dist_home_to_current = dist(home_index, current_index);
+
+				// Shift the ruines to preserve the probing path
+				if (dist_home_to_hole <= dist_home_to_current)
+				{
+					values[hole_index] = std::move(values[current_index]);
+					states[hole_index] = states[current_index];
+
+					if constexpr (STORE_HASH)
+					{
+						hashes[hole_index] = hashes[current_index];
+					}
+
+					hole_index = current_index;
+				}
+
+				current_index = (current_index + 1u) & mask;
+			}
+
+			states[hole_index] = 0;
+			std::destroy_at(&values[hole_index]);
+			filled_buckets--;
+
+			return true;
+		}
+
+		// Smallest table that holds "count" elements without growing, nothing at all for zero elements
+		static size_t capacity_for(size_t count)
+		{
+			if (count == 0u)
+			{
+				return 0u;
+			}
+
+			size_t capacity = MIN_CAPACITY;
+
+			while (static_cast<size_t>(LOAD_FACTOR * capacity) < count)
+			{
+				capacity *= GROWTH_FACTOR;
+			}
+
+			return capacity;
+		}
+
 		void grow_then_rehash()
 		{
-			size_t new_size = states.size() * GROWTH_FACTOR;
-			auto new_states_list = Array<uint8_t>{new_size};
-			auto new_values_list = static_cast<T*>(::operator new(new_size * sizeof(T)));
+			rehash(states.size() > 0u ? states.size() * GROWTH_FACTOR : MIN_CAPACITY);
+		}
+
+		// Moves every element into a table of "new_size" slots, zero frees the table
+		void rehash(size_t new_size)
+		{
+			rehashes++;
+
+			auto new_states_list = Array<uint8_t>{};
+			auto new_hashes_list = Hash_Store{};
+			T* new_values_list = nullptr;
+
+			if (new_size > 0u)
+			{
+				new_states_list = Array<uint8_t>{new_size};
+				new_values_list = static_cast<T*>(::operator new(new_size * sizeof(T)));
+
+				if constexpr (STORE_HASH)
+				{
+					new_hashes_list = Array<size_t>{new_size};
+				}
+			}
 
 			for (size_t i = 0u; i < states.size(); ++i)
 			{
-				if (!is_empty(states[i]))
+				uint8_t old_control_byte = control_byte(i);
+
+				if (!is_empty(old_control_byte))
 				{
-					auto new_hash = hasher(values[i] /*key*/);
-					auto new_index = new_hash & (new_size - 1u);
+					auto hash = slot_hash(i);
+					auto new_index = find_empty(new_states_list, hash);
+
+					new_states_list[new_index] = old_control_byte;
 
-					while (!is_empty(new_states_list[new_index]))
+					if constexpr (STORE_HASH)
 					{
-						new_index = (new_index + 1u) & (new_size - 1u);
+						new_hashes_list[new_index] = hash;
 					}
-
-					new_states_list[new_index] = states[i];
 					new (&new_values_list[new_index]) T(std::move(values[i]));
 
 					std::destroy_at(&values[i]);
@@ -73,10 +417,13 @@ namespace hstl
 			::operator delete(values);
 
 			states = std::move(new_states_list);
+			hashes = std::move(new_hashes_list);
 			values = new_values_list;
+			generations.reset(new_size);
 		}
 
-		void destroy_values()
+		// Runs the destructors of the elements, leaves the slots allocated
+		void destroy_elements()
 		{
 			if constexpr (std::is_trivially_destructible_v<T> == false)
 			{
@@ -93,38 +440,49 @@ namespace hstl
 					}
 				}
 			}
-			::operator delete(values);
 		}
 
-	public:
-		Hash_Set()
+		void destroy_values()
 		{
-			size_t count = GROWTH_SIZE * GROWTH_FACTOR;
+			destroy_elements();
+
+			::operator delete(values);
+		}
 
-			states.resize(count);
+	public:
+		// Allocates nothing, the table is created by the first insert
+		Hash_Set() = default;
 
-			values = static_cast<T*>(::operator new(count * sizeof(T)));
+		// Sizes the table for "capacity_hint" elements up front
+		explicit Hash_Set(size_t capacity_hint)
+		{
+			reserve(capacity_hint);
 		}
 
 		Hash_Set(const Hash_Set& other):
 			equalizer{other.equalizer},
 			hasher{other.hasher},
 			filled_buckets{other.filled_buckets},
-			states{other.states}
+			states{other.states},
+			hashes{other.hashes},
+			generations{other.generations}
 		{
 			size_t count = other.states.size();
 
-			values = static_cast<T*>(::operator new(count * sizeof(T)));
+			values = count > 0u ? static_cast<T*>(::operator new(count * sizeof(T))) : nullptr;
 
 			if constexpr (std::is_trivially_copyable_v<T> == true)
 			{
-				memcpy(values, other.values, sizeof(T) * count);
+				if (count > 0u)
+				{
+					memcpy(values, other.values, sizeof(T) * count);
+				}
 			}
 			else
 			{
 				for (size_t i = 0u; i < count; ++i)
 				{
-					if (is_empty(other.states[i]))
+					if (is_empty(other.control_byte(i)))
 						continue;
 
 					new (&values[i]) T(other.values[i]);
@@ -143,17 +501,20 @@ namespace hstl
 
 			size_t count = other.states.size();
 
-			values = static_cast<T*>(::operator new(count * sizeof(T)));
+			values = count > 0u ? static_cast<T*>(::operator new(count * sizeof(T))) : nullptr;
 
 			if constexpr (std::is_trivially_copyable_v<T> == true)
 			{
-				memcpy(values, other.values, sizeof(T) * count);
+				if (count > 0u)
+				{
+					memcpy(values, other.values, sizeof(T) * count);
+				}
 			}
 			else
 			{
 				for (size_t i = 0u; i < count; ++i)
 				{
-					if (is_empty(other.states[i]))
+					if (is_empty(other.control_byte(i)))
 						continue;
 
 					new (&values[i]) T(other.values[i]);
@@ -164,6 +525,8 @@ namespace hstl
 			hasher = other.hasher;
 			filled_buckets = other.filled_buckets;
 			states = other.states;
+			hashes = other.hashes;
+			generations = other.generations;
 
 			return *this;
 		}
@@ -173,7 +536,11 @@ namespace hstl
 			hasher{std::move(other.hasher)},
 			filled_buckets{other.filled_buckets},
 			states{std::move(other.states)},
-			values{other.values}
+			values{other.values},
+			hashes{std::move(other.hashes)},
+			counters{other.counters},
+			generations{std::move(other.generations)},
+			rehashes{other.rehashes}
 		{
 			other.values = nullptr;
 			other.filled_buckets = 0u;
@@ -193,6 +560,10 @@ namespace hstl
 			filled_buckets = other.filled_buckets;
 			states = std::move(other.states);
 			values = other.values;
+			hashes = std::move(other.hashes);
+			counters = other.counters;
+			generations = std::move(other.generations);
+			rehashes = other.rehashes;
 
 			other.values = nullptr;
 			other.filled_buckets = 0u;
@@ -206,165 +577,221 @@ namespace hstl
 		}
 
 	public:
+		// Implicit conversions are allowed, e.g. Hash_Set<Str> accepts set.insert("SSSS")
+		// With a transparent Hash/Eq the T is only built when the key is missing, otherwise the key is
+		// converted to a T first so that it's hashed only once
 		template<typename K>
 		T& insert(K&& key)
 		{
-			auto size = states.size();
-
-			if (filled_buckets >= static_cast<size_t>(LOAD_FACTOR * size))
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, T> == false)
 			{
-				grow_then_rehash();
+				return insert(T(std::forward<K>(key)));
 			}
-
-			// NOTE: I didn't want to force `std::is_same<T, K>` to allow implicit conversions
-			// e.g. Hash_Set<Str> set should accept set.insert("SSSS")
-			auto mask = size - 1u;
-			auto hash = hasher(key);
-			uint8_t control_byte = make_control_byte(hash);
-			size_t index = hash & mask;
-
-			while (!is_empty(states[index]))
+			else
 			{
-				if (control_byte == states[index])
-				{
-					if (equalizer(key, values[index]))
-					{
-						return values[index];
-					}
-				}
+				auto hash = hasher(key);
 
-				index = (index + 1u) & mask; // linear probing
+				return insert_hashed(std::forward<K>(key), hash);
 			}
+		}
 
-			states[index] = control_byte;
-			new (&values[index]) T(std::forward<K>(key));
+		const T* get(const T& key) const
+		{
+			return find_value(key);
+		}
 
-			filled_buckets++;
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		const T* get(const K& key) const
+		{
+			return find_value(key);
+		}
 
-			return values[index];
+		bool contains(const T& key) const
+		{
+			return find_value(key) != nullptr;
 		}
 
-		const T* get(const T& key) const
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool contains(const K& key) const
 		{
-			if (filled_buckets == 0)
-			{
-				return nullptr;
-			}
+			return find_value(key) != nullptr;
+		}
 
-			auto size = states.size();
-			auto mask = size - 1u;
-			auto hash = hasher(key);
-			uint8_t control_byte = make_control_byte(hash);
-			size_t index = hash & mask;
+		bool remove(const T& key)
+		{
+			return remove_key(key);
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool remove(const K& key)
+		{
+			return remove_key(key);
+		}
 
-			while (!is_empty(states[index]))
+		// Batched lookups, see Hash_Map::get_many
+
+		// results[i] = get(keys[i])
+		template<typename K>
+		void get_many(const K* keys, size_t count, const T** results) const
+		{
+			static_assert(std::is_same_v<K, T> || Transparent_Hash<Hash, Eq>, "Keys of another type need a transparent Hash and Eq");
+
+			if (filled_buckets == 0u)
 			{
-				if (control_byte == states[index])
+				for (size_t i = 0u; i < count; ++i)
 				{
-					if (equalizer(key, values[index]) == true)
-					{
-						return &values[index];
-					}
+					results[i] = nullptr;
 				}
 
-				index = (index + 1u) & mask;
+				return;
 			}
 
-			return nullptr;
+			for_each_batched(keys, count, [&](size_t i, size_t hash)
+			{
+				results[i] = find_value(keys[i], hash);
+			});
 		}
 
-		bool contains(const T& key) const
+		// results[i] = contains(keys[i]), returns how many were found
+		template<typename K>
+		size_t contains_many(const K* keys, size_t count, bool* results) const
 		{
-			if (filled_buckets == 0)
+			static_assert(std::is_same_v<K, T> || Transparent_Hash<Hash, Eq>, "Keys of another type need a transparent Hash and Eq");
+
+			size_t found = 0u;
+
+			if (filled_buckets == 0u)
 			{
-				return false;
+				for (size_t i = 0u; i < count; ++i)
+				{
+					results[i] = false;
+				}
+
+				return found;
 			}
 
-			return get(key) != nullptr;
+			for_each_batched(keys, count, [&](size_t i, size_t hash)
+			{
+				results[i] = find_value(keys[i], hash) != nullptr;
+				found += results[i];
+			});
+
+			return found;
 		}
 
-		bool remove(const T& key)
+		// insert(keys[i]) for every i, reserve() first when most of the keys are new
+		void insert_many(const T* keys, size_t count)
 		{
-			if (filled_buckets == 0)
+			for_each_batched(keys, count, [&](size_t i, size_t hash)
 			{
-				return false;
-			}
+				insert_hashed(keys[i], hash);
+			});
+		}
 
-			auto _size = states.size();
-			auto mask = (_size - 1u);
-			auto hash = hasher(key);
-			auto hole_control_byte = make_control_byte(hash);
-			auto hole_index = hash & mask;
-			auto found = false;
+		// Makes room for "count" elements in total, so that many inserts don't grow the table
+		void reserve(size_t count)
+		{
+			size_t new_size = capacity_for(count);
 
-			while (!is_empty(states[hole_index]))
+			if (new_size > states.size())
 			{
-				if (states[hole_index] == hole_control_byte)
-				{
-					if (equalizer(key, values[hole_index]) == true)
-					{
-						found = true;
-						break;
-					}
-				}
-
-				hole_index = (hole_index + 1u) & mask;
+				rehash(new_size);
 			}
+		}
 
-			if (found == false)
+		// Removes every element and keeps the table, see Hash_Map::clear
+		void clear()
+		{
+			if constexpr (GENERATIONAL_CLEAR)
 			{
-				return false;
+				generations.advance();
 			}
-
-			auto current_index = (hole_index + 1u) & mask;
-			auto dist = [mask, _size](size_t a, size_t b) { return (b + _size - a) & mask; };
-
-			while(!is_empty(states[current_index]))
+			else
 			{
-				auto home_hash = hasher(values[current_index] /*key*/);
-				auto home_index = home_hash & mask;
-				auto dist_home_to_hole = dist(home_index, hole_index);
-				auto dist_home_to_current = dist(home_index, current_index);
+				destroy_elements();
 
-				// Shift the ruines to preserve the probing path
-				if (dist_home_to_hole <= dist_home_to_current)
+				if (states.size() > 0u)
 				{
-					values[hole_index] = std::move(values[current_index]);
-					states[hole_index] = states[current_index];
-					hole_index = current_index;
+					memset(states.buffer(), 0, states.size());
 				}
-
-				current_index = (current_index + 1u) & mask;
 			}
 
-			states[hole_index] = 0;
-			std::destroy_at(&values[hole_index]);
-			filled_buckets--;
+			filled_buckets = 0u;
+		}
 
-			return true;
+		// Rehashes into the smallest table that holds the current elements, an empty set frees everything
+		void shrink_to_fit()
+		{
+			size_t new_size = capacity_for(filled_buckets);
+
+			if (new_size < states.size())
+			{
+				rehash(new_size);
+			}
 		}
 
 		size_t count() const { return filled_buckets; }
 		size_t capacity() const { return states.size(); }
 
+		// Walks the whole table, see Hash_Map::stats
+		Hash_Stats stats() const
+		{
+			constexpr size_t SLOT_BYTES = sizeof(T) + 1u + (STORE_HASH ? sizeof(size_t) : 0u);
+
+			Hash_Stats result;
+
+			result.count = filled_buckets;
+			result.capacity = states.size();
+			result.load_factor = states.size() > 0u ? static_cast<float>(filled_buckets) / static_cast<float>(states.size()) : 0.0f;
+			result.rehash_count = rehashes;
+			result.bytes_used = filled_buckets * SLOT_BYTES;
+			result.bytes_reserved = states.size() * SLOT_BYTES;
+
+			if constexpr (PROBE_COUNTERS)
+			{
+				result.probe_counters = counters.load();
+			}
+
+			detail::collect_probe_stats(states, [this](size_t index) { return slot_hash(index); }, result, generations.view());
+
+			return result;
+		}
+
+		void reset_probe_counters()
+		{
+			if constexpr (PROBE_COUNTERS)
+			{
+				counters.store(Hash_Probe_Counters{});
+			}
+		}
+
 	public: // Iterator-related
-		class Iterator // Input Iterator
+		// Calls fn(value) for every value, the occupied slots of every control group are visited straight
+		// from its bitmask. Must not insert into or remove from the set
+		template<typename F>
+		void for_each(F&& fn) const
+		{
+			detail::for_each_occupied(states.buffer(), states.size(), [&](size_t index) { fn(static_cast<const T&>(values[index])); }, generations.view());
+		}
+
+		class Iterator // Input Iterator, skips empty slots a control group at a time
 		{
 		public:
-			Iterator(const uint8_t* state_ptr, const T* value_ptr, const uint8_t* state_end):
-				state_ptr{state_ptr},
-				value_ptr{value_ptr},
-				state_end{state_end}
+			Iterator(const uint8_t* states, const T* values, size_t index, size_t end, detail::Generation_View generations = {}):
+				states{states},
+				values{values},
+				index{index},
+				end{end},
+				generations{generations}
 			{
 				skip_empty();
 			}
 
 			Iterator& operator++()
 			{
-				if (state_ptr != state_end)
+				if (index != end)
 				{
-					++state_ptr;
-					++value_ptr;
+					++index;
 				}
 
 				skip_empty();
@@ -374,50 +801,46 @@ namespace hstl
 
 			bool operator!=(const Iterator& iterator) const
 			{
-				return state_ptr != iterator.state_ptr;
+				return index != iterator.index;
 			}
 
 			bool operator==(const Iterator& iterator) const
 			{
-				return state_ptr == iterator.state_ptr;
+				return index == iterator.index;
 			}
 
 			const T& operator*() const
 			{
-				return *value_ptr;
+				return values[index];
 			}
 
 			const T* operator->() const
 			{
-				return value_ptr;
+				return values + index;
 			}
 
 		private:
 			void skip_empty()
 			{
-				while (state_ptr != state_end && is_empty(*state_ptr))
-				{
-					state_ptr++;
-					value_ptr++;
-				}
+				index = detail::next_occupied(states, index, end, generations);
 			}
 
 		private:
-			const uint8_t* state_ptr{nullptr};
-			const T* value_ptr{nullptr};
-			const uint8_t* state_end{nullptr};
+			const uint8_t* states{nullptr};
+			const T* values{nullptr};
+			size_t index{0u};
+			size_t end{0u};
+			detail::Generation_View generations;
 		};
 
 		Iterator begin() const
 		{
-			return Iterator{states.buffer(), values, states.end()};
+			return Iterator{states.buffer(), values, 0u, states.size(), generations.view()};
 		}
 
 		Iterator end() const
 		{
-			auto s_end = states.end();
-
-			return Iterator{s_end, values + states.size(), s_end};
+			return Iterator{states.buffer(), values, states.size(), states.size()};
 		}
 	};
 };
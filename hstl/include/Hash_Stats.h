@@ -0,0 +1,226 @@
+#pragma once
+
+#include "Array.h"
+#include "Hash_Group.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Build with HSTL_HASH_PROBE_COUNTERS=1 to turn on the live probe counters of every Hash_Map and Hash_Set,
+// a single container can also opt in through its Options::PROBE_COUNTERS
+#if !defined(HSTL_HASH_PROBE_COUNTERS)
+	#define HSTL_HASH_PROBE_COUNTERS 0
+#endif
+
+namespace hstl
+{
+	// Counted by every probe of a container with PROBE_COUNTERS, inserts and removes included
+	struct Hash_Probe_Counters
+	{
+		uint64_t probes{0u};
+		uint64_t probed_groups{0u}; // Control groups loaded, probed_groups / probes is the live mean probe length
+		uint64_t compared_keys{0u}; // Calls to Eq, anything above one per hit is a fingerprint (or hash) collision
+	};
+
+	// Snapshot of the shape of a Hash_Map or Hash_Set, see stats(). Telling a bad hash from a high load:
+	// a bad hash shows long probes and fingerprint collisions at a normal load factor, a high load shows
+	// long miss probes with few collisions
+	// Probe lengths count the control groups a lookup loads (1 is the best case). The miss numbers assume
+	// that a missing key is equally likely to land on any slot
+	// During an incremental rehash the probe numbers are those of the new table
+	struct Hash_Stats
+	{
+		size_t count{0u};
+		size_t capacity{0u};
+		float load_factor{0.0f};
+
+		double mean_hit_probe{0.0};
+		size_t max_hit_probe{0u};
+		double mean_miss_probe{0.0};
+		size_t max_miss_probe{0u};
+
+		// hit_probe_histogram[n] is the number of elements that are found after loading n + 1 groups
+		Array<size_t> hit_probe_histogram;
+
+		// Other elements with the same 7-bit fingerprint met on the way, each one costs a key compare
+		double fingerprint_collisions_per_hit{0.0};
+		double fingerprint_collisions_per_miss{0.0};
+
+		size_t rehash_count{0u}; // Since the container was created
+
+		size_t bytes_used{0u}; // Slots, control bytes and stored hashes of the elements
+		size_t bytes_reserved{0u}; // The same for every slot of the table(s)
+
+		Hash_Probe_Counters probe_counters; // All zero without PROBE_COUNTERS
+	};
+
+	namespace detail
+	{
+		// Stands in for Hash_Probe_Counters when a container doesn't count
+		struct No_Probe_Counters
+		{
+		};
+
+		// The live Hash_Probe_Counters of a container. Relaxed atomics, so concurrent const lookups (e.g. the
+		// shared-locked readers of Concurrent_Hash_Map) can count without a data race
+		struct Live_Probe_Counters
+		{
+			std::atomic<uint64_t> probes{0u};
+			std::atomic<uint64_t> probed_groups{0u};
+			std::atomic<uint64_t> compared_keys{0u};
+
+			Live_Probe_Counters() = default;
+
+			Live_Probe_Counters(const Live_Probe_Counters& other)
+			{
+				store(other.load());
+			}
+
+			Live_Probe_Counters& operator=(const Live_Probe_Counters& other)
+			{
+				store(other.load());
+
+				return *this;
+			}
+
+			void count_probe()
+			{
+				probes.fetch_add(1u, std::memory_order_relaxed);
+			}
+
+			void count_group()
+			{
+				probed_groups.fetch_add(1u, std::memory_order_relaxed);
+			}
+
+			void count_compare()
+			{
+				compared_keys.fetch_add(1u, std::memory_order_relaxed);
+			}
+
+			Hash_Probe_Counters load() const
+			{
+				Hash_Probe_Counters result;
+				result.probes = probes.load(std::memory_order_relaxed);
+				result.probed_groups = probed_groups.load(std::memory_order_relaxed);
+				result.compared_keys = compared_keys.load(std::memory_order_relaxed);
+
+				return result;
+			}
+
+			void store(const Hash_Probe_Counters& values)
+			{
+				probes.store(values.probes, std::memory_order_relaxed);
+				probed_groups.store(values.probed_groups, std::memory_order_relaxed);
+				compared_keys.store(values.compared_keys, std::memory_order_relaxed);
+			}
+		};
+
+		// Fills the probe numbers of "stats" from the control bytes of a table, "slot_hash(index)" is the
+		// full hash of an occupied slot. Linear in the size of the table plus the total displacement
+		template<typename Slot_Hash>
+		void collect_probe_stats(const Array<uint8_t>& control_bytes, Slot_Hash&& slot_hash, Hash_Stats& stats, Generation_View generations = {})
+		{
+			using Group = Control_Group;
+
+			constexpr uint8_t BIT_OCCUPIED = 0b10000000;
+
+			size_t capacity = control_bytes.size();
+
+			if (capacity == 0u)
+			{
+				return;
+			}
+
+			size_t mask = capacity - 1u;
+
+			auto control_byte_at = [&](size_t index) { return generations.control_byte(control_bytes.buffer(), index); };
+
+			// Groups loaded by a probe that starts at "home" and stops in the group of "index"
+			auto groups_between = [mask](size_t home, size_t index)
+			{
+				size_t first_group = home & ~(Group::WIDTH - 1u);
+
+				return ((index - first_group) & mask) / Group::WIDTH + 1u;
+			};
+
+			size_t hits = 0u;
+			size_t hit_groups = 0u;
+			size_t hit_collisions = 0u;
+
+			for (size_t index = 0u; index < capacity; ++index)
+			{
+				uint8_t control_byte = control_byte_at(index);
+
+				if ((control_byte & BIT_OCCUPIED) == 0u)
+				{
+					continue;
+				}
+
+				size_t home = slot_hash(index) & mask;
+				size_t groups = groups_between(home, index);
+
+				for (size_t other = home; other != index; other = (other + 1u) & mask)
+				{
+					hit_collisions += control_byte_at(other) == control_byte;
+				}
+
+				while (stats.hit_probe_histogram.size() < groups)
+				{
+					stats.hit_probe_histogram.push(0u);
+				}
+
+				stats.hit_probe_histogram[groups - 1u]++;
+				stats.max_hit_probe = groups > stats.max_hit_probe ? groups : stats.max_hit_probe;
+
+				hits++;
+				hit_groups += groups;
+			}
+
+			// A miss from "home" stops at the first empty slot at or after it, found walking backwards from
+			// an empty slot (the table always has one, the load factor is below 1)
+			size_t last_empty = capacity;
+
+			for (size_t index = capacity; index-- > 0u;)
+			{
+				if ((control_byte_at(index) & BIT_OCCUPIED) == 0u)
+				{
+					last_empty = index;
+					break;
+				}
+			}
+
+			size_t miss_groups = 0u;
+			size_t miss_occupied = 0u;
+			size_t next_empty = last_empty;
+
+			for (size_t step = 0u; step < capacity; ++step)
+			{
+				size_t home = (last_empty - step) & mask;
+
+				if ((control_byte_at(home) & BIT_OCCUPIED) == 0u)
+				{
+					next_empty = home;
+				}
+
+				size_t groups = groups_between(home, next_empty);
+
+				stats.max_miss_probe = groups > stats.max_miss_probe ? groups : stats.max_miss_probe;
+
+				miss_groups += groups;
+				miss_occupied += (next_empty - home) & mask;
+			}
+
+			if (hits > 0u)
+			{
+				stats.mean_hit_probe = static_cast<double>(hit_groups) / static_cast<double>(hits);
+				stats.fingerprint_collisions_per_hit = static_cast<double>(hit_collisions) / static_cast<double>(hits);
+			}
+
+			// A missing key has a random fingerprint, 1 in 128 of the occupied slots it passes match it
+			stats.mean_miss_probe = static_cast<double>(miss_groups) / static_cast<double>(capacity);
+			stats.fingerprint_collisions_per_miss = static_cast<double>(miss_occupied) / static_cast<double>(capacity) / 128.0;
+		}
+	}
+};
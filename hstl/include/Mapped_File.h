@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Result.h"
+
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_WIN32)
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace hstl
+{
+	// Read-only view of a whole file mapped into memory, the pages are loaded on first touch and shared
+	// with every other process that maps the same file. The mapping is page aligned
+	// An empty file maps to a null data() with a zero size
+	class Mapped_File
+	{
+	private:
+		const uint8_t* _data{nullptr};
+		size_t _size{0u};
+
+	public:
+		static Result<Mapped_File> open(const char* path)
+		{
+#if defined(_WIN32)
+			HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				return Err{"Mapped_File: can't open the file"};
+			}
+
+			LARGE_INTEGER file_size;
+
+			if (GetFileSizeEx(file, &file_size) == false)
+			{
+				CloseHandle(file);
+
+				return Err{"Mapped_File: can't read the file size"};
+			}
+
+			Mapped_File mapped;
+
+			if (file_size.QuadPart > 0)
+			{
+				// The view keeps the mapping alive, both handles can be closed right away
+				HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				CloseHandle(file);
+
+				if (mapping == nullptr)
+				{
+					return Err{"Mapped_File: can't map the file"};
+				}
+
+				void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+
+				if (view == nullptr)
+				{
+					return Err{"Mapped_File: can't map the file"};
+				}
+
+				mapped._data = static_cast<const uint8_t*>(view);
+				mapped._size = static_cast<size_t>(file_size.QuadPart);
+			}
+			else
+			{
+				CloseHandle(file);
+			}
+
+			return mapped;
+#else
+			int file = ::open(path, O_RDONLY);
+
+			if (file < 0)
+			{
+				return Err{"Mapped_File: can't open the file"};
+			}
+
+			struct stat file_stat;
+
+			if (fstat(file, &file_stat) != 0)
+			{
+				::close(file);
+
+				return Err{"Mapped_File: can't read the file size"};
+			}
+
+			Mapped_File mapped;
+
+			if (file_stat.st_size > 0)
+			{
+				// The mapping outlives the descriptor
+				void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+				::close(file);
+
+				if (view == MAP_FAILED)
+				{
+					return Err{"Mapped_File: can't map the file"};
+				}
+
+				mapped._data = static_cast<const uint8_t*>(view);
+				mapped._size = static_cast<size_t>(file_stat.st_size);
+			}
+			else
+			{
+				::close(file);
+			}
+
+			return mapped;
+#endif
+		}
+
+		Mapped_File() = default;
+
+		Mapped_File(const Mapped_File&) = delete;
+		Mapped_File& operator=(const Mapped_File&) = delete;
+
+		Mapped_File(Mapped_File&& other) noexcept:
+			_data{std::exchange(other._data, nullptr)},
+			_size{std::exchange(other._size, 0u)}
+		{
+
+		}
+
+		Mapped_File& operator=(Mapped_File&& other) noexcept
+		{
+			if (this != &other)
+			{
+				close();
+
+				_data = std::exchange(other._data, nullptr);
+				_size = std::exchange(other._size, 0u);
+			}
+
+			return *this;
+		}
+
+		~Mapped_File()
+		{
+			close();
+		}
+
+	public:
+		const uint8_t* data() const
+		{
+			return _data;
+		}
+
+		size_t size() const
+		{
+			return _size;
+		}
+
+		void close()
+		{
+			if (_data == nullptr)
+			{
+				return;
+			}
+
+#if defined(_WIN32)
+			UnmapViewOfFile(_data);
+#else
+			munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+
+			_data = nullptr;
+			_size = 0u;
+		}
+	};
+};
@@ -0,0 +1,374 @@
+#pragma once
+
+#include "Array.h"
+#include "Thread_Pool.h"
+
+#include <functional>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+namespace hstl
+{
+	// Ranges smaller than this are not worth waking up the workers for
+	static constexpr size_t PARALLEL_GRAIN_SIZE = 1u << 14;
+
+	// A few tasks per thread so that a slow thread doesn't hold the whole job back
+	static constexpr size_t PARALLEL_TASKS_PER_THREAD = 4u;
+
+	inline size_t parallel_task_count(size_t element_count, Thread_Pool* pool)
+	{
+		size_t by_grain = (element_count + PARALLEL_GRAIN_SIZE - 1u) / PARALLEL_GRAIN_SIZE;
+		size_t by_threads = pool->thread_count() * PARALLEL_TASKS_PER_THREAD;
+
+		return std::max<size_t>(1u, std::min(by_grain, by_threads));
+	}
+
+	// Splits [0, element_count) into task_count contiguous chunks and calls f(task, begin, end) for each
+	template<typename F>
+	void parallel_chunks(size_t element_count, size_t task_count, Thread_Pool* pool, F f)
+	{
+		pool->parallel_for(task_count, [&](size_t task)
+		{
+			size_t begin = element_count * task / task_count;
+			size_t end = element_count * (task + 1u) / task_count;
+
+			f(task, begin, end);
+		});
+	}
+
+	template<typename In, typename Out, typename F>
+	void parallel_transform(const Array<In>& input, Array<Out>& output, F f, Thread_Pool* pool = Thread_Pool::get())
+	{
+		static_assert(std::is_invocable_r_v<Out, F, const In&>, "F must be callable as Out(const In&)");
+
+		size_t count = input.size();
+
+		output.resize(count);
+
+		parallel_chunks(count, parallel_task_count(count, pool), pool, [&](size_t, size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				output[i] = f(input[i]);
+			}
+		});
+	}
+
+	// "op" has to be associative, partial results are combined in chunk order
+	template<typename T, typename Op = std::plus<T>>
+	T parallel_reduce(const Array<T>& array, T initial, Op op = Op{}, Thread_Pool* pool = Thread_Pool::get())
+	{
+		size_t count = array.size();
+
+		if (count == 0u)
+		{
+			return initial;
+		}
+
+		size_t task_count = parallel_task_count(count, pool);
+		Array<T> partials{task_count};
+
+		parallel_chunks(count, task_count, pool, [&](size_t task, size_t begin, size_t end)
+		{
+			T accumulator = array[begin];
+
+			for (size_t i = begin + 1u; i < end; ++i)
+			{
+				accumulator = op(std::move(accumulator), array[i]);
+			}
+
+			partials[task] = std::move(accumulator);
+		});
+
+		for (size_t i = 0u; i < task_count; ++i)
+		{
+			initial = op(std::move(initial), partials[i]);
+		}
+
+		return initial;
+	}
+
+	namespace detail
+	{
+		// Three passes: reduce every chunk, scan the chunk totals serially, then scan every chunk with its carry
+		// "output" may be the same array as "input"
+		template<bool INCLUSIVE, typename T, typename Op>
+		void parallel_scan(const Array<T>& input, Array<T>& output, const T* initial, Op op, Thread_Pool* pool)
+		{
+			size_t count = input.size();
+
+			output.resize(count);
+
+			if (count == 0u)
+			{
+				return;
+			}
+
+			size_t task_count = parallel_task_count(count, pool);
+			Array<T> carries{task_count};
+
+			parallel_chunks(count, task_count, pool, [&](size_t task, size_t begin, size_t end)
+			{
+				T accumulator = input[begin];
+
+				for (size_t i = begin + 1u; i < end; ++i)
+				{
+					accumulator = op(std::move(accumulator), input[i]);
+				}
+
+				carries[task] = std::move(accumulator);
+			});
+
+			// carries[i] becomes the combination of everything before chunk i
+			bool has_carry = initial != nullptr;
+			T running = initial ? *initial : T{};
+
+			for (size_t i = 0u; i < task_count; ++i)
+			{
+				T chunk_total = std::move(carries[i]);
+
+				carries[i] = running;
+				running = has_carry ? op(std::move(running), chunk_total) : std::move(chunk_total);
+				has_carry = true;
+			}
+
+			parallel_chunks(count, task_count, pool, [&](size_t task, size_t begin, size_t end)
+			{
+				bool chunk_has_carry = task > 0u || initial != nullptr;
+				T accumulator = carries[task];
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					T element = input[i];
+
+					if constexpr (INCLUSIVE)
+					{
+						accumulator = chunk_has_carry ? op(std::move(accumulator), element) : std::move(element);
+						chunk_has_carry = true;
+
+						output[i] = accumulator;
+					}
+					else
+					{
+						output[i] = accumulator;
+
+						accumulator = op(std::move(accumulator), element);
+					}
+				}
+			});
+		}
+
+		// Finds how many of the first "diagonal" merged elements come from "a" (merge path co-ranking)
+		// Ties are resolved in favor of "a" to match std::merge
+		template<typename T, typename Compare>
+		size_t merge_path_split(const T* a, size_t a_count, const T* b, size_t b_count, size_t diagonal, Compare& compare)
+		{
+			size_t low = diagonal > b_count ? diagonal - b_count : 0u;
+			size_t high = std::min(diagonal, a_count);
+
+			while (low < high)
+			{
+				size_t i = low + (high - low) / 2u;
+				size_t j = diagonal - i;
+
+				if (compare(b[j - 1u], a[i]) == false)
+				{
+					low = i + 1u;
+				}
+				else
+				{
+					high = i;
+				}
+			}
+
+			return low;
+		}
+	}
+
+	template<typename T, typename Op = std::plus<T>>
+	void parallel_inclusive_scan(const Array<T>& input, Array<T>& output, Op op = Op{}, Thread_Pool* pool = Thread_Pool::get())
+	{
+		detail::parallel_scan<true>(input, output, static_cast<const T*>(nullptr), op, pool);
+	}
+
+	template<typename T, typename Op = std::plus<T>>
+	void parallel_exclusive_scan(const Array<T>& input, Array<T>& output, T initial, Op op = Op{}, Thread_Pool* pool = Thread_Pool::get())
+	{
+		detail::parallel_scan<false>(input, output, &initial, op, pool);
+	}
+
+	// Chunks are sorted independently then merged pair-wise, every merge is split along its
+	// merge path so that all threads stay busy even in the last rounds
+	template<typename T, typename Compare = std::less<T>>
+	void parallel_sort(Array<T>& array, Compare compare = Compare{}, Thread_Pool* pool = Thread_Pool::get())
+	{
+		static_assert(std::is_move_assignable_v<T>, "T must have a move assignment operator");
+
+		size_t count = array.size();
+		size_t run_count = parallel_task_count(count, pool);
+
+		if (run_count == 1u)
+		{
+			std::sort(array.begin(), array.end(), compare);
+			return;
+		}
+
+		Array<size_t> run_bounds{run_count + 1u};
+
+		for (size_t i = 0u; i <= run_count; ++i)
+		{
+			run_bounds[i] = count * i / run_count;
+		}
+
+		pool->parallel_for(run_count, [&](size_t run)
+		{
+			std::sort(array.begin() + run_bounds[run], array.begin() + run_bounds[run + 1u], compare);
+		});
+
+		Array<T> scratch{count};
+		T* source = array.buffer();
+		T* destination = scratch.buffer();
+
+		struct Merge_Piece
+		{
+			size_t left;   // start of the left run
+			size_t middle; // start of the right run
+			size_t right;  // end of the right run
+			size_t first_diagonal;
+			size_t last_diagonal;
+			size_t first_split{0u}; // how many elements of the left run come before first_diagonal
+			size_t last_split{0u};
+		};
+
+		Array<Merge_Piece> pieces;
+		Array<size_t> next_bounds;
+
+		while (run_count > 1u)
+		{
+			pieces.clear();
+			next_bounds.clear();
+
+			for (size_t run = 0u; run < run_count; run += 2u)
+			{
+				size_t left = run_bounds[run];
+				size_t middle = run_bounds[run + 1u];
+				size_t right = run + 2u <= run_count ? run_bounds[run + 2u] : middle; // an odd run out is just moved over
+
+				size_t total = right - left;
+				size_t piece_count = std::max<size_t>(1u, total / PARALLEL_GRAIN_SIZE);
+
+				for (size_t piece = 0u; piece < piece_count; ++piece)
+				{
+					pieces.push(Merge_Piece{left, middle, right, total * piece / piece_count, total * (piece + 1u) / piece_count});
+				}
+
+				next_bounds.push(left);
+			}
+
+			next_bounds.push(count);
+
+			// NOTE: Splits read elements on both sides of a piece boundary, so they all have to be
+			// found before any piece starts moving elements out of "source"
+			pool->parallel_for(pieces.size(), [&](size_t index)
+			{
+				Merge_Piece& piece = pieces[index];
+
+				const T* a = source + piece.left;
+				const T* b = source + piece.middle;
+				size_t a_count = piece.middle - piece.left;
+				size_t b_count = piece.right - piece.middle;
+
+				piece.first_split = detail::merge_path_split(a, a_count, b, b_count, piece.first_diagonal, compare);
+				piece.last_split = detail::merge_path_split(a, a_count, b, b_count, piece.last_diagonal, compare);
+			});
+
+			pool->parallel_for(pieces.size(), [&](size_t index)
+			{
+				const Merge_Piece& piece = pieces[index];
+
+				size_t b_first = piece.first_diagonal - piece.first_split;
+				size_t b_last = piece.last_diagonal - piece.last_split;
+
+				std::merge(
+					std::make_move_iterator(source + piece.left + piece.first_split), std::make_move_iterator(source + piece.left + piece.last_split),
+					std::make_move_iterator(source + piece.middle + b_first), std::make_move_iterator(source + piece.middle + b_last),
+					destination + piece.left + piece.first_diagonal,
+					compare);
+			});
+
+			std::swap(source, destination);
+			std::swap(run_bounds, next_bounds);
+
+			run_count = run_bounds.size() - 1u;
+		}
+
+		if (source != array.buffer())
+		{
+			parallel_chunks(count, parallel_task_count(count, pool), pool, [&](size_t, size_t begin, size_t end)
+			{
+				std::move(source + begin, source + end, array.buffer() + begin);
+			});
+		}
+	}
+
+	// Order preserving, survivors are compacted into a new buffer in parallel then swapped in
+	template<typename T, typename F>
+	void parallel_remove_if(Array<T>& array, F f, Thread_Pool* pool = Thread_Pool::get())
+	{
+		static_assert(std::is_invocable_r_v<bool, F, const T&>, "Predicate must be callable as bool(const T&)");
+
+		size_t count = array.size();
+		size_t task_count = parallel_task_count(count, pool);
+
+		if (count == 0u)
+		{
+			return;
+		}
+
+		Array<uint8_t> removed{count};
+		Array<size_t> offsets{task_count + 1u};
+
+		parallel_chunks(count, task_count, pool, [&](size_t task, size_t begin, size_t end)
+		{
+			size_t survivors = 0u;
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				bool remove = f(array[i]);
+
+				removed[i] = remove;
+				survivors += remove == false;
+			}
+
+			offsets[task + 1u] = survivors;
+		});
+
+		for (size_t i = 1u; i <= task_count; ++i)
+		{
+			offsets[i] += offsets[i - 1u];
+		}
+
+		if (offsets[task_count] == count)
+		{
+			return;
+		}
+
+		Array<T> survivors{offsets[task_count]};
+
+		parallel_chunks(count, task_count, pool, [&](size_t task, size_t begin, size_t end)
+		{
+			size_t write = offsets[task];
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				if (removed[i] == false)
+				{
+					survivors[write++] = std::move(array[i]);
+				}
+			}
+		});
+
+		array = std::move(survivors);
+	}
+};
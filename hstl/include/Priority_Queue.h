@@ -0,0 +1,512 @@
+#pragma once
+
+#include "Array.h"
+
+#include <functional>
+#include <utility>
+#include <limits>
+#include <cstdint>
+#include <assert.h>
+
+namespace hstl
+{
+	namespace detail
+	{
+		// Shared index math of the d-ary heaps, children of "index" are [first_child(index), first_child(index) + ARITY)
+		template<size_t ARITY>
+		struct Heap_Layout
+		{
+			static_assert(ARITY >= 2u, "A heap needs at least two children per node");
+
+			static constexpr size_t parent(size_t index) { return (index - 1u) / ARITY; }
+			static constexpr size_t first_child(size_t index) { return index * ARITY + 1u; }
+		};
+	}
+
+	// d-ary heap on an Array, same ordering as std::priority_queue: top() is the largest element under
+	// "Compare", use std::greater<T> for a min-queue
+	// A 4-ary heap is half as deep as a binary one and the children of a node are adjacent, so a pop touches
+	// about half as many cache lines for the price of a few more compares per level
+	template<typename T, typename Compare = std::less<T>, size_t ARITY = 4u>
+	class Priority_Queue
+	{
+	private:
+		using Layout = detail::Heap_Layout<ARITY>;
+
+		Compare compare;
+		Array<T> heap;
+
+	private:
+		// Both sifts carry a hole instead of swapping, every level costs one move instead of three
+
+		void sift_up(size_t index)
+		{
+			T element = std::move(heap[index]);
+
+			while (index > 0u)
+			{
+				size_t parent = Layout::parent(index);
+
+				if (compare(heap[parent], element) == false)
+				{
+					break;
+				}
+
+				heap[index] = std::move(heap[parent]);
+				index = parent;
+			}
+
+			heap[index] = std::move(element);
+		}
+
+		// Index of the best child of "first"'s parent, the loop has a fixed trip count when the node is full
+		// so it unrolls into a chain of selects
+		size_t best_child(size_t first, size_t count) const
+		{
+			size_t best = first;
+
+			if (first + ARITY <= count)
+			{
+				for (size_t child = first + 1u; child < first + ARITY; ++child)
+				{
+					best = compare(heap[best], heap[child]) ? child : best;
+				}
+			}
+			else
+			{
+				for (size_t child = first + 1u; child < count; ++child)
+				{
+					best = compare(heap[best], heap[child]) ? child : best;
+				}
+			}
+
+			return best;
+		}
+
+		void sift_down(size_t index)
+		{
+			size_t count = heap.size();
+			T element = std::move(heap[index]);
+
+			while (true)
+			{
+				size_t first = Layout::first_child(index);
+
+				if (first >= count)
+				{
+					break;
+				}
+
+				size_t best = best_child(first, count);
+
+				if (compare(element, heap[best]) == false)
+				{
+					break;
+				}
+
+				heap[index] = std::move(heap[best]);
+				index = best;
+			}
+
+			heap[index] = std::move(element);
+		}
+
+		// Refills the root after a pop: the hole goes all the way down to a leaf without comparing against
+		// "element" and then "element" climbs back up. The element came from the bottom, so it rarely climbs
+		// far and every level saves the hard to predict compare of a plain sift down
+		void sift_down_from_root(T&& element)
+		{
+			size_t count = heap.size();
+			size_t index = 0u;
+
+			while (true)
+			{
+				size_t first = Layout::first_child(index);
+
+				if (first >= count)
+				{
+					break;
+				}
+
+				size_t best = best_child(first, count);
+
+				heap[index] = std::move(heap[best]);
+				index = best;
+			}
+
+			while (index > 0u)
+			{
+				size_t parent = Layout::parent(index);
+
+				if (compare(heap[parent], element) == false)
+				{
+					break;
+				}
+
+				heap[index] = std::move(heap[parent]);
+				index = parent;
+			}
+
+			heap[index] = std::move(element);
+		}
+
+		// Floyd's bottom-up construction, O(N)
+		void heapify()
+		{
+			if (heap.size() < 2u)
+			{
+				return;
+			}
+
+			for (size_t index = Layout::parent(heap.size() - 1u) + 1u; index-- > 0u;)
+			{
+				sift_down(index);
+			}
+		}
+
+	public:
+		Priority_Queue() = default;
+
+		// Bulk build: takes the elements in any order and heapifies them in place
+		Priority_Queue(Array<T>&& elements, Compare _compare = Compare{}):
+			compare{std::move(_compare)},
+			heap{std::move(elements)}
+		{
+			heapify();
+		}
+
+	public:
+		void push(const T& element)
+		{
+			heap.push(element);
+			sift_up(heap.size() - 1u);
+		}
+
+		void push(T&& element)
+		{
+			heap.push(std::move(element));
+			sift_up(heap.size() - 1u);
+		}
+
+		template<typename... Args>
+		void emplace(Args&&... args)
+		{
+			heap.emplace(std::forward<Args>(args)...);
+			sift_up(heap.size() - 1u);
+		}
+
+		const T& top() const
+		{
+			assert(heap.size() > 0u);
+
+			return heap[0];
+		}
+
+		// Removes the top element and hands it back
+		T pop()
+		{
+			assert(heap.size() > 0u);
+
+			size_t last = heap.size() - 1u;
+			T result = std::move(heap[0]);
+
+			if (last > 0u)
+			{
+				T element = std::move(heap[last]);
+				heap.remove(last);
+				sift_down_from_root(std::move(element));
+			}
+			else
+			{
+				heap.remove(last);
+			}
+
+			return result;
+		}
+
+		void reserve(size_t capacity) { heap.reserve(capacity); }
+		void clear() { heap.clear(); }
+
+		size_t count() const { return heap.size(); }
+		size_t capacity() const { return heap.capacity(); }
+		bool empty() const { return heap.size() == 0u; }
+
+		// Heap-ordered view of the storage
+		const Array<T>& element_array() const { return heap; }
+	};
+
+	// d-ary heap over dense integer ids, each id is in the queue at most once and its priority can be changed
+	// in place, which is what Dijkstra and A* need instead of pushing duplicates and skipping stale entries
+	// "positions" maps an id to its slot in the heap, so ids should be small (node indices, not hashes)
+	template<typename T, typename Compare = std::less<T>, size_t ARITY = 4u>
+	class Indexed_Priority_Queue
+	{
+	public:
+		static constexpr uint32_t INVALID_POSITION = std::numeric_limits<uint32_t>::max();
+
+		struct Node
+		{
+			T priority;
+			uint32_t id;
+		};
+
+	private:
+		using Layout = detail::Heap_Layout<ARITY>;
+
+		Compare compare;
+		Array<Node> heap;
+		Array<uint32_t> positions;
+
+	private:
+		void place(size_t index, Node&& node)
+		{
+			positions[node.id] = static_cast<uint32_t>(index);
+			heap[index] = std::move(node);
+		}
+
+		void sift_up(size_t index)
+		{
+			Node node = std::move(heap[index]);
+
+			while (index > 0u)
+			{
+				size_t parent = Layout::parent(index);
+
+				if (compare(heap[parent].priority, node.priority) == false)
+				{
+					break;
+				}
+
+				place(index, std::move(heap[parent]));
+				index = parent;
+			}
+
+			place(index, std::move(node));
+		}
+
+		void sift_down(size_t index)
+		{
+			size_t count = heap.size();
+			Node node = std::move(heap[index]);
+
+			while (true)
+			{
+				size_t first = Layout::first_child(index);
+
+				if (first >= count)
+				{
+					break;
+				}
+
+				size_t last = first + ARITY < count ? first + ARITY : count;
+				size_t best = first;
+
+				for (size_t child = first + 1u; child < last; ++child)
+				{
+					best = compare(heap[best].priority, heap[child].priority) ? child : best;
+				}
+
+				if (compare(node.priority, heap[best].priority) == false)
+				{
+					break;
+				}
+
+				place(index, std::move(heap[best]));
+				index = best;
+			}
+
+			place(index, std::move(node));
+		}
+
+		void make_room_for(uint32_t id)
+		{
+			while (positions.size() <= id)
+			{
+				positions.push(INVALID_POSITION);
+			}
+		}
+
+	public:
+		Indexed_Priority_Queue() = default;
+
+		// Bulk build: the priority of id "i" is priorities[i], every id ends up in the queue
+		Indexed_Priority_Queue(Array<T>&& priorities, Compare _compare = Compare{}):
+			compare{std::move(_compare)}
+		{
+			size_t count = priorities.size();
+
+			assert(count < INVALID_POSITION);
+
+			heap.reserve(count);
+			positions.reserve(count);
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				heap.push(Node{std::move(priorities[i]), static_cast<uint32_t>(i)});
+				positions.push(static_cast<uint32_t>(i));
+			}
+
+			if (count > 1u)
+			{
+				for (size_t index = Layout::parent(count - 1u) + 1u; index-- > 0u;)
+				{
+					sift_down(index);
+				}
+			}
+		}
+
+	public:
+		// Adds "id" with "priority", or moves it if it's already queued
+		void push(uint32_t id, T priority)
+		{
+			make_room_for(id);
+
+			if (positions[id] != INVALID_POSITION)
+			{
+				update(id, std::move(priority));
+				return;
+			}
+
+			heap.push(Node{std::move(priority), id});
+			sift_up(heap.size() - 1u);
+		}
+
+		// Moves a queued id toward the top, "priority" must not rank lower than its current one
+		// (with std::greater this is the classic decrease-key of Dijkstra)
+		void decrease_key(uint32_t id, T priority)
+		{
+			assert(contains(id));
+
+			size_t index = positions[id];
+
+			assert(compare(priority, heap[index].priority) == false);
+
+			heap[index].priority = std::move(priority);
+			sift_up(index);
+		}
+
+		// Changes the priority of a queued id in either direction
+		void update(uint32_t id, T priority)
+		{
+			assert(contains(id));
+
+			size_t index = positions[id];
+			bool moves_up = compare(heap[index].priority, priority);
+
+			heap[index].priority = std::move(priority);
+
+			if (moves_up)
+			{
+				sift_up(index);
+			}
+			else
+			{
+				sift_down(index);
+			}
+		}
+
+		const Node& top() const
+		{
+			assert(heap.size() > 0u);
+
+			return heap[0];
+		}
+
+		// Removes the top node and hands it back
+		Node pop()
+		{
+			assert(heap.size() > 0u);
+
+			Node result = std::move(heap[0]);
+			positions[result.id] = INVALID_POSITION;
+
+			size_t last = heap.size() - 1u;
+
+			if (last > 0u)
+			{
+				place(0u, std::move(heap[last]));
+			}
+
+			heap.remove(last);
+
+			if (last > 1u)
+			{
+				sift_down(0u);
+			}
+
+			return result;
+		}
+
+		// Takes a queued id out wherever it is
+		bool remove(uint32_t id)
+		{
+			if (contains(id) == false)
+			{
+				return false;
+			}
+
+			size_t index = positions[id];
+			size_t last = heap.size() - 1u;
+
+			positions[id] = INVALID_POSITION;
+
+			if (index == last)
+			{
+				heap.remove(last);
+				return true;
+			}
+
+			bool moves_up = compare(heap[index].priority, heap[last].priority);
+
+			place(index, std::move(heap[last]));
+			heap.remove(last);
+
+			if (moves_up)
+			{
+				sift_up(index);
+			}
+			else
+			{
+				sift_down(index);
+			}
+
+			return true;
+		}
+
+		bool contains(uint32_t id) const
+		{
+			return id < positions.size() && positions[id] != INVALID_POSITION;
+		}
+
+		const T* get(uint32_t id) const
+		{
+			return contains(id) ? &heap[positions[id]].priority : nullptr;
+		}
+
+		// "id_capacity" is one past the largest id that will be pushed
+		void reserve(size_t capacity, uint32_t id_capacity = 0u)
+		{
+			heap.reserve(capacity);
+
+			if (id_capacity > 0u)
+			{
+				positions.reserve(id_capacity);
+				make_room_for(id_capacity - 1u);
+			}
+		}
+
+		void clear()
+		{
+			for (const Node& node : heap)
+			{
+				positions[node.id] = INVALID_POSITION;
+			}
+
+			heap.clear();
+		}
+
+		size_t count() const { return heap.size(); }
+		size_t capacity() const { return heap.capacity(); }
+		bool empty() const { return heap.size() == 0u; }
+	};
+};
@@ -0,0 +1,529 @@
+#pragma once
+
+#include "Hash.h"
+#include "Hash_Group.h"
+#include "Epoch.h"
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <bit>
+#include <cstdint>
+
+namespace hstl
+{
+	namespace detail
+	{
+		// Control bytes read a word at a time, like the SWAR Control_Group but on atomic words so that the
+		// readers of a Read_Mostly_Hash_Map race with its writer without undefined behavior
+		struct Control_Word
+		{
+			static constexpr size_t WIDTH = 8u;
+			static constexpr uint64_t LOW_BITS = 0x7F7F7F7F7F7F7F7Full;
+			static constexpr uint64_t ONES = 0x0101010101010101ull;
+
+			// 0x80 in every byte of "word" equal to "control_byte", exact (no false positives from borrows)
+			static uint64_t match(uint64_t word, uint8_t control_byte)
+			{
+				uint64_t difference = word ^ (ONES * control_byte);
+
+				return ~(((difference & LOW_BITS) + LOW_BITS) | difference | LOW_BITS);
+			}
+
+			static size_t index_of(uint64_t mask)
+			{
+				return static_cast<size_t>(std::countr_zero(mask)) / 8u;
+			}
+
+			// Bits of the bytes at "offset" and after
+			static uint64_t bits_from(size_t offset)
+			{
+				return ~uint64_t{0u} << (offset * 8u);
+			}
+		};
+	}
+
+	// Hash map for tables that are read all the time and written rarely (string interning, type registries):
+	// lookups are wait-free and take no lock at all, so readers on different cores never write to a shared
+	// cache line and their throughput scales with the cores. Writers take a mutex and pay for everything else
+	// The table is the Hash_Map design (7-bit fingerprints in control bytes, linear probing a group at a
+	// time) with every element in its own immutable node, published through an atomic pointer:
+	// - insert publishes the node first and its control byte second, a reader that sees the byte sees the node
+	// - an overwrite publishes a new node and retires the old one, readers see either, never a mix
+	// - remove leaves a tombstone instead of shifting elements, a shift would hide keys from running probes
+	// - growing (or clearing the tombstones) builds a new table and swaps the pointer
+	// Old nodes and tables are freed through the Epoch_Domain once no reader can still be looking at them
+	// Values are only ever const, get() copies one out and visit() lends it for the duration of a call
+	template<typename Key, typename Value, typename Hash = hstl::Hash<Key>, typename Eq = Equal_To<Key>>
+	class Read_Mostly_Hash_Map
+	{
+	private:
+		static constexpr size_t MIN_CAPACITY = 16u;
+		static constexpr size_t GROWTH_FACTOR = 2u;
+		static constexpr float LOAD_FACTOR = 0.875f;
+		static constexpr uint8_t BIT_OCCUPIED = 0b10000000;
+		static constexpr uint8_t EMPTY = 0u;
+		static constexpr uint8_t TOMBSTONE = 0b01111111; // Neither occupied nor empty, probes go on past it
+
+		using Group = detail::Control_Word;
+
+		struct Node
+		{
+			size_t hash;
+			Key key;
+			Value value;
+		};
+
+		struct Table
+		{
+			size_t capacity;
+			std::unique_ptr<std::atomic<uint64_t>[]> control_words; // capacity / WIDTH words, all EMPTY
+			std::unique_ptr<std::atomic<Node*>[]> nodes;
+			bool owns_nodes{false}; // Set on a table that is retired with its nodes, by clear()
+
+			explicit Table(size_t capacity):
+				capacity{capacity},
+				control_words{new std::atomic<uint64_t>[capacity / Group::WIDTH]},
+				nodes{new std::atomic<Node*>[capacity]}
+			{
+				for (size_t i = 0u; i < capacity / Group::WIDTH; ++i)
+				{
+					control_words[i].store(0u, std::memory_order_relaxed);
+				}
+
+				for (size_t i = 0u; i < capacity; ++i)
+				{
+					nodes[i].store(nullptr, std::memory_order_relaxed);
+				}
+			}
+
+			~Table()
+			{
+				if (owns_nodes)
+				{
+					for (size_t i = 0u; i < capacity; ++i)
+					{
+						delete nodes[i].load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			uint8_t control_byte(size_t index) const
+			{
+				uint64_t word = control_words[index / Group::WIDTH].load(std::memory_order_relaxed);
+
+				return static_cast<uint8_t>(word >> (index % Group::WIDTH * 8u));
+			}
+
+			// Only the writer changes control bytes, so a plain read-modify-write of the word is enough
+			void set_control_byte(size_t index, uint8_t control_byte)
+			{
+				std::atomic<uint64_t>& word = control_words[index / Group::WIDTH];
+				size_t shift = index % Group::WIDTH * 8u;
+
+				uint64_t updated = word.load(std::memory_order_relaxed) & ~(uint64_t{0xFFu} << shift);
+				word.store(updated | (uint64_t{control_byte} << shift), std::memory_order_release);
+			}
+		};
+
+		static_assert(MIN_CAPACITY % Group::WIDTH == 0u, "The table must be made of whole groups");
+
+		Eq equalizer;
+		Hash hasher;
+		std::atomic<Table*> table{nullptr};
+		std::mutex writer_mutex;
+		std::atomic<size_t> filled_buckets{0u};
+		size_t tombstones{0u}; // Writer only
+
+	private:
+		static uint8_t make_control_byte(size_t hash)
+		{
+			static_assert(sizeof(size_t) == 8, "The logic is built upon the assumption that size_t is 8 bytes");
+
+			uint8_t fingerprint = static_cast<uint8_t>(hash >> 57);
+
+			return fingerprint | BIT_OCCUPIED;
+		}
+
+		struct Probe_Result
+		{
+			size_t index; // Slot of the key when found, otherwise the first tombstone or the empty slot on the way
+			Node* node; // Null when not found
+		};
+
+		// Safe for readers and the writer alike: a control byte that matches only tells where to look, the
+		// node pointer read after it decides. Bounded by the table size, there is always an empty slot
+		template<typename K>
+		Probe_Result probe(const Table& current, const K& key, size_t hash) const
+		{
+			size_t mask = current.capacity - 1u;
+			size_t home = hash & mask;
+			size_t group_index = home & ~(Group::WIDTH - 1u);
+			uint8_t control_byte = make_control_byte(hash);
+			uint64_t window = Group::bits_from(home - group_index);
+			size_t free_index = current.capacity;
+
+			while (true)
+			{
+				uint64_t word = current.control_words[group_index / Group::WIDTH].load(std::memory_order_acquire);
+
+				uint64_t empties = Group::match(word, EMPTY) & window;
+				uint64_t before_empty = detail::bits_before_first(empties);
+				uint64_t matches = Group::match(word, control_byte) & window & before_empty;
+
+				while (matches != 0u)
+				{
+					size_t index = group_index + Group::index_of(matches);
+					Node* node = current.nodes[index].load(std::memory_order_acquire);
+
+					if (node != nullptr && node->hash == hash && equalizer(key, node->key))
+					{
+						return Probe_Result{index, node};
+					}
+
+					matches = clear_lowest_bit(matches);
+				}
+
+				if (free_index == current.capacity)
+				{
+					uint64_t free = Group::match(word, TOMBSTONE) & window & before_empty;
+
+					if (free != 0u)
+					{
+						free_index = group_index + Group::index_of(free);
+					}
+				}
+
+				if (empties != 0u)
+				{
+					if (free_index == current.capacity)
+					{
+						free_index = group_index + Group::index_of(empties);
+					}
+
+					return Probe_Result{free_index, nullptr};
+				}
+
+				group_index = (group_index + Group::WIDTH) & mask;
+				window = ~uint64_t{0u};
+			}
+		}
+
+		template<typename K>
+		const Node* find_node(const K& key) const
+		{
+			const Table* current = table.load(std::memory_order_acquire);
+
+			if (current == nullptr)
+			{
+				return nullptr;
+			}
+
+			return probe(*current, key, hasher(key)).node;
+		}
+
+		static size_t capacity_for(size_t count)
+		{
+			size_t capacity = MIN_CAPACITY;
+
+			while (static_cast<size_t>(LOAD_FACTOR * capacity) < count)
+			{
+				capacity *= GROWTH_FACTOR;
+			}
+
+			return capacity;
+		}
+
+		static size_t find_empty(const Table& target, size_t hash)
+		{
+			size_t mask = target.capacity - 1u;
+			size_t index = hash & mask;
+
+			while (target.control_byte(index) != EMPTY)
+			{
+				index = (index + 1u) & mask;
+			}
+
+			return index;
+		}
+
+		static void delete_table(void* pointer)
+		{
+			delete static_cast<Table*>(pointer);
+		}
+
+		void retire_table(Table* old_table)
+		{
+			size_t bytes = sizeof(Table) + old_table->capacity * (sizeof(std::atomic<Node*>) + 1u);
+
+			if (old_table->owns_nodes)
+			{
+				bytes += filled_buckets.load(std::memory_order_relaxed) * sizeof(Node);
+			}
+
+			Epoch_Domain::get().retire(old_table, &delete_table, bytes);
+		}
+
+		// Copies the node pointers into a fresh table of "new_size" slots, which drops the tombstones, and
+		// publishes it. Readers still probing the old table finish there, it's retired without its nodes
+		void rehash(size_t new_size)
+		{
+			Table* old_table = table.load(std::memory_order_relaxed);
+			Table* new_table = new Table{new_size};
+
+			if (old_table != nullptr)
+			{
+				for (size_t i = 0u; i < old_table->capacity; ++i)
+				{
+					Node* node = old_table->nodes[i].load(std::memory_order_relaxed);
+
+					if (node != nullptr)
+					{
+						size_t index = find_empty(*new_table, node->hash);
+
+						new_table->nodes[index].store(node, std::memory_order_relaxed);
+						new_table->set_control_byte(index, make_control_byte(node->hash));
+					}
+				}
+			}
+
+			table.store(new_table, std::memory_order_release);
+			tombstones = 0u;
+
+			if (old_table != nullptr)
+			{
+				retire_table(old_table);
+			}
+		}
+
+		// Writer only. Makes room for one more element, tombstones count as used since they lengthen probes
+		Table& table_for_insert()
+		{
+			Table* current = table.load(std::memory_order_relaxed);
+			size_t count = filled_buckets.load(std::memory_order_relaxed);
+
+			if (current == nullptr || count + tombstones >= static_cast<size_t>(LOAD_FACTOR * current->capacity))
+			{
+				// Grows when the elements need it, otherwise only sweeps the tombstones away
+				size_t new_size = capacity_for(count + 1u);
+
+				rehash(current != nullptr && current->capacity > new_size ? current->capacity : new_size);
+				current = table.load(std::memory_order_relaxed);
+			}
+
+			return *current;
+		}
+
+		// Writer only, "key" is known to be missing and "index" is where the probe said it goes
+		void publish(Table& current, size_t index, Node* node)
+		{
+			if (current.control_byte(index) == TOMBSTONE)
+			{
+				tombstones--;
+			}
+
+			current.nodes[index].store(node, std::memory_order_release);
+			current.set_control_byte(index, make_control_byte(node->hash));
+
+			filled_buckets.fetch_add(1u, std::memory_order_relaxed);
+		}
+
+	public:
+		Read_Mostly_Hash_Map() = default;
+
+		explicit Read_Mostly_Hash_Map(size_t capacity_hint)
+		{
+			reserve(capacity_hint);
+		}
+
+		Read_Mostly_Hash_Map(const Read_Mostly_Hash_Map&) = delete;
+		Read_Mostly_Hash_Map& operator=(const Read_Mostly_Hash_Map&) = delete;
+
+		// No reader or writer may still be using the map
+		~Read_Mostly_Hash_Map()
+		{
+			Table* current = table.load(std::memory_order_relaxed);
+
+			if (current != nullptr)
+			{
+				current->owns_nodes = true;
+				delete current;
+			}
+		}
+
+	public: // Readers, wait-free
+		// Copies the value of "key" into "out", returns false (and leaves "out" alone) when it's missing
+		template<typename K>
+		bool get(const K& key, Value& out) const
+		{
+			return visit(key, [&out](const Value& value) { out = value; });
+		}
+
+		template<typename K>
+		bool contains(const K& key) const
+		{
+			static_assert(std::is_same_v<K, Key> || Transparent_Hash<Hash, Eq>, "Keys of another type need a transparent Hash and Eq");
+
+			Epoch_Domain::Guard guard;
+
+			return find_node(key) != nullptr;
+		}
+
+		// Calls fn(value) while the value is guaranteed to stay alive, returns false when "key" is missing
+		// "fn" may read other maps, a writer may replace or remove the element meanwhile (fn keeps the old one)
+		template<typename K, typename F>
+		bool visit(const K& key, F&& fn) const
+		{
+			static_assert(std::is_same_v<K, Key> || Transparent_Hash<Hash, Eq>, "Keys of another type need a transparent Hash and Eq");
+
+			Epoch_Domain::Guard guard;
+
+			const Node* node = find_node(key);
+
+			if (node == nullptr)
+			{
+				return false;
+			}
+
+			fn(static_cast<const Value&>(node->value));
+
+			return true;
+		}
+
+		// Exact while there is no writer, otherwise a recent value
+		size_t count() const
+		{
+			return filled_buckets.load(std::memory_order_relaxed);
+		}
+
+	public: // Writers, serialized by a mutex
+		// Inserts or overwrites, returns true when "key" was new
+		template<typename K, typename V>
+		bool insert(K&& key, V&& value)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return insert(Key(std::forward<K>(key)), std::forward<V>(value));
+			}
+			else
+			{
+				size_t hash = hasher(key);
+
+				std::lock_guard lock{writer_mutex};
+
+				Table& current = table_for_insert();
+				auto [index, existing] = probe(current, key, hash);
+
+				Node* node = new Node{hash, Key(std::forward<K>(key)), Value(std::forward<V>(value))};
+
+				if (existing != nullptr)
+				{
+					current.nodes[index].store(node, std::memory_order_release);
+					Epoch_Domain::get().retire(existing);
+
+					return false;
+				}
+
+				publish(current, index, node);
+
+				return true;
+			}
+		}
+
+		// Builds the value from "args" only when "key" is missing, returns true when it did
+		template<typename K, typename... Args>
+		bool try_emplace(K&& key, Args&&... args)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return try_emplace(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+			}
+			else
+			{
+				size_t hash = hasher(key);
+
+				std::lock_guard lock{writer_mutex};
+
+				Table& current = table_for_insert();
+				auto [index, existing] = probe(current, key, hash);
+
+				if (existing != nullptr)
+				{
+					return false;
+				}
+
+				publish(current, index, new Node{hash, Key(std::forward<K>(key)), Value(std::forward<Args>(args)...)});
+
+				return true;
+			}
+		}
+
+		template<typename K>
+		bool remove(const K& key)
+		{
+			static_assert(std::is_same_v<K, Key> || Transparent_Hash<Hash, Eq>, "Keys of another type need a transparent Hash and Eq");
+
+			size_t hash = hasher(key);
+
+			std::lock_guard lock{writer_mutex};
+
+			Table* current = table.load(std::memory_order_relaxed);
+
+			if (current == nullptr)
+			{
+				return false;
+			}
+
+			auto [index, existing] = probe(*current, key, hash);
+
+			if (existing == nullptr)
+			{
+				return false;
+			}
+
+			// The tombstone first: a probe that still sees the old byte finds a null node and moves on
+			current->set_control_byte(index, TOMBSTONE);
+			current->nodes[index].store(nullptr, std::memory_order_release);
+
+			filled_buckets.fetch_sub(1u, std::memory_order_relaxed);
+			tombstones++;
+
+			Epoch_Domain::get().retire(existing);
+
+			return true;
+		}
+
+		// Makes room for "count" elements in total
+		void reserve(size_t count)
+		{
+			std::lock_guard lock{writer_mutex};
+
+			Table* current = table.load(std::memory_order_relaxed);
+			size_t new_size = capacity_for(count);
+
+			if (current == nullptr || new_size > current->capacity)
+			{
+				rehash(new_size);
+			}
+		}
+
+		// Readers in flight finish on the old table, which is retired along with its nodes
+		void clear()
+		{
+			std::lock_guard lock{writer_mutex};
+
+			Table* old_table = table.exchange(nullptr, std::memory_order_acq_rel);
+
+			if (old_table != nullptr)
+			{
+				old_table->owns_nodes = true;
+				retire_table(old_table);
+			}
+
+			filled_buckets.store(0u, std::memory_order_relaxed);
+			tombstones = 0u;
+		}
+	};
+};
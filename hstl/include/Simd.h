@@ -0,0 +1,98 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+// The instruction set is picked at compile time, build with HSTL_ENABLE_AVX2 (or -mavx2 / /arch:AVX2)
+// to get the 256-bit kernels, every x64 target has at least SSE2
+#if defined(__AVX2__)
+	#define HSTL_SIMD_AVX2 1
+	#define HSTL_SIMD_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define HSTL_SIMD_SSE2 1
+#endif
+
+#if defined(HSTL_SIMD_AVX2)
+	#include <immintrin.h>
+#elif defined(HSTL_SIMD_SSE2)
+	#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+	#define HSTL_FORCE_INLINE __forceinline
+#else
+	#define HSTL_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace hstl
+{
+	// Index of the lowest set bit, "mask" must not be zero
+	template<typename T>
+	HSTL_FORCE_INLINE uint32_t lowest_bit_index(T mask)
+	{
+		return static_cast<uint32_t>(std::countr_zero(mask));
+	}
+
+	template<typename T>
+	HSTL_FORCE_INLINE uint32_t bit_count(T mask)
+	{
+		return static_cast<uint32_t>(std::popcount(mask));
+	}
+
+	template<typename T>
+	HSTL_FORCE_INLINE T clear_lowest_bit(T mask)
+	{
+		return mask & (mask - 1u);
+	}
+
+	// Hint to start loading the cache line of "address", a no-op where the compiler has no intrinsic
+	HSTL_FORCE_INLINE void prefetch(const void* address)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address);
+#elif defined(HSTL_SIMD_SSE2)
+		_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+		(void)address;
+#endif
+	}
+
+#if defined(HSTL_SIMD_AVX2)
+	namespace detail
+	{
+		// For every 8-bit mask, the byte indices of its set bits packed to the front
+		struct Compress_Table
+		{
+			uint64_t lanes[256]{};
+
+			constexpr Compress_Table()
+			{
+				for (uint32_t mask = 0u; mask < 256u; ++mask)
+				{
+					uint32_t packed = 0u;
+
+					for (uint32_t lane = 0u; lane < 8u; ++lane)
+					{
+						if (mask & (1u << lane))
+						{
+							lanes[mask] |= static_cast<uint64_t>(lane) << (packed * 8u);
+							++packed;
+						}
+					}
+				}
+			}
+		};
+
+		inline constexpr Compress_Table COMPRESS_TABLE{};
+	}
+
+	// Moves the 32-bit lanes selected by "keep_mask" to the front of the vector, the rest is garbage
+	HSTL_FORCE_INLINE __m256i compress_32x8(__m256i vector, uint32_t keep_mask)
+	{
+		__m256i indices = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<int64_t>(detail::COMPRESS_TABLE.lanes[keep_mask])));
+
+		return _mm256_permutevar8x32_epi32(vector, indices);
+	}
+#endif
+};
@@ -0,0 +1,454 @@
+#pragma once
+
+#include "Hash_Map.h"
+#include "Algorithms.h"
+
+#include <functional>
+#include <utility>
+#include <new>
+#include <memory>
+#include <type_traits>
+#include <cstddef>
+
+namespace hstl
+{
+	// Hash map for the many maps that hold a handful of elements (per-entity property bags, per-material
+	// parameters): up to N elements live inline in packed arrays and a lookup is a SIMD compare over all of
+	// them. Integer keys are compared directly, without hashing anything. Other keys (strings) keep their
+	// hash next to them, a lookup compares the hashes and then only the key whose hash matched
+	// The N + 1th element moves everything into a Hash_Map, which the map then keeps until it's destroyed,
+	// even if it shrinks again (so that a map hovering around N doesn't move its elements back and forth)
+	// The small mode keeps no particular order, a remove moves the last element into the hole
+	// NOTE: the elements move when the map spills into the Hash_Map, and inline ones when the map itself
+	// moves, pointers to values are invalidated by inserts and removes like with Hash_Map
+	template<typename Key, typename Value, size_t N = 16u, typename Hash = hstl::Hash<Key>, typename Eq = Equal_To<Key>>
+	class Small_Hash_Map
+	{
+	private:
+		static_assert(N > 0u, "A Small_Hash_Map needs room for at least one inline element");
+
+		using Large_Map = Hash_Map<Key, Value, Hash, Eq>;
+
+		// Integer keys compared with the default Eq are found with hstl::find, a few vector compares for
+		// the whole inline array. Any other key is found through its stored hash
+		static constexpr bool SIMD_KEYS = std::is_integral_v<Key> && std::is_same_v<Eq, Equal_To<Key>> && detail::Simd_Ops_For<Key>::HAS_EQ;
+
+		struct No_Small_Hashes
+		{
+		};
+
+		using Small_Hashes = std::conditional_t<SIMD_KEYS, No_Small_Hashes, size_t[N]>;
+
+		Eq equalizer;
+		Hash hasher;
+		size_t small_count{0u};
+		bool spilled{false}; // Everything is in "large" from then on
+		[[no_unique_address]] Small_Hashes small_hashes; // hasher(key) of the inline elements, unless SIMD_KEYS
+		alignas(Key) unsigned char key_storage[N * sizeof(Key)];
+		alignas(Value) unsigned char value_storage[N * sizeof(Value)];
+		Large_Map large;
+
+	private:
+		Key* small_keys()
+		{
+			return std::launder(reinterpret_cast<Key*>(key_storage));
+		}
+
+		const Key* small_keys() const
+		{
+			return std::launder(reinterpret_cast<const Key*>(key_storage));
+		}
+
+		Value* small_values()
+		{
+			return std::launder(reinterpret_cast<Value*>(value_storage));
+		}
+
+		const Value* small_values() const
+		{
+			return std::launder(reinterpret_cast<const Value*>(value_storage));
+		}
+
+		// Index of "key" among the inline elements, or "small_count". "hash" is hasher(key), unused with SIMD_KEYS
+		template<typename K>
+		size_t find_small(const K& key, size_t hash) const
+		{
+			if constexpr (SIMD_KEYS)
+			{
+				return static_cast<size_t>(hstl::find(small_keys(), small_count, key) - small_keys());
+			}
+			else
+			{
+				const Key* keys = small_keys();
+
+				for (size_t i = 0u; i < small_count; ++i)
+				{
+					i = static_cast<size_t>(hstl::find(small_hashes + i, small_count - i, hash) - small_hashes);
+
+					if (i < small_count && equalizer(key, keys[i]))
+					{
+						return i;
+					}
+				}
+
+				return small_count;
+			}
+		}
+
+		template<typename K>
+		size_t small_hash(const K& key) const
+		{
+			if constexpr (SIMD_KEYS)
+			{
+				return 0u;
+			}
+			else
+			{
+				return hasher(key);
+			}
+		}
+
+		template<typename K>
+		const Value* find_value(const K& key) const
+		{
+			if (spilled)
+			{
+				return large.get(key);
+			}
+
+			size_t index = find_small(key, small_hash(key));
+
+			return index < small_count ? &small_values()[index] : nullptr;
+		}
+
+		void destroy_small()
+		{
+			std::destroy_n(small_keys(), small_count);
+			std::destroy_n(small_values(), small_count);
+
+			small_count = 0u;
+		}
+
+		// Moves the inline elements into the Hash_Map, sized for twice as many
+		void spill()
+		{
+			large.reserve(N * 2u);
+
+			Key* keys = small_keys();
+			Value* values = small_values();
+
+			for (size_t i = 0u; i < small_count; ++i)
+			{
+				if constexpr (SIMD_KEYS)
+				{
+					large.insert(std::move(keys[i]), std::move(values[i]));
+				}
+				else
+				{
+					large.insert_hashed(std::move(keys[i]), std::move(values[i]), small_hashes[i]);
+				}
+			}
+
+			destroy_small();
+
+			spilled = true;
+		}
+
+		// Takes the elements of "other", this map must be empty and small
+		template<typename Other>
+		void take_elements(Other&& other)
+		{
+			spilled = other.spilled;
+			large = std::forward<Other>(other).large;
+
+			for (size_t i = 0u; i < other.small_count; ++i)
+			{
+				if constexpr (SIMD_KEYS == false)
+				{
+					small_hashes[i] = other.small_hashes[i];
+				}
+
+				if constexpr (std::is_rvalue_reference_v<Other&&>)
+				{
+					new (&small_keys()[i]) Key(std::move(other.small_keys()[i]));
+					new (&small_values()[i]) Value(std::move(other.small_values()[i]));
+				}
+				else
+				{
+					new (&small_keys()[i]) Key(other.small_keys()[i]);
+					new (&small_values()[i]) Value(other.small_values()[i]);
+				}
+			}
+
+			small_count = other.small_count;
+		}
+
+	public:
+		Small_Hash_Map() = default;
+
+		Small_Hash_Map(const Small_Hash_Map& other):
+			equalizer{other.equalizer},
+			hasher{other.hasher}
+		{
+			take_elements(other);
+		}
+
+		Small_Hash_Map(Small_Hash_Map&& other):
+			equalizer{std::move(other.equalizer)},
+			hasher{std::move(other.hasher)}
+		{
+			take_elements(std::move(other));
+			other.destroy_small();
+		}
+
+		Small_Hash_Map& operator=(const Small_Hash_Map& other)
+		{
+			if (this != &other)
+			{
+				destroy_small();
+
+				equalizer = other.equalizer;
+				hasher = other.hasher;
+				take_elements(other);
+			}
+
+			return *this;
+		}
+
+		Small_Hash_Map& operator=(Small_Hash_Map&& other)
+		{
+			if (this != &other)
+			{
+				destroy_small();
+
+				equalizer = std::move(other.equalizer);
+				hasher = std::move(other.hasher);
+				take_elements(std::move(other));
+				other.destroy_small();
+			}
+
+			return *this;
+		}
+
+		~Small_Hash_Map()
+		{
+			destroy_small();
+		}
+
+	public:
+		using Insert_Result = typename Large_Map::Insert_Result;
+
+		// Inserts or overwrites, like Hash_Map::insert
+		template<typename K, typename V>
+		Value& insert(K&& key, V&& value)
+		{
+			auto [stored, inserted] = try_emplace(std::forward<K>(key), std::forward<V>(value));
+
+			if (inserted == false)
+			{
+				stored = std::forward<V>(value);
+			}
+
+			return stored;
+		}
+
+		// Builds the value from "args" only when "key" is missing, like Hash_Map::try_emplace
+		template<typename K, typename... Args>
+		Insert_Result try_emplace(K&& key, Args&&... args)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return try_emplace(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+			}
+			else
+			{
+				if (spilled)
+				{
+					return large.try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+				}
+
+				size_t hash = small_hash(key);
+				size_t index = find_small(key, hash);
+
+				if (index < small_count)
+				{
+					return Insert_Result{small_values()[index], false};
+				}
+
+				if (small_count < N)
+				{
+					if constexpr (SIMD_KEYS == false)
+					{
+						small_hashes[small_count] = hash;
+					}
+
+					new (&small_keys()[small_count]) Key(std::forward<K>(key));
+					new (&small_values()[small_count]) Value(std::forward<Args>(args)...);
+
+					return Insert_Result{small_values()[small_count++], true};
+				}
+
+				spill();
+
+				if constexpr (SIMD_KEYS)
+				{
+					return large.try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+				}
+				else
+				{
+					return large.try_emplace_hashed(std::forward<K>(key), hash, std::forward<Args>(args)...);
+				}
+			}
+		}
+
+		template<typename K>
+		Insert_Result get_or_insert_default(K&& key)
+		{
+			return try_emplace(std::forward<K>(key));
+		}
+
+		const Value* get(const Key& key) const
+		{
+			return find_value(key);
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		const Value* get(const K& key) const
+		{
+			return find_value(key);
+		}
+
+		Value* get(const Key& key)
+		{
+			return const_cast<Value*>(find_value(key));
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		Value* get(const K& key)
+		{
+			return const_cast<Value*>(find_value(key));
+		}
+
+		bool contains(const Key& key) const
+		{
+			return find_value(key) != nullptr;
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool contains(const K& key) const
+		{
+			return find_value(key) != nullptr;
+		}
+
+		bool remove(const Key& key)
+		{
+			return remove_key(key);
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool remove(const K& key)
+		{
+			return remove_key(key);
+		}
+
+		// Makes room for "count" elements in total, more than N spills right away
+		void reserve(size_t count)
+		{
+			if (count <= N && spilled == false)
+			{
+				return;
+			}
+
+			if (spilled == false)
+			{
+				spill();
+			}
+
+			large.reserve(count);
+		}
+
+		// Keeps the Hash_Map of a map that spilled, see Hash_Map::clear
+		void clear()
+		{
+			destroy_small();
+			large.clear();
+		}
+
+		size_t count() const { return spilled ? large.count() : small_count; }
+
+		// True while the elements are inline
+		bool is_small() const { return spilled == false; }
+
+		// Calls fn(key, value) for every element, with a mutable value on a non-const map
+		// NOTE: must not insert into or remove from the map
+		template<typename F>
+		void for_each(F&& fn)
+		{
+			if (spilled)
+			{
+				large.for_each(std::forward<F>(fn));
+
+				return;
+			}
+
+			for (size_t i = 0u; i < small_count; ++i)
+			{
+				fn(static_cast<const Key&>(small_keys()[i]), small_values()[i]);
+			}
+		}
+
+		template<typename F>
+		void for_each(F&& fn) const
+		{
+			if (spilled)
+			{
+				large.for_each(std::forward<F>(fn));
+
+				return;
+			}
+
+			for (size_t i = 0u; i < small_count; ++i)
+			{
+				fn(small_keys()[i], small_values()[i]);
+			}
+		}
+
+	private:
+		template<typename K>
+		bool remove_key(const K& key)
+		{
+			if (spilled)
+			{
+				return large.remove(key);
+			}
+
+			size_t index = find_small(key, small_hash(key));
+
+			if (index == small_count)
+			{
+				return false;
+			}
+
+			Key* keys = small_keys();
+			Value* values = small_values();
+			size_t last = small_count - 1u;
+
+			if (index != last)
+			{
+				keys[index] = std::move(keys[last]);
+				values[index] = std::move(values[last]);
+
+				if constexpr (SIMD_KEYS == false)
+				{
+					small_hashes[index] = small_hashes[last];
+				}
+			}
+
+			std::destroy_at(&keys[last]);
+			std::destroy_at(&values[last]);
+			small_count--;
+
+			return true;
+		}
+	};
+};
@@ -0,0 +1,920 @@
+#pragma once
+
+#include "Array.h"
+#include "Hash_Group.h"
+#include "Hash.h"
+#include "Hash_Stats.h"
+#include "Simd.h"
+
+#include <functional>
+#include <utility>
+#include <type_traits>
+#include <new>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace hstl
+{
+	// Hash map for very large tables where the bytes matter more than the last nanosecond (spatial or
+	// telemetry indices with tens of millions of entries), in the style of sparsepp. The table is cut into
+	// groups of 64 slots: a group keeps a 64-bit occupancy bitmap and only its elements, packed in slot order
+	// in a small array, the element of slot i is at popcount(bitmap & bits below i). An empty slot costs
+	// 3 bits (occupancy, tombstone and a share of the array pointer) instead of a whole slot, so the table
+	// can stay at a load factor of at most 0.5 and still take about sizeof(Key) + sizeof(Value) + 2 bytes
+	// per element
+	// Linear probing over the bitmaps, every occupied slot on the way is a key compare (there are no
+	// fingerprints), removes leave a tombstone unless the slot ends a probe run
+	// The price is a second dependent load per lookup (bitmap, then element) and inserts and removes that
+	// move the elements of their group around
+	// NOTE: any insert or remove can move the elements of a group, pointers to values are invalidated by
+	// inserts and removes
+	template<typename Key, typename Value, typename Hash = hstl::Hash<Key>, typename Eq = Equal_To<Key>>
+	class Sparse_Hash_Map
+	{
+	public:
+		struct Slot
+		{
+			Key key;
+			Value value;
+		};
+
+	private:
+		static constexpr size_t GROUP_SLOTS = 64u;
+		static constexpr size_t MIN_CAPACITY = GROUP_SLOTS;
+		static constexpr size_t GROWTH_FACTOR = 2u;
+		static constexpr float LOAD_FACTOR = 0.5f; // Elements and tombstones
+
+		// Group arrays grow and shrink by this many elements, a reallocation every few inserts for a little slack
+		static constexpr size_t ALLOCATION_STEP = 4u;
+
+		static constexpr bool TRIVIALLY_RELOCATABLE = std::is_trivially_copyable_v<Slot>;
+
+		struct Group
+		{
+			uint64_t occupied{0u};
+			uint64_t deleted{0u}; // Tombstones, probes go on past them
+			Slot* slots{nullptr}; // One per occupied bit, in slot order, room for allocation_size(count())
+
+			uint32_t count() const
+			{
+				return bit_count(occupied);
+			}
+
+			// Position in "slots" of the element of slot "bit"
+			uint32_t position(uint32_t bit) const
+			{
+				return bit_count(occupied & ((uint64_t{1u} << bit) - 1u));
+			}
+		};
+
+		Eq equalizer;
+		Hash hasher;
+		size_t element_count{0u};
+		size_t tombstones{0u};
+		Array<Group> groups;
+		size_t rehashes{0u};
+
+	private:
+		static size_t allocation_size(size_t count)
+		{
+			return (count + ALLOCATION_STEP - 1u) / ALLOCATION_STEP * ALLOCATION_STEP;
+		}
+
+		static Slot* allocate(size_t count)
+		{
+			return static_cast<Slot*>(::operator new(count * sizeof(Slot)));
+		}
+
+		// Moves "count" elements to "to" and ends their lifetime at "from", the ranges don't overlap or "to" is below "from"
+		static void relocate(Slot* from, size_t count, Slot* to)
+		{
+			if constexpr (TRIVIALLY_RELOCATABLE)
+			{
+				if (count > 0u)
+				{
+					memmove(static_cast<void*>(to), from, count * sizeof(Slot));
+				}
+			}
+			else
+			{
+				for (size_t i = 0u; i < count; ++i)
+				{
+					new (&to[i]) Slot(std::move(from[i]));
+					std::destroy_at(&from[i]);
+				}
+			}
+		}
+
+		// Moves "count" elements one slot up, to make room at "slots"
+		static void relocate_up(Slot* slots, size_t count)
+		{
+			if constexpr (TRIVIALLY_RELOCATABLE)
+			{
+				if (count > 0u)
+				{
+					memmove(static_cast<void*>(slots + 1u), slots, count * sizeof(Slot));
+				}
+			}
+			else
+			{
+				for (size_t i = count; i > 0u; --i)
+				{
+					new (&slots[i]) Slot(std::move(slots[i - 1u]));
+					std::destroy_at(&slots[i - 1u]);
+				}
+			}
+		}
+
+		size_t capacity_mask() const
+		{
+			return groups.size() * GROUP_SLOTS - 1u;
+		}
+
+		Slot& slot_at(size_t index) const
+		{
+			const Group& group = groups[index / GROUP_SLOTS];
+
+			return group.slots[group.position(static_cast<uint32_t>(index % GROUP_SLOTS))];
+		}
+
+		struct Probe_Result
+		{
+			size_t index; // Slot of the key when found, otherwise where it would go (the first tombstone or empty slot)
+			bool found;
+		};
+
+		// Linear probing a group at a time: the occupied slots before the first empty one are compared, the
+		// probe moves to the next group only when this one has no empty slot left past the start
+		template<typename K>
+		Probe_Result probe(const K& key, size_t hash) const
+		{
+			size_t mask = capacity_mask();
+			size_t index = hash & mask;
+			size_t free_index = SIZE_MAX;
+
+			while (true)
+			{
+				size_t group_start = index & ~(GROUP_SLOTS - 1u);
+				const Group& group = groups[group_start / GROUP_SLOTS];
+				uint64_t from = ~uint64_t{0u} << (index - group_start);
+				uint64_t empties = ~(group.occupied | group.deleted) & from;
+				uint64_t before_empty = detail::bits_before_first(empties);
+				uint64_t candidates = group.occupied & from & before_empty;
+
+				if (candidates != 0u)
+				{
+					// Every occupied slot from the first candidate on is a candidate, their elements are consecutive
+					const Slot* slot = group.slots + group.position(lowest_bit_index(candidates));
+
+					do
+					{
+						if (equalizer(key, slot->key))
+						{
+							return Probe_Result{group_start + lowest_bit_index(candidates), true};
+						}
+
+						candidates = clear_lowest_bit(candidates);
+						++slot;
+					}
+					while (candidates != 0u);
+				}
+
+				uint64_t reusable = group.deleted & from & before_empty;
+
+				if (free_index == SIZE_MAX && reusable != 0u)
+				{
+					free_index = group_start + lowest_bit_index(reusable);
+				}
+
+				if (empties != 0u)
+				{
+					return Probe_Result{free_index != SIZE_MAX ? free_index : group_start + lowest_bit_index(empties), false};
+				}
+
+				index = (group_start + GROUP_SLOTS) & mask;
+			}
+		}
+
+		// First slot that is neither occupied nor a tombstone, for keys known to be missing
+		size_t find_empty(size_t hash) const
+		{
+			size_t mask = capacity_mask();
+			size_t index = hash & mask;
+
+			while (true)
+			{
+				size_t group_start = index & ~(GROUP_SLOTS - 1u);
+				const Group& group = groups[group_start / GROUP_SLOTS];
+				uint64_t empties = ~(group.occupied | group.deleted) & (~uint64_t{0u} << (index - group_start));
+
+				if (empties != 0u)
+				{
+					return group_start + lowest_bit_index(empties);
+				}
+
+				index = (group_start + GROUP_SLOTS) & mask;
+			}
+		}
+
+		bool is_empty_slot(size_t index) const
+		{
+			const Group& group = groups[index / GROUP_SLOTS];
+			uint64_t bit = uint64_t{1u} << (index % GROUP_SLOTS);
+
+			return ((group.occupied | group.deleted) & bit) == 0u;
+		}
+
+		// Makes room for an element at slot "index" (empty or a tombstone) and marks it occupied, the
+		// caller constructs the element at the returned address
+		Slot* open_slot(size_t index)
+		{
+			Group& group = groups[index / GROUP_SLOTS];
+			uint32_t bit = static_cast<uint32_t>(index % GROUP_SLOTS);
+			uint32_t count = group.count();
+			uint32_t position = group.position(bit);
+
+			if (allocation_size(count + 1u) != allocation_size(count))
+			{
+				Slot* grown = allocate(allocation_size(count + 1u));
+
+				relocate(group.slots, position, grown);
+				relocate(group.slots + position, count - position, grown + position + 1u);
+				::operator delete(group.slots);
+
+				group.slots = grown;
+			}
+			else
+			{
+				relocate_up(group.slots + position, count - position);
+			}
+
+			if ((group.deleted >> bit) & 1u)
+			{
+				group.deleted &= ~(uint64_t{1u} << bit);
+				tombstones--;
+			}
+
+			group.occupied |= uint64_t{1u} << bit;
+			element_count++;
+
+			return &group.slots[position];
+		}
+
+		void erase_at(size_t index)
+		{
+			Group& group = groups[index / GROUP_SLOTS];
+			uint32_t bit = static_cast<uint32_t>(index % GROUP_SLOTS);
+			uint32_t count = group.count();
+			uint32_t position = group.position(bit);
+
+			std::destroy_at(&group.slots[position]);
+
+			if (count == 1u)
+			{
+				::operator delete(group.slots);
+				group.slots = nullptr;
+			}
+			else if (allocation_size(count - 1u) != allocation_size(count))
+			{
+				Slot* shrunk = allocate(allocation_size(count - 1u));
+
+				relocate(group.slots, position, shrunk);
+				relocate(group.slots + position + 1u, count - position - 1u, shrunk + position);
+				::operator delete(group.slots);
+
+				group.slots = shrunk;
+			}
+			else
+			{
+				relocate(group.slots + position + 1u, count - position - 1u, group.slots + position);
+			}
+
+			group.occupied &= ~(uint64_t{1u} << bit);
+			element_count--;
+
+			size_t mask = capacity_mask();
+
+			if (is_empty_slot((index + 1u) & mask) == false)
+			{
+				group.deleted |= uint64_t{1u} << bit;
+				tombstones++;
+
+				return;
+			}
+
+			// The slot ends a probe run, so do the tombstones right before it
+			for (size_t previous = (index - 1u) & mask; tombstones > 0u; previous = (previous - 1u) & mask)
+			{
+				Group& previous_group = groups[previous / GROUP_SLOTS];
+				uint64_t previous_bit = uint64_t{1u} << (previous % GROUP_SLOTS);
+
+				if ((previous_group.deleted & previous_bit) == 0u)
+				{
+					break;
+				}
+
+				previous_group.deleted &= ~previous_bit;
+				tombstones--;
+			}
+		}
+
+		static size_t capacity_for(size_t count)
+		{
+			size_t capacity = MIN_CAPACITY;
+
+			while (static_cast<size_t>(LOAD_FACTOR * capacity) < count)
+			{
+				capacity *= GROWTH_FACTOR;
+			}
+
+			return capacity;
+		}
+
+		void destroy_group(Group& group)
+		{
+			if constexpr (std::is_trivially_destructible_v<Slot> == false)
+			{
+				std::destroy_n(group.slots, group.count());
+			}
+
+			::operator delete(group.slots);
+			group = Group{};
+		}
+
+		void destroy_groups()
+		{
+			for (size_t g = 0u; g < groups.size(); ++g)
+			{
+				destroy_group(groups[g]);
+			}
+		}
+
+		// Group by group, each old group is freed as soon as its elements moved, so the peak is about one
+		// copy of the elements rather than two
+		void rehash(size_t new_capacity)
+		{
+			Array<Group> old_groups = std::move(groups);
+
+			groups = Array<Group>{new_capacity / GROUP_SLOTS};
+			element_count = 0u;
+			tombstones = 0u;
+
+			for (size_t g = 0u; g < old_groups.size(); ++g)
+			{
+				Group& old_group = old_groups[g];
+				uint32_t count = old_group.count();
+
+				for (uint32_t i = 0u; i < count; ++i)
+				{
+					Slot& slot = old_group.slots[i];
+					Slot* target = open_slot(find_empty(hasher(slot.key)));
+
+					new (target) Slot(std::move(slot));
+					std::destroy_at(&slot);
+				}
+
+				::operator delete(old_group.slots);
+			}
+
+			rehashes++;
+		}
+
+		void copy_groups(const Sparse_Hash_Map& other)
+		{
+			groups = Array<Group>{other.groups.size()};
+			element_count = other.element_count;
+			tombstones = other.tombstones;
+
+			for (size_t g = 0u; g < groups.size(); ++g)
+			{
+				const Group& source = other.groups[g];
+				Group& group = groups[g];
+				uint32_t count = source.count();
+
+				group.occupied = source.occupied;
+				group.deleted = source.deleted;
+
+				if (count > 0u)
+				{
+					group.slots = allocate(allocation_size(count));
+					std::uninitialized_copy_n(source.slots, count, group.slots);
+				}
+			}
+		}
+
+		template<typename K>
+		const Value* find_value(const K& key, size_t hash) const
+		{
+			if (element_count == 0u)
+			{
+				return nullptr;
+			}
+
+			auto [index, found] = probe(key, hash);
+
+			return found ? &slot_at(index).value : nullptr;
+		}
+
+		template<typename K>
+		bool remove_key(const K& key, size_t hash)
+		{
+			if (element_count == 0u)
+			{
+				return false;
+			}
+
+			auto [index, found] = probe(key, hash);
+
+			if (found == false)
+			{
+				return false;
+			}
+
+			erase_at(index);
+
+			return true;
+		}
+
+	public:
+		// Allocates nothing, the table is created by the first insert
+		Sparse_Hash_Map() = default;
+
+		// Sizes the table for "capacity_hint" elements up front
+		explicit Sparse_Hash_Map(size_t capacity_hint)
+		{
+			reserve(capacity_hint);
+		}
+
+		Sparse_Hash_Map(const Sparse_Hash_Map& other):
+			equalizer{other.equalizer},
+			hasher{other.hasher}
+		{
+			copy_groups(other);
+		}
+
+		Sparse_Hash_Map& operator=(const Sparse_Hash_Map& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			destroy_groups();
+
+			equalizer = other.equalizer;
+			hasher = other.hasher;
+
+			copy_groups(other);
+
+			return *this;
+		}
+
+		Sparse_Hash_Map(Sparse_Hash_Map&& other):
+			equalizer{std::move(other.equalizer)},
+			hasher{std::move(other.hasher)},
+			element_count{other.element_count},
+			tombstones{other.tombstones},
+			groups{std::move(other.groups)},
+			rehashes{other.rehashes}
+		{
+			other.element_count = 0u;
+			other.tombstones = 0u;
+		}
+
+		Sparse_Hash_Map& operator=(Sparse_Hash_Map&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			destroy_groups();
+
+			equalizer = std::move(other.equalizer);
+			hasher = std::move(other.hasher);
+			element_count = other.element_count;
+			tombstones = other.tombstones;
+			groups = std::move(other.groups);
+			rehashes = other.rehashes;
+
+			other.element_count = 0u;
+			other.tombstones = 0u;
+
+			return *this;
+		}
+
+		~Sparse_Hash_Map()
+		{
+			destroy_groups();
+		}
+
+	public:
+		struct Insert_Result
+		{
+			Value& value;
+			bool inserted; // False when the key was already there and "value" is the existing one
+		};
+
+		// Same contract as Hash_Map::insert
+		template<typename K, typename V>
+		Value& insert(K&& key, V&& value)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return insert(Key(std::forward<K>(key)), std::forward<V>(value));
+			}
+			else
+			{
+				auto hash = hasher(key);
+
+				return insert_hashed(std::forward<K>(key), std::forward<V>(value), hash);
+			}
+		}
+
+		// Same contract as Hash_Map::try_emplace
+		template<typename K, typename... Args>
+		Insert_Result try_emplace(K&& key, Args&&... args)
+		{
+			if constexpr (Transparent_Hash<Hash, Eq> == false && std::is_same_v<std::remove_cvref_t<K>, Key> == false)
+			{
+				return try_emplace(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+			}
+			else
+			{
+				auto hash = hasher(key);
+
+				return try_emplace_hashed(std::forward<K>(key), hash, std::forward<Args>(args)...);
+			}
+		}
+
+		template<typename K>
+		Insert_Result get_or_insert_default(K&& key)
+		{
+			return try_emplace(std::forward<K>(key));
+		}
+
+		const Value* get(const Key& key) const
+		{
+			return find_value(key, hasher(key));
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		const Value* get(const K& key) const
+		{
+			return find_value(key, hasher(key));
+		}
+
+		Value* get(const Key& key)
+		{
+			return const_cast<Value*>(find_value(key, hasher(key)));
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		Value* get(const K& key)
+		{
+			return const_cast<Value*>(find_value(key, hasher(key)));
+		}
+
+		bool contains(const Key& key) const
+		{
+			return find_value(key, hasher(key)) != nullptr;
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool contains(const K& key) const
+		{
+			return find_value(key, hasher(key)) != nullptr;
+		}
+
+		bool remove(const Key& key)
+		{
+			return remove_key(key, hasher(key));
+		}
+
+		template<typename K> requires Transparent_Hash<Hash, Eq>
+		bool remove(const K& key)
+		{
+			return remove_key(key, hasher(key));
+		}
+
+		// The *_hashed variants take hasher(key) from the caller, see Hash_Map
+		template<typename K>
+		const Value* get_hashed(const K& key, size_t hash) const
+		{
+			return find_value(key, hash);
+		}
+
+		template<typename K>
+		Value* get_hashed(const K& key, size_t hash)
+		{
+			return const_cast<Value*>(find_value(key, hash));
+		}
+
+		template<typename K, typename V>
+		Value& insert_hashed(K&& key, V&& value, size_t hash)
+		{
+			auto [stored, inserted] = try_emplace_hashed(std::forward<K>(key), hash, std::forward<V>(value));
+
+			if (inserted == false)
+			{
+				stored = std::forward<V>(value);
+			}
+
+			return stored;
+		}
+
+		template<typename K, typename... Args>
+		Insert_Result try_emplace_hashed(K&& key, size_t hash, Args&&... args)
+		{
+			size_t index = 0u;
+
+			if (groups.size() > 0u)
+			{
+				auto [probed_index, found] = probe(key, hash);
+
+				if (found)
+				{
+					return Insert_Result{slot_at(probed_index).value, false};
+				}
+
+				index = probed_index;
+			}
+
+			// A reused tombstone doesn't add to the load
+			if (groups.size() == 0u || (is_empty_slot(index) && element_count + tombstones + 1u > static_cast<size_t>(LOAD_FACTOR * groups.size() * GROUP_SLOTS)))
+			{
+				rehash(capacity_for(element_count + 1u));
+				index = find_empty(hash);
+			}
+
+			Slot* slot = open_slot(index);
+			new (slot) Slot{Key(std::forward<K>(key)), Value(std::forward<Args>(args)...)};
+
+			return Insert_Result{slot->value, true};
+		}
+
+		template<typename K>
+		bool remove_hashed(const K& key, size_t hash)
+		{
+			return remove_key(key, hash);
+		}
+
+		// Makes room for "count" elements without growing, drops the tombstones if it rehashes
+		void reserve(size_t count)
+		{
+			size_t new_capacity = capacity_for(count);
+
+			if (new_capacity > groups.size() * GROUP_SLOTS)
+			{
+				rehash(new_capacity);
+			}
+		}
+
+		// Frees the elements, keeps the (small) group table
+		void clear()
+		{
+			destroy_groups();
+
+			element_count = 0u;
+			tombstones = 0u;
+		}
+
+		// Shrinks the table to the smallest one that holds the elements, dropping the tombstones
+		void shrink_to_fit()
+		{
+			if (element_count == 0u)
+			{
+				destroy_groups();
+				groups = Array<Group>{};
+				tombstones = 0u;
+
+				return;
+			}
+
+			size_t new_capacity = capacity_for(element_count);
+
+			if (new_capacity < groups.size() * GROUP_SLOTS || tombstones > 0u)
+			{
+				rehash(new_capacity);
+			}
+		}
+
+		size_t count() const { return element_count; }
+		size_t capacity() const { return groups.size() * GROUP_SLOTS; }
+
+		// Counts, load and bytes, the probe numbers are not collected
+		Hash_Stats stats() const
+		{
+			Hash_Stats result;
+
+			result.count = element_count;
+			result.capacity = capacity();
+			result.load_factor = capacity() > 0u ? static_cast<float>(element_count) / static_cast<float>(capacity()) : 0.0f;
+			result.rehash_count = rehashes;
+			result.bytes_used = element_count * sizeof(Slot);
+			result.bytes_reserved = groups.size() * sizeof(Group);
+
+			for (size_t g = 0u; g < groups.size(); ++g)
+			{
+				result.bytes_reserved += allocation_size(groups[g].count()) * sizeof(Slot);
+			}
+
+			return result;
+		}
+
+	public: // Iterator-related
+		// What the mutable iterator yields, the key stays read-only
+		struct Entry
+		{
+			const Key& key;
+			Value& value;
+		};
+
+		// Calls fn(key, value) for every element, with a mutable value on a non-const map. Each group is a
+		// walk over its packed array
+		// NOTE: must not insert into or remove from the map
+		template<typename F>
+		void for_each(F&& fn)
+		{
+			visit_slots([&](Slot& slot) { fn(static_cast<const Key&>(slot.key), slot.value); });
+		}
+
+		template<typename F>
+		void for_each(F&& fn) const
+		{
+			visit_slots([&](const Slot& slot) { fn(slot.key, slot.value); });
+		}
+
+	private:
+		template<typename F>
+		void visit_slots(F&& visit) const
+		{
+			for (size_t g = 0u; g < groups.size(); ++g)
+			{
+				const Group& group = groups[g];
+				uint32_t count = group.count();
+
+				for (uint32_t i = 0u; i < count; ++i)
+				{
+					visit(group.slots[i]);
+				}
+			}
+		}
+
+		// Position of the iterators: a group and an element of its packed array, empty groups are skipped
+		class Slot_Cursor
+		{
+		public:
+			Slot_Cursor(const Group* group_table, size_t group_index, size_t group_count):
+				group_table{group_table},
+				group_index{group_index},
+				group_count{group_count}
+			{
+				skip_empty();
+			}
+
+			void advance()
+			{
+				if (++position == group_table[group_index].count())
+				{
+					position = 0u;
+					++group_index;
+
+					skip_empty();
+				}
+			}
+
+			bool operator==(const Slot_Cursor& other) const
+			{
+				return group_index == other.group_index && position == other.position;
+			}
+
+			Slot& slot() const
+			{
+				return group_table[group_index].slots[position];
+			}
+
+		private:
+			void skip_empty()
+			{
+				while (group_index < group_count && group_table[group_index].occupied == 0u)
+				{
+					++group_index;
+				}
+			}
+
+			const Group* group_table;
+			size_t group_index;
+			size_t group_count;
+			uint32_t position{0u};
+		};
+
+		Slot_Cursor first_slot() const
+		{
+			return Slot_Cursor{groups.buffer(), 0u, groups.size()};
+		}
+
+		Slot_Cursor past_last_slot() const
+		{
+			return Slot_Cursor{groups.buffer(), groups.size(), groups.size()};
+		}
+
+		struct Arrow_Proxy
+		{
+			Entry entry;
+
+			const Entry* operator->() const { return &entry; }
+		};
+
+	public:
+		// Yields the slot itself, with "key" and "value" members
+		class Iterator // Input Iterator
+		{
+		public:
+			explicit Iterator(Slot_Cursor cursor):
+				cursor{cursor}
+			{
+
+			}
+
+			Iterator& operator++()
+			{
+				cursor.advance();
+
+				return *this;
+			}
+
+			bool operator!=(const Iterator& other) const
+			{
+				return !(cursor == other.cursor);
+			}
+
+			bool operator==(const Iterator& other) const
+			{
+				return cursor == other.cursor;
+			}
+
+			const Slot& operator*() const
+			{
+				return cursor.slot();
+			}
+
+			const Slot* operator->() const
+			{
+				return &cursor.slot();
+			}
+
+		private:
+			Slot_Cursor cursor;
+		};
+
+		// Yields Entry by value like Hash_Map's, so it's "auto" or "const auto&" in a range-for
+		class Mutable_Iterator // Input Iterator
+		{
+		public:
+			explicit Mutable_Iterator(Slot_Cursor cursor):
+				cursor{cursor}
+			{
+
+			}
+
+			Mutable_Iterator& operator++()
+			{
+				cursor.advance();
+
+				return *this;
+			}
+
+			bool operator!=(const Mutable_Iterator& other) const
+			{
+				return !(cursor == other.cursor);
+			}
+
+			bool operator==(const Mutable_Iterator& other) const
+			{
+				return cursor == other.cursor;
+			}
+
+			Entry operator*() const
+			{
+				return Entry{cursor.slot().key, cursor.slot().value};
+			}
+
+			Arrow_Proxy operator->() const
+			{
+				return Arrow_Proxy{**this};
+			}
+
+		private:
+			Slot_Cursor cursor;
+		};
+
+		Iterator begin() const { return Iterator{first_slot()}; }
+		Iterator end() const { return Iterator{past_last_slot()}; }
+
+		Mutable_Iterator begin() { return Mutable_Iterator{first_slot()}; }
+		Mutable_Iterator end() { return Mutable_Iterator{past_last_slot()}; }
+	};
+};
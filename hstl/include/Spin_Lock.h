@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Simd.h"
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+
+namespace hstl
+{
+	// Two objects closer than this can share a cache line and make two threads fight over it (false sharing)
+	inline constexpr size_t CACHE_LINE_SIZE = 64u;
+
+	namespace detail
+	{
+		// Spins a few rounds, then gives the core away: with more threads than cores the lock holder may be
+		// waiting for the very core the spinner burns
+		class Spin_Backoff
+		{
+		public:
+			void wait()
+			{
+				if (spins < MAX_SPINS)
+				{
+					spins++;
+#if defined(HSTL_SIMD_SSE2)
+					_mm_pause();
+#endif
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+
+		private:
+			static constexpr uint32_t MAX_SPINS = 64u;
+
+			uint32_t spins{0u};
+		};
+	}
+
+	// Reader-writer lock for short critical sections, 4 bytes with no system calls. Meets the Lockable and
+	// SharedLockable requirements, so it goes with std::unique_lock and std::shared_lock
+	// A waiting writer stops new readers from coming in, a steady stream of readers can't starve it
+	class Shared_Spin_Lock
+	{
+	public:
+		void lock()
+		{
+			detail::Spin_Backoff backoff;
+
+			while (true)
+			{
+				uint32_t current = state.load(std::memory_order_relaxed);
+
+				if ((current & ~WRITER_WAITING) == 0u)
+				{
+					// Also clears WRITER_WAITING, the other waiting writers set it again
+					if (state.compare_exchange_weak(current, WRITER, std::memory_order_acquire, std::memory_order_relaxed))
+					{
+						return;
+					}
+				}
+				else if ((current & WRITER_WAITING) == 0u)
+				{
+					state.fetch_or(WRITER_WAITING, std::memory_order_relaxed);
+				}
+
+				backoff.wait();
+			}
+		}
+
+		bool try_lock()
+		{
+			uint32_t current = state.load(std::memory_order_relaxed);
+
+			return (current & ~WRITER_WAITING) == 0u && state.compare_exchange_strong(current, WRITER, std::memory_order_acquire, std::memory_order_relaxed);
+		}
+
+		void unlock()
+		{
+			state.fetch_and(~WRITER, std::memory_order_release);
+		}
+
+		void lock_shared()
+		{
+			detail::Spin_Backoff backoff;
+
+			while (try_lock_shared() == false)
+			{
+				backoff.wait();
+			}
+		}
+
+		bool try_lock_shared()
+		{
+			uint32_t current = state.load(std::memory_order_relaxed);
+
+			return (current & (WRITER | WRITER_WAITING)) == 0u && state.compare_exchange_weak(current, current + READER, std::memory_order_acquire, std::memory_order_relaxed);
+		}
+
+		void unlock_shared()
+		{
+			state.fetch_sub(READER, std::memory_order_release);
+		}
+
+	private:
+		static constexpr uint32_t WRITER = 1u;
+		static constexpr uint32_t WRITER_WAITING = 2u;
+		static constexpr uint32_t READER = 4u; // The reader count lives in the bits above
+
+		std::atomic<uint32_t> state{0u};
+	};
+};
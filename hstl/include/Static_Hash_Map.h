@@ -0,0 +1,298 @@
+#pragma once
+
+#include "Frozen_Hash_Map.h"
+#include "Hash.h"
+#include "Str.h"
+
+#include <array>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+namespace hstl
+{
+	template<typename Key, typename Value>
+	struct Static_Hash_Entry
+	{
+		Key key;
+		Value value;
+	};
+
+	namespace detail
+	{
+		// Not constexpr on purpose: reaching one while building a Static_Hash_Map is a compile error
+		// whose message names the problem
+		inline void static_hash_map_duplicate_key()
+		{
+		}
+
+		inline void static_hash_map_no_perfect_hash()
+		{
+		}
+
+		inline constexpr uint64_t STATIC_HASH_MAX_SEED_ATTEMPTS = 64u;
+		inline constexpr uint32_t STATIC_HASH_MAX_D0 = 1u << 10u;
+	}
+
+	// Hash map whose N entries are known at compile time (enum to name tables, lexer keywords, config
+	// schemas). make_static_hash_map() builds it in a consteval function: it searches a seed and one
+	// displacement per pair of keys that give every key its own slot, the same minimal perfect hash as
+	// Frozen_Hash_Map. A constexpr map is read-only data and costs nothing at startup
+	// A lookup is one hash, one displacement read and one compare against the only key that can match
+	// (string keys check a tag of their hash before the characters), and works in constant expressions too
+	// NOTE: a table of Str_View keys holds pointers, position-independent binaries put it in .data.rel.ro
+	// Keys are integers, enums or Str_View, values are any copyable literal type
+	template<typename Key, typename Value, size_t N>
+	class Static_Hash_Map
+	{
+	private:
+		static constexpr bool STRING_KEYS = std::is_same_v<Key, Str_View>;
+
+		static_assert(STRING_KEYS || std::is_integral_v<Key> || std::is_enum_v<Key>, "Static_Hash_Map keys are integers, enums or Str_View");
+		static_assert(N > 0u && N < (uint64_t{1u} << 32u), "A Static_Hash_Map holds between 1 and 2^32 - 1 entries");
+
+		static constexpr size_t BUCKET_COUNT = (N + 1u) / 2u;
+
+		using Entry = Static_Hash_Entry<Key, Value>;
+		using Displacement = detail::Frozen_Displacement;
+
+		struct No_Tags
+		{
+		};
+
+		// Low half of the hash of each string key, most misses then never compare characters
+		using Tags = std::conditional_t<STRING_KEYS, std::array<uint32_t, N>, No_Tags>;
+
+		std::array<Entry, N> entries; // In slot order
+		std::array<Displacement, BUCKET_COUNT> displacements{};
+		[[no_unique_address]] Tags tags{};
+		uint64_t seed{0u};
+
+	private:
+		constexpr explicit Static_Hash_Map(const std::array<Entry, N>& source):
+			entries{source}
+		{
+
+		}
+
+		static constexpr uint64_t hash_key(const Key& key, uint64_t seed)
+		{
+			if constexpr (STRING_KEYS)
+			{
+				return hash_chars(key.data(), key.count(), seed);
+			}
+			else
+			{
+				return hash_combine(seed, static_cast<uint64_t>(key));
+			}
+		}
+
+		// One attempt with "seed", fills "slots" (slot of each entry) and the displacements
+		constexpr bool place(uint64_t (&hashes)[N], uint32_t (&slots)[N])
+		{
+			uint32_t bucket_starts[BUCKET_COUNT + 1u]{};
+			uint32_t members[N]{};
+			uint32_t fill[BUCKET_COUNT]{};
+			bool taken[N]{};
+			uint32_t bases[N]{};
+
+			for (size_t i = 0u; i < N; ++i)
+			{
+				hashes[i] = hash_key(entries[i].key, seed);
+				bucket_starts[detail::frozen_bucket(hashes[i], BUCKET_COUNT) + 1u]++;
+			}
+
+			uint32_t max_bucket_size = 0u;
+
+			for (size_t b = 0u; b < BUCKET_COUNT; ++b)
+			{
+				max_bucket_size = bucket_starts[b + 1u] > max_bucket_size ? bucket_starts[b + 1u] : max_bucket_size;
+				bucket_starts[b + 1u] += bucket_starts[b];
+			}
+
+			for (size_t i = 0u; i < N; ++i)
+			{
+				uint32_t bucket = detail::frozen_bucket(hashes[i], BUCKET_COUNT);
+				members[bucket_starts[bucket] + fill[bucket]++] = static_cast<uint32_t>(i);
+			}
+
+			for (size_t b = 0u; b < BUCKET_COUNT; ++b)
+			{
+				for (uint32_t i = bucket_starts[b]; i < bucket_starts[b + 1u]; ++i)
+				{
+					for (uint32_t j = i + 1u; j < bucket_starts[b + 1u]; ++j)
+					{
+						if (entries[members[i]].key == entries[members[j]].key)
+						{
+							detail::static_hash_map_duplicate_key();
+						}
+
+						if (hashes[members[i]] == hashes[members[j]])
+						{
+							return false;
+						}
+					}
+				}
+			}
+
+			// Largest buckets first
+			for (uint32_t size = max_bucket_size; size > 0u; --size)
+			{
+				for (size_t bucket = 0u; bucket < BUCKET_COUNT; ++bucket)
+				{
+					uint32_t first = bucket_starts[bucket];
+
+					if (bucket_starts[bucket + 1u] - first != size)
+					{
+						continue;
+					}
+
+					bool found = false;
+
+					for (uint32_t d0 = 0u; d0 < detail::STATIC_HASH_MAX_D0 && found == false; ++d0)
+					{
+						bool distinct = true;
+
+						for (uint32_t i = 0u; i < size && distinct; ++i)
+						{
+							bases[i] = detail::frozen_base(hashes[members[first + i]], d0, N);
+
+							for (uint32_t j = 0u; j < i; ++j)
+							{
+								distinct = distinct && bases[j] != bases[i];
+							}
+						}
+
+						for (uint32_t d1 = 0u; d1 < N && distinct && found == false; ++d1)
+						{
+							bool fits = true;
+
+							for (uint32_t i = 0u; i < size && fits; ++i)
+							{
+								fits = taken[detail::frozen_slot(bases[i], d1, N)] == false;
+							}
+
+							if (fits)
+							{
+								for (uint32_t i = 0u; i < size; ++i)
+								{
+									uint32_t slot = detail::frozen_slot(bases[i], d1, N);
+									taken[slot] = true;
+									slots[members[first + i]] = slot;
+								}
+
+								displacements[bucket] = Displacement{d0, d1};
+								found = true;
+							}
+						}
+					}
+
+					if (found == false)
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+	public:
+		// Use make_static_hash_map()
+		static consteval Static_Hash_Map build(const std::array<Entry, N>& source)
+		{
+			Static_Hash_Map map{source};
+			uint64_t hashes[N]{};
+			uint32_t slots[N]{};
+			bool placed = false;
+
+			for (uint64_t attempt = 0u; attempt < detail::STATIC_HASH_MAX_SEED_ATTEMPTS && placed == false; ++attempt)
+			{
+				map.seed = hash_u64(attempt);
+				map.displacements = {};
+				placed = map.place(hashes, slots);
+			}
+
+			if (placed == false)
+			{
+				detail::static_hash_map_no_perfect_hash();
+			}
+
+			for (size_t i = 0u; i < N; ++i)
+			{
+				map.entries[slots[i]] = source[i];
+
+				if constexpr (STRING_KEYS)
+				{
+					map.tags[slots[i]] = static_cast<uint32_t>(hashes[i]);
+				}
+			}
+
+			return map;
+		}
+
+	public:
+		constexpr const Value* get(const Key& key) const
+		{
+			uint64_t hash = hash_key(key, seed);
+			Displacement displacement = displacements[detail::frozen_bucket(hash, BUCKET_COUNT)];
+			uint32_t slot = detail::frozen_slot(detail::frozen_base(hash, displacement.d0, N), displacement.d1, N);
+
+			if constexpr (STRING_KEYS)
+			{
+				if (tags[slot] != static_cast<uint32_t>(hash))
+				{
+					return nullptr;
+				}
+			}
+
+			const Entry& entry = entries[slot];
+
+			return entry.key == key ? &entry.value : nullptr;
+		}
+
+		constexpr bool contains(const Key& key) const
+		{
+			return get(key) != nullptr;
+		}
+
+		// The value of "key", or "fallback" when it's missing
+		constexpr Value get_or(const Key& key, const Value& fallback) const
+		{
+			const Value* value = get(key);
+
+			return value != nullptr ? *value : fallback;
+		}
+
+		constexpr size_t count() const
+		{
+			return N;
+		}
+
+		// Calls fn(key, value) for every entry, in slot order
+		template<typename F>
+		constexpr void for_each(F&& fn) const
+		{
+			for (const Entry& entry : entries)
+			{
+				fn(entry.key, entry.value);
+			}
+		}
+	};
+
+	// Builds a Static_Hash_Map at compile time, e.g.
+	// constexpr auto KEYWORDS = hstl::make_static_hash_map<hstl::Str_View, Token>({{"if", Token::IF}, {"else", Token::ELSE}});
+	// A duplicate key fails to compile
+	template<typename Key, typename Value, size_t N>
+	consteval Static_Hash_Map<Key, Value, N> make_static_hash_map(const Static_Hash_Entry<Key, Value> (&entries)[N])
+	{
+		return Static_Hash_Map<Key, Value, N>::build(std::to_array(entries));
+	}
+
+	// For tables generated by a constexpr function
+	template<typename Key, typename Value, size_t N>
+	consteval Static_Hash_Map<Key, Value, N> make_static_hash_map(const std::array<Static_Hash_Entry<Key, Value>, N>& entries)
+	{
+		return Static_Hash_Map<Key, Value, N>::build(entries);
+	}
+};
@@ -2,44 +2,47 @@
 
 #include "Array.h"
 
+#include <string_view>
+#include <type_traits>
 #include <assert.h>
 
 namespace hstl
 {
 	// Non owning wrapper aound a sequence of charachters
+	// Construction, access and comparison are constexpr, so views of literals can key compile-time tables
 	class Str_View
 	{
 	public:
 		static constexpr size_t npos = static_cast<size_t>(-1);
 
-		Str_View(const char* _data, size_t _count):
+		constexpr Str_View(const char* _data, size_t _count):
 			_data{_data},
 			_count{_count}
 		{
 			assert(_data);
 		}
 
-		Str_View(const char* c_str):
+		constexpr Str_View(const char* c_str):
 		_data{c_str},
 		_count{0u}
 		{
 			assert(_data);
 
-			_count = strlen(c_str);
+			_count = std::char_traits<char>::length(c_str);
 		}
 
 	public:
-		size_t count() const
+		constexpr size_t count() const
 		{
 			return _count;
 		}
 
-		const char* data() const
+		constexpr const char* data() const
 		{
 			return _data;
 		}
 
-		const char& operator[](size_t index) const
+		constexpr const char& operator[](size_t index) const
 		{
 			return _data[index];
 		}
@@ -53,13 +56,18 @@ namespace hstl
 			return *this;
 		}
 
-		bool operator==(const Str_View& view) const
+		constexpr bool operator==(const Str_View& view) const
 		{
 			if (view.count() != _count)
 			{
 				return false;
 			}
 
+			if (std::is_constant_evaluated())
+			{
+				return std::char_traits<char>::compare(_data, view.data(), _count) == 0;
+			}
+
 			int res = memcmp(_data, view.data(), sizeof(char) * _count);
 
 			if (res == 0)
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Array.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <deque>
+
+namespace hstl
+{
+	// A fixed set of worker threads that run fork-join style jobs
+	// The calling thread always takes part in its own job, so nested parallel_for calls can't dead-lock
+	class Thread_Pool
+	{
+	private:
+		struct Job
+		{
+			const std::function<void(size_t)>* task{nullptr};
+			size_t task_count{0u};
+			std::atomic<size_t> next_task{0u};
+			std::atomic<size_t> finished_tasks{0u};
+		};
+
+	public:
+		explicit Thread_Pool(size_t worker_count = default_worker_count())
+		{
+			workers.reserve(worker_count);
+
+			for (size_t i = 0u; i < worker_count; ++i)
+			{
+				workers.emplace([this]() { worker_loop(); });
+			}
+		}
+
+		Thread_Pool(const Thread_Pool&) = delete;
+		Thread_Pool& operator=(const Thread_Pool&) = delete;
+		Thread_Pool(Thread_Pool&&) = delete;
+		Thread_Pool& operator=(Thread_Pool&&) = delete;
+
+		~Thread_Pool()
+		{
+			{
+				std::lock_guard lock{mutex};
+				stopping = true;
+			}
+
+			wake_up.notify_all();
+
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+		}
+
+	public:
+		// Runs task(0) ... task(task_count - 1) and returns once all of them are done
+		// Tasks are claimed dynamically, so uneven task costs still balance across threads
+		void parallel_for(size_t task_count, const std::function<void(size_t)>& task)
+		{
+			if (task_count == 0u)
+			{
+				return;
+			}
+
+			if (task_count == 1u || workers.size() == 0u)
+			{
+				for (size_t i = 0u; i < task_count; ++i)
+				{
+					task(i);
+				}
+
+				return;
+			}
+
+			auto job = std::make_shared<Job>();
+			job->task = &task;
+			job->task_count = task_count;
+
+			// Don't wake up more helpers than there are tasks left for them
+			size_t helper_count = std::min(workers.size(), task_count - 1u);
+
+			{
+				std::lock_guard lock{mutex};
+
+				for (size_t i = 0u; i < helper_count; ++i)
+				{
+					pending.push_back(job);
+				}
+			}
+
+			if (helper_count == 1u)
+			{
+				wake_up.notify_one();
+			}
+			else
+			{
+				wake_up.notify_all();
+			}
+
+			run_tasks(*job);
+
+			// NOTE: Helpers that show up after the last task was claimed never touch "task",
+			// so it is safe to return as soon as every claimed task has finished
+			size_t finished = job->finished_tasks.load(std::memory_order_acquire);
+
+			while (finished != task_count)
+			{
+				job->finished_tasks.wait(finished, std::memory_order_acquire);
+				finished = job->finished_tasks.load(std::memory_order_acquire);
+			}
+		}
+
+		size_t worker_count() const { return workers.size(); }
+
+		// Number of threads that take part in a job, i.e. the workers plus the caller
+		size_t thread_count() const { return workers.size() + 1u; }
+
+		static size_t default_worker_count()
+		{
+			size_t hardware_threads = std::thread::hardware_concurrency();
+
+			return hardware_threads > 1u ? hardware_threads - 1u : 0u;
+		}
+
+		static Thread_Pool* get()
+		{
+			static Thread_Pool pool;
+			return &pool;
+		}
+
+	private:
+		static void run_tasks(Job& job)
+		{
+			while (true)
+			{
+				size_t index = job.next_task.fetch_add(1u, std::memory_order_relaxed);
+
+				if (index >= job.task_count)
+				{
+					return;
+				}
+
+				(*job.task)(index);
+
+				if (job.finished_tasks.fetch_add(1u, std::memory_order_acq_rel) + 1u == job.task_count)
+				{
+					job.finished_tasks.notify_all();
+				}
+			}
+		}
+
+		void worker_loop()
+		{
+			while (true)
+			{
+				std::shared_ptr<Job> job;
+
+				{
+					std::unique_lock lock{mutex};
+
+					wake_up.wait(lock, [this]() { return stopping || pending.empty() == false; });
+
+					if (pending.empty())
+					{
+						return; // stopping
+					}
+
+					job = std::move(pending.front());
+					pending.pop_front();
+				}
+
+				run_tasks(*job);
+			}
+		}
+
+	private:
+		Array<std::thread> workers;
+		std::deque<std::shared_ptr<Job>> pending;
+		std::mutex mutex;
+		std::condition_variable wake_up;
+		bool stopping{false};
+	};
+};
@@ -259,5 +259,11 @@ int main()
 		std::cout << s << '\n';
 	}
 
+	// Point has no padding, so it is hashed and compared as bytes without any functor
+	hstl::Hash_Set<Point> points;
+	points.insert(Point{1, 2, 3});
+
+	assert(points.contains(Point{1, 2, 3}));
+
 	return 0;
 }
@@ -0,0 +1,236 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Algorithms.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+
+namespace {
+
+	template<typename T>
+	hstl::Array<T> make_sequence(size_t count)
+	{
+		hstl::Array<T> arr;
+		for (size_t i = 0; i < count; ++i)
+			arr.push(static_cast<T>(i % 1000));
+
+		return arr;
+	}
+
+} // namespace
+
+TEST_CASE("Algorithms: find/contains/count on every lane width")
+{
+	// Sizes around the vector widths to hit the unrolled loop, the single vector loop and the scalar tail
+	const size_t sizes[] = { 0, 1, 3, 15, 16, 17, 33, 64, 127, 128, 129, 1000, 4099 };
+
+	for (size_t n : sizes)
+	{
+		auto ints = make_sequence<int32_t>(n);
+		auto uints = make_sequence<uint32_t>(n);
+		auto floats = make_sequence<float>(n);
+		auto longs = make_sequence<int64_t>(n);
+		auto doubles = make_sequence<double>(n);
+		auto bytes = make_sequence<uint8_t>(n);
+		auto shorts = make_sequence<int16_t>(n); // no SIMD lane, goes down the scalar path
+
+		for (size_t target : { size_t{0}, n / 2, n > 0 ? n - 1 : 0 })
+		{
+			if (n == 0)
+				break;
+
+			REQUIRE(hstl::find(ints, ints[target]) == std::find(ints.begin(), ints.end(), ints[target]));
+			REQUIRE(hstl::find(uints, uints[target]) == std::find(uints.begin(), uints.end(), uints[target]));
+			REQUIRE(hstl::find(floats, floats[target]) == std::find(floats.begin(), floats.end(), floats[target]));
+			REQUIRE(hstl::find(longs, longs[target]) == std::find(longs.begin(), longs.end(), longs[target]));
+			REQUIRE(hstl::find(doubles, doubles[target]) == std::find(doubles.begin(), doubles.end(), doubles[target]));
+			REQUIRE(hstl::find(bytes, bytes[target]) == std::find(bytes.begin(), bytes.end(), bytes[target]));
+			REQUIRE(hstl::find(shorts, shorts[target]) == std::find(shorts.begin(), shorts.end(), shorts[target]));
+
+			REQUIRE(hstl::count(ints, ints[target]) == static_cast<size_t>(std::count(ints.begin(), ints.end(), ints[target])));
+			REQUIRE(hstl::count(floats, floats[target]) == static_cast<size_t>(std::count(floats.begin(), floats.end(), floats[target])));
+			REQUIRE(hstl::count(longs, longs[target]) == static_cast<size_t>(std::count(longs.begin(), longs.end(), longs[target])));
+			REQUIRE(hstl::count(bytes, bytes[target]) == static_cast<size_t>(std::count(bytes.begin(), bytes.end(), bytes[target])));
+		}
+
+		REQUIRE_FALSE(hstl::contains(ints, -1));
+		REQUIRE_FALSE(hstl::contains(floats, -1.0f));
+		REQUIRE_FALSE(hstl::contains(longs, int64_t{-1}));
+		REQUIRE(hstl::find(ints, -1) == ints.end());
+		REQUIRE(hstl::count(doubles, -1.0) == 0);
+	}
+}
+
+TEST_CASE("Algorithms: find returns a mutable pointer for mutable arrays")
+{
+	auto arr = make_sequence<int>(100);
+
+	int* found = hstl::find(arr, 42);
+	REQUIRE(found != arr.end());
+
+	*found = -5;
+	REQUIRE(arr[42] == -5);
+}
+
+TEST_CASE("Algorithms: min_element/max_element match the standard library")
+{
+	std::mt19937 rng{1234};
+	std::uniform_int_distribution<int32_t> int_dist{-100000, 100000};
+	std::uniform_real_distribution<float> float_dist{-1000.0f, 1000.0f};
+
+	for (size_t n : { size_t{1}, size_t{7}, size_t{16}, size_t{31}, size_t{1000}, size_t{10007} })
+	{
+		hstl::Array<int32_t> ints;
+		hstl::Array<uint32_t> uints;
+		hstl::Array<float> floats;
+		hstl::Array<double> doubles;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			int32_t v = int_dist(rng);
+			ints.push(v);
+			uints.push(static_cast<uint32_t>(v)); // negative values become huge, exercises unsigned ordering
+			floats.push(float_dist(rng));
+			doubles.push(static_cast<double>(float_dist(rng)));
+		}
+
+		REQUIRE(hstl::min_element(ints) == std::min_element(ints.begin(), ints.end()));
+		REQUIRE(hstl::max_element(ints) == std::max_element(ints.begin(), ints.end()));
+		REQUIRE(hstl::min_element(uints) == std::min_element(uints.begin(), uints.end()));
+		REQUIRE(hstl::max_element(uints) == std::max_element(uints.begin(), uints.end()));
+		REQUIRE(hstl::min_element(floats) == std::min_element(floats.begin(), floats.end()));
+		REQUIRE(hstl::max_element(floats) == std::max_element(floats.begin(), floats.end()));
+		REQUIRE(hstl::min_element(doubles) == std::min_element(doubles.begin(), doubles.end()));
+		REQUIRE(hstl::max_element(doubles) == std::max_element(doubles.begin(), doubles.end()));
+	}
+
+	SECTION("Duplicated extremes return the first one") {
+		hstl::Array<int32_t> arr;
+		for (int i = 0; i < 100; ++i)
+			arr.push(i % 10);
+
+		REQUIRE(hstl::min_element(arr) == arr.begin());
+		REQUIRE(hstl::max_element(arr) == arr.begin() + 9);
+	}
+
+	SECTION("Empty arrays return end") {
+		hstl::Array<float> empty;
+		REQUIRE(hstl::min_element(empty) == empty.end());
+		REQUIRE(hstl::max_element(empty) == empty.end());
+	}
+}
+
+TEST_CASE("Algorithms: min_element/max_element never return end for ranges with NaNs")
+{
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+
+	for (size_t n : { size_t{7}, size_t{64}, size_t{1000} })
+	{
+		for (size_t nan_at : { size_t{0}, n / 2, n - 1 })
+		{
+			hstl::Array<float> floats;
+			hstl::Array<double> doubles;
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				floats.push(i == nan_at ? nan : static_cast<float>(i % 13));
+				doubles.push(i == nan_at ? static_cast<double>(nan) : static_cast<double>(i % 13));
+			}
+
+			REQUIRE(hstl::min_element(floats) < floats.end());
+			REQUIRE(hstl::max_element(floats) < floats.end());
+			REQUIRE(hstl::min_element(doubles) < doubles.end());
+			REQUIRE(hstl::max_element(doubles) < doubles.end());
+		}
+
+		// Every lane reduces to NaN
+		hstl::Array<float> all_nan;
+		for (size_t i = 0; i < n; ++i)
+			all_nan.push(nan);
+
+		REQUIRE(hstl::min_element(all_nan) == all_nan.begin());
+		REQUIRE(hstl::max_element(all_nan) == all_nan.begin());
+	}
+}
+
+TEST_CASE("Algorithms: sum")
+{
+	for (size_t n : { size_t{0}, size_t{5}, size_t{16}, size_t{17}, size_t{1000}, size_t{65537} })
+	{
+		auto ints = make_sequence<int32_t>(n);
+		auto uints = make_sequence<uint32_t>(n);
+		auto longs = make_sequence<int64_t>(n);
+		auto floats = make_sequence<float>(n);
+
+		REQUIRE(hstl::sum(ints) == std::accumulate(ints.begin(), ints.end(), int32_t{0}));
+		REQUIRE(hstl::sum(uints) == std::accumulate(uints.begin(), uints.end(), uint32_t{0}));
+		REQUIRE(hstl::sum(longs) == std::accumulate(longs.begin(), longs.end(), int64_t{0}));
+
+		// Integral sums are exact in float up to 2^24, past that the lane order changes the rounding
+		if (n <= 1000)
+			REQUIRE(hstl::sum(floats) == std::accumulate(floats.begin(), floats.end(), 0.0f));
+	}
+
+	SECTION("Signed sums wrap around, short ranges included") {
+		for (size_t n : { size_t{2}, size_t{5}, size_t{100} })
+		{
+			hstl::Array<int32_t> ints;
+			hstl::Array<int64_t> longs;
+			uint32_t expected_int = 0;
+			uint64_t expected_long = 0;
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				ints.push(std::numeric_limits<int32_t>::max());
+				longs.push(std::numeric_limits<int64_t>::max());
+				expected_int += static_cast<uint32_t>(std::numeric_limits<int32_t>::max());
+				expected_long += static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+			}
+
+			REQUIRE(hstl::sum(ints) == static_cast<int32_t>(expected_int));
+			REQUIRE(hstl::sum(longs) == static_cast<int64_t>(expected_long));
+		}
+	}
+}
+
+TEST_CASE("Algorithms: any_of")
+{
+	auto arr = make_sequence<int>(500);
+
+	REQUIRE(hstl::any_of(arr, [](const int& x) { return x == 499; }));
+	REQUIRE(hstl::any_of(arr, [](const int& x) { return x == 3; }));
+	REQUIRE_FALSE(hstl::any_of(arr, [](const int& x) { return x < 0; }));
+
+	hstl::Array<std::string> strings;
+	strings.push("a");
+	strings.push("bb");
+	REQUIRE(hstl::any_of(strings, [](const std::string& s) { return s.size() == 2; }));
+}
+
+TEST_CASE("Algorithms: Str_View count/contains")
+{
+	hstl::Str_View view{"the quick brown fox jumps over the lazy dog, again and again and again"};
+
+	REQUIRE(hstl::count(view, 'a') == static_cast<size_t>(std::count(view.data(), view.data() + view.count(), 'a')));
+	REQUIRE(hstl::count(view, ' ') == 13);
+	REQUIRE(hstl::contains(view, 'z'));
+	REQUIRE_FALSE(hstl::contains(view, '#'));
+}
+
+TEST_CASE("Algorithms: lower_bound matches std::lower_bound")
+{
+	hstl::Array<int> arr;
+	for (int i = 0; i < 257; ++i)
+		arr.push(i * 2); // even numbers only
+
+	for (size_t n : { size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{64}, size_t{255}, size_t{257} })
+	{
+		for (int key = -1; key <= 2 * static_cast<int>(n) + 1; ++key)
+		{
+			REQUIRE(hstl::lower_bound(arr.buffer(), n, key) == std::lower_bound(arr.buffer(), arr.buffer() + n, key));
+		}
+	}
+}
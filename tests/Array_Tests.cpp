@@ -4,6 +4,7 @@
 
 #include <string>
 #include <memory>
+#include <algorithm>
 
 // --- HELPER FOR MOVE SEMANTICS ---
 struct MoveTracker {
@@ -154,3 +155,95 @@ TEST_CASE("Array: Removal Strategies", "[array][remove]") {
         REQUIRE(arr[3] == 3);
     }
 }
+
+TEST_CASE("Array: remove_if", "[array][remove]") {
+    auto is_odd = [](const int& x) { return x % 2 != 0; };
+
+    SECTION("remove_if_ordered keeps the survivors in order") {
+        hstl::Array<int> arr;
+        for (int i = 0; i < 1001; ++i)
+            arr.push(i);
+
+        arr.remove_if_ordered(is_odd);
+
+        REQUIRE(arr.size() == 501);
+        for (size_t i = 0; i < arr.size(); ++i)
+            REQUIRE(arr[i] == static_cast<int>(i * 2));
+    }
+
+    SECTION("remove_if keeps every survivor (order not guaranteed)") {
+        hstl::Array<int> arr;
+        for (int i = 0; i < 1001; ++i)
+            arr.push(i);
+
+        arr.remove_if(is_odd);
+
+        REQUIRE(arr.size() == 501);
+
+        std::sort(arr.begin(), arr.end());
+        for (size_t i = 0; i < arr.size(); ++i)
+            REQUIRE(arr[i] == static_cast<int>(i * 2));
+    }
+
+    SECTION("8 byte elements and edge cases") {
+        hstl::Array<int64_t> arr;
+        for (int64_t i = 0; i < 37; ++i)
+            arr.push(i);
+
+        arr.remove_if_ordered([](const int64_t& x) { return x % 3 == 0; });
+
+        REQUIRE(arr.size() == 24);
+        for (size_t i = 1; i < arr.size(); ++i)
+            REQUIRE(arr[i - 1] < arr[i]);
+
+        arr.remove_if([](const int64_t&) { return false; });
+        REQUIRE(arr.size() == 24);
+
+        arr.remove_if([](const int64_t&) { return true; });
+        REQUIRE(arr.size() == 0);
+
+        arr.remove_if([](const int64_t&) { return true; });
+        REQUIRE(arr.size() == 0);
+    }
+
+    SECTION("Non-trivial elements") {
+        hstl::Array<std::string> ordered;
+        hstl::Array<std::string> unordered;
+        for (int i = 0; i < 100; ++i) {
+            ordered.push(std::to_string(i));
+            unordered.push(std::to_string(i));
+        }
+
+        auto ends_with_zero = [](const std::string& s) { return s.back() == '0'; };
+
+        ordered.remove_if_ordered(ends_with_zero);
+        unordered.remove_if(ends_with_zero);
+
+        REQUIRE(ordered.size() == 90);
+        REQUIRE(unordered.size() == 90);
+        REQUIRE(ordered[0] == "1");
+        REQUIRE(ordered[9] == "11");
+
+        for (const auto& s : unordered)
+            REQUIRE(s.back() != '0');
+
+        std::sort(unordered.begin(), unordered.end());
+        std::sort(ordered.begin(), ordered.end());
+        REQUIRE(std::equal(ordered.begin(), ordered.end(), unordered.begin()));
+    }
+
+    SECTION("remove_if removes a trailing run of matches") {
+        hstl::Array<std::string> arr;
+        arr.push("keep");
+        arr.push("drop");
+        arr.push("keep");
+        arr.push("drop");
+        arr.push("drop");
+
+        arr.remove_if([](const std::string& s) { return s == "drop"; });
+
+        REQUIRE(arr.size() == 2);
+        REQUIRE(arr[0] == "keep");
+        REQUIRE(arr[1] == "keep");
+    }
+}
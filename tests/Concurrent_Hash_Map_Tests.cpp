@@ -0,0 +1,213 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Concurrent_Hash_Map.h>
+#include <Str.h>
+
+#include <thread>
+#include <vector>
+#include <atomic>
+
+TEST_CASE("Concurrent_Hash_Map<int, int>: single-threaded API")
+{
+	hstl::Concurrent_Hash_Map<int, int> m;
+
+	REQUIRE(m.count() == 0);
+
+	REQUIRE(m.insert(1, 10));
+	REQUIRE(m.insert(2, 20));
+	REQUIRE_FALSE(m.insert(1, 11)); // overwrite
+
+	int value = 0;
+	REQUIRE(m.get(1, value));
+	REQUIRE(value == 11);
+	REQUIRE_FALSE(m.get(3, value));
+	REQUIRE(value == 11);
+
+	REQUIRE(m.try_emplace(3, 30));
+	REQUIRE_FALSE(m.try_emplace(3, 31));
+	REQUIRE(m.get(3, value));
+	REQUIRE(value == 30);
+
+	REQUIRE(m.visit(2, [](int& v) { v += 5; }));
+	REQUIRE_FALSE(m.visit(4, [](int&) { FAIL("visited a missing key"); }));
+	REQUIRE(m.get(2, value));
+	REQUIRE(value == 25);
+
+	REQUIRE(m.visit_or_emplace(4, [](int& v) { v++; }));
+	REQUIRE_FALSE(m.visit_or_emplace(4, [](int& v) { v++; }));
+	REQUIRE(m.get(4, value));
+	REQUIRE(value == 2);
+
+	REQUIRE(m.count() == 4);
+	REQUIRE(m.contains(2));
+	REQUIRE(m.remove(2));
+	REQUIRE_FALSE(m.remove(2));
+	REQUIRE_FALSE(m.contains(2));
+
+	int sum = 0;
+	m.for_each([&](const int& key, const int& v) { sum += key + v; });
+	REQUIRE(sum == (1 + 11) + (3 + 30) + (4 + 2));
+
+	m.clear();
+	REQUIRE(m.count() == 0);
+
+	// clear() keeps the shard tables
+	for (int i = 0; i < 10000; ++i)
+		m.insert(i, i);
+
+	size_t capacity = m.capacity();
+	REQUIRE(capacity >= 10000);
+
+	m.clear();
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.capacity() == capacity);
+	REQUIRE_FALSE(m.contains(5));
+
+	m.insert(5, 50);
+	REQUIRE(m.get(5, value));
+	REQUIRE(value == 50);
+}
+
+TEST_CASE("Concurrent_Hash_Map<Str, int>: transparent lookups")
+{
+	hstl::Concurrent_Hash_Map<hstl::Str, int> m;
+
+	m.insert("pelvis", 1);
+	m.try_emplace(hstl::Str_View{ "spine" }.data(), 2);
+
+	int value = 0;
+	REQUIRE(m.get("pelvis", value));
+	REQUIRE(value == 1);
+	REQUIRE(m.contains(hstl::Str_View{ "spine" }));
+	REQUIRE(m.remove(hstl::Str_View{ "pelvis" }));
+	REQUIRE(m.count() == 1);
+}
+
+TEST_CASE("Concurrent_Hash_Map<int, int>: threads inserting and counting at the same time")
+{
+	constexpr int THREAD_COUNT = 4;
+	constexpr int KEYS_PER_THREAD = 20000;
+
+	hstl::Concurrent_Hash_Map<int, int, hstl::Hash<int>, hstl::Equal_To<int>, 16u> m;
+
+	std::vector<std::thread> threads;
+
+	// Disjoint inserts, plus shared counters that every thread bumps
+	for (int t = 0; t < THREAD_COUNT; ++t)
+	{
+		threads.emplace_back([&m, t]()
+		{
+			for (int i = 0; i < KEYS_PER_THREAD; ++i)
+			{
+				m.insert(t * KEYS_PER_THREAD + i, i);
+				m.visit_or_emplace(-1 - (i % 100), [](int& n) { n++; });
+			}
+		});
+	}
+
+	// A reader running alongside only ever sees complete values (Catch2 assertions aren't thread-safe,
+	// the threads count their failures instead)
+	std::atomic<bool> done{false};
+	std::atomic<int> failures{0};
+	std::thread reader([&]()
+	{
+		while (done.load() == false)
+		{
+			for (int i = 0; i < 1000; ++i)
+			{
+				int value = -1;
+				if (m.get(i, value) && value != i)
+					failures++;
+			}
+		}
+	});
+
+	for (auto& thread : threads)
+		thread.join();
+
+	done = true;
+	reader.join();
+
+	REQUIRE(failures == 0);
+
+	REQUIRE(m.count() == static_cast<size_t>(THREAD_COUNT * KEYS_PER_THREAD + 100));
+
+	for (int i = 0; i < 100; ++i)
+	{
+		int n = 0;
+		REQUIRE(m.get(-1 - i, n));
+		REQUIRE(n == THREAD_COUNT * KEYS_PER_THREAD / 100);
+	}
+
+	// Every thread removes what another one inserted
+	threads.clear();
+
+	for (int t = 0; t < THREAD_COUNT; ++t)
+	{
+		threads.emplace_back([&m, &failures, t]()
+		{
+			int owner = (t + 1) % THREAD_COUNT;
+
+			for (int i = 0; i < KEYS_PER_THREAD; i += 2)
+				if (m.remove(owner * KEYS_PER_THREAD + i) == false)
+					failures++;
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	REQUIRE(failures == 0);
+
+	REQUIRE(m.count() == static_cast<size_t>(THREAD_COUNT * KEYS_PER_THREAD / 2 + 100));
+}
+
+TEST_CASE("Shared_Spin_Lock: writers exclude everyone, readers share")
+{
+	hstl::Shared_Spin_Lock lock;
+
+	REQUIRE(lock.try_lock());
+	REQUIRE_FALSE(lock.try_lock());
+	REQUIRE_FALSE(lock.try_lock_shared());
+	lock.unlock();
+
+	lock.lock_shared();
+	lock.lock_shared();
+	REQUIRE_FALSE(lock.try_lock());
+	lock.unlock_shared();
+	lock.unlock_shared();
+	REQUIRE(lock.try_lock());
+	lock.unlock();
+
+	// A plain counter guarded by the lock, no increment may be lost
+	long long counter = 0;
+	std::atomic<int> failures{0};
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&]()
+		{
+			for (int i = 0; i < 20000; ++i)
+			{
+				if (i % 4 == 0)
+				{
+					std::unique_lock guard{lock};
+					counter++;
+				}
+				else
+				{
+					std::shared_lock guard{lock};
+					if (counter < 0)
+						failures++;
+				}
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	REQUIRE(failures == 0);
+	REQUIRE(counter == 4 * 5000);
+}
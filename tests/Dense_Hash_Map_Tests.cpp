@@ -0,0 +1,232 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Dense_Hash_Map.h>
+#include <Str.h>
+
+#include <unordered_map>
+#include <random>
+
+namespace {
+
+	struct Key {
+		int v = 0;
+		size_t forced_hash = 0;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& k) const noexcept { return k.forced_hash; }
+	};
+
+	struct KeyEq {
+		bool operator()(const Key& a, const Key& b) const noexcept { return a.v == b.v; }
+	};
+
+	static Key K(int v, size_t h) { return Key{ v, h }; }
+
+} // namespace
+
+TEST_CASE("Dense_Hash_Map<int, int>: insert/get/contains/remove")
+{
+	hstl::Dense_Hash_Map<int, int> m;
+
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.capacity() == 0);
+	REQUIRE(m.get(10) == nullptr);
+	REQUIRE(m.remove(10) == false);
+
+	m.insert(10, 100);
+	m.insert(20, 200);
+
+	REQUIRE(m.count() == 2);
+	REQUIRE(m.contains(10));
+	REQUIRE(m.contains(20));
+	REQUIRE_FALSE(m.contains(30));
+	REQUIRE(*m.get(10) == 100);
+
+	// Overwriting keeps the count and the place of the element
+	auto& r10 = m.insert(10, 101);
+	REQUIRE(r10 == 101);
+	REQUIRE(m.count() == 2);
+	REQUIRE(m.key_array()[0] == 10);
+	REQUIRE(m.value_array()[0] == 101);
+
+	REQUIRE(m.remove(10) == true);
+	REQUIRE(m.count() == 1);
+	REQUIRE_FALSE(m.contains(10));
+	REQUIRE(m.remove(10) == false);
+	REQUIRE(*m.get(20) == 200);
+
+	REQUIRE(m.remove(20) == true);
+	REQUIRE(m.count() == 0);
+}
+
+TEST_CASE("Dense_Hash_Map<int, int>: elements stay in insertion order, remove moves the last one into the hole")
+{
+	hstl::Dense_Hash_Map<int, int> m;
+
+	for (int i = 0; i < 100; ++i)
+		m.insert(i, i * 10);
+
+	REQUIRE(m.capacity() >= 128);
+
+	int expected = 0;
+	for (auto [key, value] : m)
+	{
+		REQUIRE(key == expected);
+		REQUIRE(value == expected * 10);
+		expected++;
+	}
+	REQUIRE(expected == 100);
+
+	// 99 takes the place of 3, then 98 takes the place of 0
+	REQUIRE(m.remove(3));
+	REQUIRE(m.key_array()[3] == 99);
+	REQUIRE(m.value_array()[3] == 990);
+	REQUIRE(m.remove(0));
+	REQUIRE(m.key_array()[0] == 98);
+
+	// Removing the last element moves nothing
+	REQUIRE(m.remove(97));
+	REQUIRE(m.count() == 97);
+	REQUIRE(m.key_array()[m.count() - 1] == 96);
+
+	// The index table follows the moved elements
+	for (int i = 0; i < 100; ++i)
+	{
+		bool removed = i == 0 || i == 3 || i == 97;
+		REQUIRE(m.contains(i) == (removed == false));
+		if (removed == false)
+			REQUIRE(*m.get(i) == i * 10);
+	}
+}
+
+TEST_CASE("Dense_Hash_Map<Key, int>: matches std::unordered_map with clustered hashes")
+{
+	hstl::Dense_Hash_Map<Key, int, KeyHash, KeyEq> m;
+	std::unordered_map<int, int> reference;
+
+	std::mt19937 rng{2024};
+
+	// Few distinct homes and fingerprints, so long clusters cross group boundaries and wrap around
+	auto make_key = [](int v)
+	{
+		size_t home = static_cast<size_t>(v % 37) * 61u;
+		size_t fingerprint = static_cast<size_t>(v % 3) << 57;
+
+		return K(v, home | fingerprint);
+	};
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		int v = static_cast<int>(rng() % 3000);
+		auto key = make_key(v);
+
+		switch (rng() % 3)
+		{
+		case 0:
+			m.insert(key, i);
+			reference[v] = i;
+			break;
+		case 1:
+			REQUIRE(m.remove(key) == (reference.erase(v) == 1));
+			break;
+		default:
+		{
+			auto it = reference.find(v);
+			auto value = m.get(key);
+
+			REQUIRE((value != nullptr) == (it != reference.end()));
+			if (value)
+				REQUIRE(*value == it->second);
+		}
+		}
+	}
+
+	REQUIRE(m.count() == reference.size());
+
+	// The packed arrays hold exactly the elements of the map
+	size_t visited = 0;
+	m.for_each([&](const Key& key, int value)
+	{
+		REQUIRE(reference.at(key.v) == value);
+		visited++;
+	});
+	REQUIRE(visited == reference.size());
+}
+
+TEST_CASE("Dense_Hash_Map<Str, int>: transparent lookups, try_emplace and get_or_insert_default")
+{
+	hstl::Dense_Hash_Map<hstl::Str, int> m;
+
+	m.insert("pelvis", 1);
+	m.insert(hstl::Str{ "spine" }, 2);
+
+	REQUIRE(*m.get("pelvis") == 1);
+	REQUIRE(*m.get(hstl::Str_View{ "spine" }) == 2);
+	REQUIRE(m.get("head") == nullptr);
+
+	auto [value, inserted] = m.try_emplace("head", 3);
+	REQUIRE(inserted);
+	REQUIRE(value == 3);
+
+	auto existing = m.try_emplace("head", 30);
+	REQUIRE(existing.inserted == false);
+	REQUIRE(existing.value == 3);
+
+	// Counting words
+	const char* words[] = { "a", "b", "a", "c", "a", "b" };
+	for (const char* word : words)
+		m.get_or_insert_default(word).value++;
+
+	REQUIRE(*m.get("a") == 3);
+	REQUIRE(*m.get("b") == 2);
+	REQUIRE(*m.get("c") == 1);
+
+	*m.get("a") = 7;
+	REQUIRE(*m.get("a") == 7);
+
+	REQUIRE(m.remove(hstl::Str_View{ "pelvis" }));
+	REQUIRE(m.count() == 5);
+	REQUIRE(m.key_array()[0].view() == hstl::Str_View{ "c" }); // The last key took the place of "pelvis"
+	REQUIRE(*m.get("spine") == 2);
+	REQUIRE(*m.get("c") == 1);
+}
+
+TEST_CASE("Dense_Hash_Map<int, int>: mutable iteration, reserve, clear and copies")
+{
+	hstl::Dense_Hash_Map<int, int> m{1000};
+
+	size_t capacity = m.capacity();
+	REQUIRE(capacity >= 1024);
+
+	for (int i = 0; i < 1000; ++i)
+		m.insert(i, i);
+
+	REQUIRE(m.capacity() == capacity);
+
+	for (auto entry : m)
+		entry.value *= 2;
+
+	m.for_each([](const int&, int& value) { value += 1; });
+
+	for (int i = 0; i < 1000; ++i)
+		REQUIRE(*m.get(i) == i * 2 + 1);
+
+	auto copy = m;
+	m.clear();
+
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.capacity() == capacity);
+	REQUIRE_FALSE(m.contains(5));
+	REQUIRE(m.begin() == m.end());
+
+	REQUIRE(copy.count() == 1000);
+	REQUIRE(*copy.get(999) == 1999);
+
+	m.insert(5, 50);
+	REQUIRE(*m.get(5) == 50);
+
+	auto moved = std::move(copy);
+	REQUIRE(moved.count() == 1000);
+	REQUIRE(*moved.get(0) == 1);
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Flat_Map.h>
+
+#include <string>
+#include <map>
+#include <random>
+
+TEST_CASE("Flat_Map<int, int>: insert/get/contains/remove")
+{
+	hstl::Flat_Map<int, int> m;
+
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.get(1) == nullptr);
+	REQUIRE_FALSE(m.remove(1));
+
+	m.insert(30, 300);
+	m.insert(10, 100);
+	m.insert(20, 200);
+
+	REQUIRE(m.count() == 3);
+	REQUIRE(m.contains(10));
+	REQUIRE(m.contains(20));
+	REQUIRE(m.contains(30));
+	REQUIRE_FALSE(m.contains(15));
+	REQUIRE_FALSE(m.contains(40));
+	REQUIRE_FALSE(m.contains(0));
+
+	REQUIRE(*m.get(20) == 200);
+
+	// Insert overwrite behavior
+	auto& r = m.insert(20, 201);
+	REQUIRE(r == 201);
+	REQUIRE(m.count() == 3);
+	REQUIRE(*m.get(20) == 201);
+
+	// Mutable get
+	*m.get(30) = 301;
+	REQUIRE(*m.get(30) == 301);
+
+	REQUIRE(m.remove(10));
+	REQUIRE_FALSE(m.contains(10));
+	REQUIRE(m.count() == 2);
+	REQUIRE_FALSE(m.remove(10));
+}
+
+TEST_CASE("Flat_Map<int, int>: iteration is ordered")
+{
+	hstl::Flat_Map<int, int> m;
+
+	for (int k : { 5, 3, 9, 1, 7 })
+		m.insert(k, k * 10);
+
+	int previous = -1;
+	size_t visited = 0;
+
+	for (auto entry : m)
+	{
+		REQUIRE(entry.key > previous);
+		REQUIRE(entry.value == entry.key * 10);
+		previous = entry.key;
+		++visited;
+	}
+
+	REQUIRE(visited == 5);
+}
+
+TEST_CASE("Flat_Map<int, Str>: bulk build sorts and keeps the last duplicate")
+{
+	hstl::Array<int> keys;
+	hstl::Array<std::string> values;
+
+	keys.push(3); values.push("three");
+	keys.push(1); values.push("one");
+	keys.push(3); values.push("three again");
+	keys.push(2); values.push("two");
+
+	hstl::Flat_Map<int, std::string> m{ std::move(keys), std::move(values) };
+
+	REQUIRE(m.count() == 3);
+	REQUIRE(m.key_array()[0] == 1);
+	REQUIRE(m.key_array()[1] == 2);
+	REQUIRE(m.key_array()[2] == 3);
+	REQUIRE(*m.get(3) == "three again");
+	REQUIRE(*m.get(1) == "one");
+}
+
+TEST_CASE("Flat_Map: matches std::map under random operations")
+{
+	hstl::Flat_Map<uint32_t, uint32_t> m;
+	std::map<uint32_t, uint32_t> reference;
+
+	std::mt19937 rng{99};
+
+	for (int i = 0; i < 5000; ++i)
+	{
+		uint32_t key = rng() % 512;
+		uint32_t op = rng() % 3;
+
+		if (op == 0)
+		{
+			m.insert(key, static_cast<uint32_t>(i));
+			reference[key] = static_cast<uint32_t>(i);
+		}
+		else if (op == 1)
+		{
+			REQUIRE(m.remove(key) == (reference.erase(key) == 1));
+		}
+		else
+		{
+			auto it = reference.find(key);
+			auto value = m.get(key);
+
+			REQUIRE((value != nullptr) == (it != reference.end()));
+			if (value)
+				REQUIRE(*value == it->second);
+		}
+	}
+
+	REQUIRE(m.count() == reference.size());
+
+	auto it = reference.begin();
+	for (auto entry : m)
+	{
+		REQUIRE(entry.key == it->first);
+		REQUIRE(entry.value == it->second);
+		++it;
+	}
+}
+
+TEST_CASE("Flat_Map: custom ordering")
+{
+	hstl::Flat_Map<int, int, std::greater<int>> m;
+
+	m.insert(1, 1);
+	m.insert(3, 3);
+	m.insert(2, 2);
+
+	REQUIRE(m.key_array()[0] == 3);
+	REQUIRE(m.key_array()[2] == 1);
+	REQUIRE(*m.get(2) == 2);
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Flat_Set.h>
+
+#include <string>
+#include <set>
+#include <random>
+
+TEST_CASE("Flat_Set<int>: insert/get/contains/remove")
+{
+	hstl::Flat_Set<int> s;
+
+	REQUIRE(s.count() == 0);
+	REQUIRE_FALSE(s.contains(1));
+
+	s.insert(3);
+	s.insert(1);
+	s.insert(2);
+	s.insert(2); // duplicate
+
+	REQUIRE(s.count() == 3);
+	REQUIRE(s.contains(1));
+	REQUIRE(s.contains(2));
+	REQUIRE(s.contains(3));
+	REQUIRE_FALSE(s.contains(4));
+	REQUIRE(*s.get(2) == 2);
+
+	REQUIRE(s.remove(2));
+	REQUIRE_FALSE(s.contains(2));
+	REQUIRE_FALSE(s.remove(2));
+	REQUIRE(s.count() == 2);
+}
+
+TEST_CASE("Flat_Set<std::string>: bulk build sorts and drops duplicates")
+{
+	hstl::Array<std::string> values;
+	values.push("pelvis");
+	values.push("head");
+	values.push("spine");
+	values.push("head");
+	values.push("arm");
+
+	hstl::Flat_Set<std::string> s{ std::move(values) };
+
+	REQUIRE(s.count() == 4);
+
+	const char* expected[] = { "arm", "head", "pelvis", "spine" };
+	size_t i = 0;
+
+	for (const auto& value : s)
+		REQUIRE(value == expected[i++]);
+
+	REQUIRE(s.contains("spine"));
+	REQUIRE_FALSE(s.contains("leg"));
+}
+
+TEST_CASE("Flat_Set: matches std::set under random operations")
+{
+	hstl::Flat_Set<int> s;
+	std::set<int> reference;
+
+	std::mt19937 rng{7};
+
+	for (int i = 0; i < 5000; ++i)
+	{
+		int key = static_cast<int>(rng() % 300);
+
+		if (rng() % 2 == 0)
+		{
+			s.insert(key);
+			reference.insert(key);
+		}
+		else
+		{
+			REQUIRE(s.remove(key) == (reference.erase(key) == 1));
+		}
+
+		REQUIRE(s.contains(key) == (reference.count(key) == 1));
+	}
+
+	REQUIRE(s.count() == reference.size());
+	REQUIRE(std::equal(s.begin(), s.end(), reference.begin()));
+}
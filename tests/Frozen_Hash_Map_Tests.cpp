@@ -0,0 +1,219 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Frozen_Hash_Map.h>
+#include <Mapped_File.h>
+#include <Str.h>
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+	struct Asset_Entry {
+		uint64_t offset;
+		uint32_t size;
+		uint32_t flags;
+	};
+
+	struct Cell {
+		int32_t x, y, z;
+	};
+
+	std::vector<std::string> asset_names(size_t count)
+	{
+		std::vector<std::string> names;
+
+		for (size_t i = 0; i < count; ++i)
+			names.push_back("textures/props/asset_" + std::to_string(i * 7919u) + ".dds");
+
+		return names;
+	}
+
+} // namespace
+
+TEST_CASE("Frozen_Hash_Map<uint64_t, uint32_t>: every key finds its value, missing keys don't")
+{
+	using Map = hstl::Frozen_Hash_Map<uint64_t, uint32_t>;
+
+	for (size_t count : { 0u, 1u, 2u, 3u, 5u, 64u, 1000u, 50000u })
+	{
+		std::vector<uint64_t> keys;
+		std::vector<uint32_t> values;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys.push_back(i * 0x9E3779B97F4A7C15ull);
+			values.push_back(static_cast<uint32_t>(i));
+		}
+
+		auto blob = Map::build(keys.data(), values.data(), count);
+		REQUIRE(blob);
+
+		auto map = Map::view(blob.get_value().buffer(), blob.get_value().size());
+		REQUIRE(map);
+
+		Map& frozen = map.get_value();
+		REQUIRE(frozen.count() == count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			REQUIRE(frozen.get(keys[i]) != nullptr);
+			REQUIRE(*frozen.get(keys[i]) == i);
+		}
+
+		for (size_t i = 0; i < 1000; ++i)
+			REQUIRE_FALSE(frozen.contains(i * 0x9E3779B97F4A7C15ull + 1u));
+
+		// Minimal: every slot holds one of the keys
+		size_t seen = 0;
+		uint64_t sum = 0;
+		frozen.for_each([&](uint64_t, const uint32_t& value) { seen++; sum += value; });
+		REQUIRE(seen == count);
+		REQUIRE(sum == (count > 0 ? count * (count - 1) / 2 : 0));
+	}
+
+	REQUIRE(Map{}.get(1u) == nullptr);
+}
+
+TEST_CASE("Frozen_Hash_Map<Str_View, Asset_Entry>: round trip through a memory mapped file")
+{
+	using Map = hstl::Frozen_Hash_Map<hstl::Str_View, Asset_Entry>;
+
+	std::vector<std::string> names = asset_names(5000);
+	names.push_back(""); // The empty string is a key like any other
+
+	std::vector<hstl::Str_View> keys;
+	std::vector<Asset_Entry> values;
+
+	for (size_t i = 0; i < names.size(); ++i)
+	{
+		keys.push_back(hstl::Str_View{ names[i].data(), names[i].size() });
+		values.push_back(Asset_Entry{ i * 4096u, static_cast<uint32_t>(i), 7u });
+	}
+
+	auto blob = Map::build(keys.data(), values.data(), keys.size());
+	REQUIRE(blob);
+
+	const char* path = "Frozen_Hash_Map_Tests.bin";
+	FILE* file = fopen(path, "wb");
+	REQUIRE(file != nullptr);
+	REQUIRE(fwrite(blob.get_value().buffer(), 1, blob.get_value().size(), file) == blob.get_value().size());
+	fclose(file);
+
+	{
+		auto mapped = hstl::Mapped_File::open(path);
+		REQUIRE(mapped);
+
+		hstl::Mapped_File file_view = std::move(mapped.get_value());
+		REQUIRE(file_view.size() == blob.get_value().size());
+
+		auto map = Map::view(file_view.data(), file_view.size());
+		REQUIRE(map);
+
+		Map frozen = map.get_value();
+		REQUIRE(frozen.count() == names.size());
+
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			const Asset_Entry* entry = frozen.get(names[i].c_str());
+			REQUIRE(entry != nullptr);
+			REQUIRE(entry->offset == i * 4096u);
+			REQUIRE(entry->size == i);
+		}
+
+		REQUIRE(frozen.get("textures/props/asset_1.dds") == nullptr);
+		REQUIRE(frozen.get("textures/props/asset_0.dd") == nullptr);
+		REQUIRE(frozen.get("a completely different name that is long enough to take the long hash path") == nullptr);
+
+		size_t seen = 0;
+		frozen.for_each([&](hstl::Str_View key, const Asset_Entry& entry)
+		{
+			seen++;
+			REQUIRE(key == keys[entry.size]);
+		});
+		REQUIRE(seen == names.size());
+	}
+
+	remove(path);
+
+	REQUIRE_FALSE(hstl::Mapped_File::open("Frozen_Hash_Map_Tests_missing.bin"));
+}
+
+TEST_CASE("Frozen_Hash_Map: duplicate keys, struct keys and seeds")
+{
+	std::vector<Cell> cells;
+	std::vector<int> values;
+
+	for (int32_t x = 0; x < 20; ++x)
+		for (int32_t y = 0; y < 20; ++y)
+		{
+			cells.push_back(Cell{ x, y, -x });
+			values.push_back(x * 100 + y);
+		}
+
+	using Map = hstl::Frozen_Hash_Map<Cell, int>;
+
+	for (uint64_t seed : { 0ull, 1ull, 0xDEADBEEFull })
+	{
+		auto blob = Map::build(cells.data(), values.data(), cells.size(), seed);
+		REQUIRE(blob);
+
+		auto map = Map::view(blob.get_value().buffer(), blob.get_value().size());
+		REQUIRE(map);
+
+		for (size_t i = 0; i < cells.size(); ++i)
+			REQUIRE(*map.get_value().get(cells[i]) == values[i]);
+
+		REQUIRE(map.get_value().get(Cell{ 1, 2, 3 }) == nullptr);
+	}
+
+	cells.push_back(cells[123]);
+	values.push_back(-1);
+
+	auto duplicate = Map::build(cells.data(), values.data(), cells.size());
+	REQUIRE_FALSE(duplicate);
+	REQUIRE(duplicate.get_err() == "Frozen_Hash_Map: duplicate key");
+}
+
+TEST_CASE("Frozen_Hash_Map: view() rejects blobs it can't serve")
+{
+	using Map = hstl::Frozen_Hash_Map<uint32_t, uint32_t>;
+
+	std::vector<uint32_t> keys = { 10, 20, 30, 40, 50 };
+	std::vector<uint32_t> values = { 1, 2, 3, 4, 5 };
+
+	auto blob = Map::build(keys.data(), values.data(), keys.size());
+	REQUIRE(blob);
+
+	hstl::Array<uint8_t>& bytes = blob.get_value();
+
+	REQUIRE(Map::view(bytes.buffer(), bytes.size()));
+	REQUIRE_FALSE(Map::view(nullptr, 0));
+	REQUIRE_FALSE(Map::view(bytes.buffer(), 16));
+	REQUIRE_FALSE(Map::view(bytes.buffer(), bytes.size() - 8)); // Truncated
+
+	// Built for other types
+	REQUIRE_FALSE(hstl::Frozen_Hash_Map<uint64_t, uint32_t>::view(bytes.buffer(), bytes.size()));
+	REQUIRE_FALSE(hstl::Frozen_Hash_Map<uint32_t, uint64_t>::view(bytes.buffer(), bytes.size()));
+	REQUIRE_FALSE(hstl::Frozen_Hash_Map<hstl::Str_View, uint32_t>::view(bytes.buffer(), bytes.size()));
+
+	// Misaligned
+	std::vector<uint64_t> shifted((bytes.size() + 16) / 8);
+	memcpy(reinterpret_cast<uint8_t*>(shifted.data()) + 4, bytes.buffer(), bytes.size());
+	REQUIRE_FALSE(Map::view(reinterpret_cast<uint8_t*>(shifted.data()) + 4, bytes.size()));
+
+	// Corrupted magic, then a section pointing past the end
+	hstl::Array<uint8_t> corrupted = bytes;
+	corrupted[0] ^= 0xFFu;
+	REQUIRE_FALSE(Map::view(corrupted.buffer(), corrupted.size()));
+
+	corrupted = bytes;
+	hstl::detail::Frozen_Header header;
+	memcpy(&header, corrupted.buffer(), sizeof(header));
+	header.values_offset = header.size;
+	memcpy(corrupted.buffer(), &header, sizeof(header));
+	REQUIRE_FALSE(Map::view(corrupted.buffer(), corrupted.size()));
+}
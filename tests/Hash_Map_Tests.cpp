@@ -1,6 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <Hash_Map.h>
+#include <Str.h>
+
+#include <unordered_map>
+#include <random>
+#include <cstdio>
+#include <utility>
 
 namespace {
 
@@ -150,7 +156,7 @@ TEST_CASE("Hash_Map<Key, int>: remove back-shifts inside a cluster (no wrap)")
 
 TEST_CASE("Hash_Map<Key, int>: remove back-shifts across wrap-around")
 {
-	hstl::Hash_Map<Key, int, KeyHash, KeyEq> m;
+	hstl::Hash_Map<Key, int, KeyHash, KeyEq> m{ 64 };
 
 	const size_t cap = m.capacity();
 	REQUIRE(cap >= 4);
@@ -198,13 +204,13 @@ TEST_CASE("Hash_Map<Key, int>: remove back-shifts across wrap-around")
 
 TEST_CASE("Hash_Map<Key, int>: rehash preserves all elements")
 {
-	hstl::Hash_Map<Key, int, KeyHash, KeyEq> m;
+	hstl::Hash_Map<Key, int, KeyHash, KeyEq> m{ 1000 };
 
 	const size_t cap0 = m.capacity();
 	REQUIRE(cap0 > 0);
 
 	// Trigger the rehash by exceeding the load threshold.
-	const size_t threshold = static_cast<size_t>(0.7f * static_cast<float>(cap0));
+	const size_t threshold = static_cast<size_t>(0.875f * static_cast<float>(cap0));
 
 	const size_t N = threshold + 50;
 
@@ -364,4 +370,1186 @@ TEST_CASE("Hash_Map<int, Tracker>: Move Semantics")
 		REQUIRE(Tracker::copy_count == 0);
 		REQUIRE(Tracker::move_count == 0);
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Hash_Map<Key, int>: group probing matches std::unordered_map with clustered hashes")
+{
+	hstl::Hash_Map<Key, int, KeyHash, KeyEq> m;
+	std::unordered_map<int, int> reference;
+
+	std::mt19937 rng{2024};
+
+	// Few distinct homes and fingerprints, so long clusters cross group boundaries and wrap around
+	auto make_key = [](int v)
+	{
+		size_t home = static_cast<size_t>(v % 37) * 61u;
+		size_t fingerprint = static_cast<size_t>(v % 3) << 57;
+
+		return K(v, home | fingerprint);
+	};
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		int v = static_cast<int>(rng() % 3000);
+		auto key = make_key(v);
+
+		switch (rng() % 3)
+		{
+		case 0:
+			m.insert(key, i);
+			reference[v] = i;
+			break;
+		case 1:
+			REQUIRE(m.remove(key) == (reference.erase(v) == 1));
+			break;
+		default:
+		{
+			auto it = reference.find(v);
+			auto value = m.get(key);
+
+			REQUIRE((value != nullptr) == (it != reference.end()));
+			if (value)
+				REQUIRE(*value == it->second);
+		}
+		}
+	}
+
+	REQUIRE(m.count() == reference.size());
+
+	for (auto [v, value] : reference)
+		REQUIRE(*m.get(make_key(v)) == value);
+}
+
+namespace {
+
+	// Counts how many keys get built so the tests can tell whether a lookup allocated one
+	struct Named {
+		hstl::Str name;
+
+		static int constructions;
+
+		Named(const char* c_str) : name(c_str) { constructions++; }
+		Named(const Named& other) : name(other.name) { constructions++; }
+		Named(Named&&) noexcept = default;
+		Named& operator=(Named&&) noexcept = default;
+	};
+
+	int Named::constructions = 0;
+
+	struct Named_Hash {
+		using is_transparent = void;
+
+		size_t operator()(const Named& n) const { return hstl::Str_Hash{}(n.name); }
+		size_t operator()(const char* c_str) const { return hstl::Str_Hash{}(c_str); }
+	};
+
+	struct Named_Eq {
+		using is_transparent = void;
+
+		bool operator()(const Named& a, const Named& b) const { return hstl::Str_Equal{}(a.name, b.name); }
+		bool operator()(const char* a, const Named& b) const { return hstl::Str_Equal{}(a, b.name); }
+	};
+
+} // namespace
+
+TEST_CASE("Hash_Map<Str, int>: transparent lookup with Str_View and string literals")
+{
+	hstl::Hash_Map<hstl::Str, int, hstl::Str_Hash, hstl::Str_Equal> m;
+
+	m.insert("pelvis", 1);
+	m.insert(hstl::Str{ "spine" }, 2);
+	m.insert(hstl::Str_View{ "head" }.data(), 3);
+
+	REQUIRE(m.count() == 3);
+
+	REQUIRE(*m.get("pelvis") == 1);
+	REQUIRE(*m.get(hstl::Str_View{ "spine" }) == 2);
+	REQUIRE(*m.get(hstl::Str{ "head" }) == 3);
+	REQUIRE(m.get("arm") == nullptr);
+
+	// A view into a bigger buffer, not null-terminated at the key
+	const char* buffer = "spine.001";
+	REQUIRE(m.contains(hstl::Str_View{ buffer, 5 }));
+	REQUIRE_FALSE(m.contains(hstl::Str_View{ buffer, 6 }));
+
+	m.insert(hstl::Str_View{ "pelvis" }.data(), 10); // overwrite through a different type
+	REQUIRE(m.count() == 3);
+	REQUIRE(*m.get("pelvis") == 10);
+
+	REQUIRE(m.remove(hstl::Str_View{ "spine" }));
+	REQUIRE_FALSE(m.contains("spine"));
+	REQUIRE(m.count() == 2);
+}
+
+TEST_CASE("Hash_Map: transparent lookups and overwrites never build a key")
+{
+	hstl::Hash_Map<Named, int, Named_Hash, Named_Eq> m;
+
+	Named::constructions = 0;
+
+	m.insert("a", 1);
+	m.insert("b", 2);
+	REQUIRE(Named::constructions == 2);
+
+	m.insert("a", 3); // overwrite
+	REQUIRE(m.contains("a"));
+	REQUIRE(*m.get("b") == 2);
+	REQUIRE_FALSE(m.contains("c"));
+	REQUIRE(m.remove("b"));
+	REQUIRE_FALSE(m.remove("b"));
+
+	REQUIRE(Named::constructions == 2);
+	REQUIRE(*m.get("a") == 3);
+}
+
+TEST_CASE("Hash_Map<int, int>: lazy allocation, reserve and shrink_to_fit")
+{
+	hstl::Hash_Map<int, int> m;
+
+	// Nothing is allocated until the first insert
+	REQUIRE(m.capacity() == 0);
+	REQUIRE(m.get(1) == nullptr);
+	REQUIRE_FALSE(m.remove(1));
+	REQUIRE(m.begin() == m.end());
+
+	m.insert(1, 10);
+	REQUIRE(m.capacity() > 0);
+	REQUIRE(m.capacity() <= 16);
+	REQUIRE(*m.get(1) == 10);
+
+	// reserve sizes the table once, filling it up to the reserved count doesn't grow it
+	hstl::Hash_Map<int, int> reserved{ 1000 };
+	const size_t cap = reserved.capacity();
+	REQUIRE(cap >= 1000);
+	REQUIRE(cap <= 2048);
+
+	for (int i = 0; i < 1000; ++i)
+		reserved.insert(i, i);
+
+	REQUIRE(reserved.capacity() == cap);
+
+	// reserving less than what's there is a no-op
+	reserved.reserve(10);
+	REQUIRE(reserved.capacity() == cap);
+
+	for (int i = 0; i < 990; ++i)
+		REQUIRE(reserved.remove(i));
+
+	reserved.shrink_to_fit();
+	REQUIRE(reserved.capacity() == 16);
+	REQUIRE(reserved.count() == 10);
+
+	for (int i = 990; i < 1000; ++i)
+		REQUIRE(*reserved.get(i) == i);
+
+	for (int i = 990; i < 1000; ++i)
+		REQUIRE(reserved.remove(i));
+
+	reserved.shrink_to_fit();
+	REQUIRE(reserved.capacity() == 0);
+
+	// Still usable after dropping the table
+	reserved.insert(5, 50);
+	REQUIRE(*reserved.get(5) == 50);
+}
+
+TEST_CASE("Hash_Map<int, int>: moved-from and copied empty maps are usable")
+{
+	hstl::Hash_Map<int, int> a;
+	a.insert(1, 1);
+
+	hstl::Hash_Map<int, int> b{ std::move(a) };
+	REQUIRE(a.count() == 0);
+
+	a.insert(2, 2);
+	REQUIRE(*a.get(2) == 2);
+
+	hstl::Hash_Map<int, int> empty;
+	hstl::Hash_Map<int, int> copy{ empty };
+	REQUIRE(copy.capacity() == 0);
+
+	copy.insert(3, 3);
+	REQUIRE(*copy.get(3) == 3);
+
+	copy = empty;
+	REQUIRE(copy.count() == 0);
+	REQUIRE_FALSE(copy.contains(3));
+}
+
+namespace {
+
+	struct Counting_Str_Hash {
+		using is_transparent = void;
+
+		static int calls;
+
+		template<typename S>
+		size_t operator()(const S& s) const { calls++; return hstl::Str_Hash{}(s); }
+	};
+
+	int Counting_Str_Hash::calls = 0;
+
+	struct No_Stored_Hash : hstl::Hash_Map_Options<hstl::Str, int> {
+		static constexpr bool STORE_HASH = false;
+	};
+
+	struct Stored_Hash : hstl::Hash_Map_Options<Key, int> {
+		static constexpr bool STORE_HASH = true;
+	};
+
+} // namespace
+
+TEST_CASE("Hash_Map<Str, int>: stored hashes, growing and removing never rehash keys")
+{
+	hstl::Hash_Map<hstl::Str, int, Counting_Str_Hash, hstl::Str_Equal> m;
+
+	Counting_Str_Hash::calls = 0;
+
+	constexpr int N = 2000;
+	char name[32];
+
+	for (int i = 0; i < N; ++i)
+	{
+		snprintf(name, sizeof(name), "bone_%d", i);
+		m.insert(hstl::Str{ name }, i);
+	}
+
+	// One hash per insert even though the table grew several times
+	REQUIRE(Counting_Str_Hash::calls == N);
+
+	for (int i = 0; i < N; i += 2)
+	{
+		snprintf(name, sizeof(name), "bone_%d", i);
+		REQUIRE(m.remove(hstl::Str_View{ name }));
+	}
+
+	// One hash per remove, the backward shift reads the stored ones
+	REQUIRE(Counting_Str_Hash::calls == N + N / 2);
+
+	for (int i = 0; i < N; ++i)
+	{
+		snprintf(name, sizeof(name), "bone_%d", i);
+		REQUIRE(m.contains(hstl::Str_View{ name }) == (i % 2 == 1));
+	}
+
+	// Copies keep the stored hashes
+	auto copy = m;
+	copy.insert("bone_0", 0);
+	REQUIRE(copy.count() == N / 2 + 1);
+	REQUIRE(*copy.get("bone_1") == 1);
+}
+
+TEST_CASE("Hash_Map: STORE_HASH can be forced either way through the options")
+{
+	hstl::Hash_Map<hstl::Str, int, Counting_Str_Hash, hstl::Str_Equal, No_Stored_Hash> without;
+
+	Counting_Str_Hash::calls = 0;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "key_%d", i);
+		without.insert(name, i);
+	}
+
+	// Without stored hashes growing from 16 slots rehashes the keys that were there
+	REQUIRE(Counting_Str_Hash::calls > 100);
+	REQUIRE(*without.get("key_42") == 42);
+
+	hstl::Hash_Map<Key, int, KeyHash, KeyEq, Stored_Hash> with;
+
+	for (int i = 0; i < 50; ++i)
+		with.insert(K(i, static_cast<size_t>(i % 5)), i);
+
+	for (int i = 0; i < 50; i += 3)
+		REQUIRE(with.remove(K(i, static_cast<size_t>(i % 5))));
+
+	for (int i = 0; i < 50; ++i)
+		REQUIRE(with.contains(K(i, static_cast<size_t>(i % 5))) == (i % 3 != 0));
+}
+
+namespace {
+
+	struct Incremental : hstl::Hash_Map_Options<Key, int> {
+		static constexpr bool INCREMENTAL_REHASH = true;
+	};
+
+	struct Incremental_Stored : Incremental {
+		static constexpr bool STORE_HASH = true;
+	};
+
+	struct Incremental_Split : Incremental {
+		static constexpr bool SPLIT_SLOTS = true;
+	};
+
+	struct Incremental_Int : hstl::Hash_Map_Options<int, int> {
+		static constexpr bool INCREMENTAL_REHASH = true;
+	};
+
+	struct Incremental_Str : hstl::Hash_Map_Options<hstl::Str, int> {
+		static constexpr bool INCREMENTAL_REHASH = true;
+	};
+
+	template<typename Options>
+	void check_incremental_against_reference()
+	{
+		hstl::Hash_Map<Key, int, KeyHash, KeyEq, Options> m;
+		std::unordered_map<int, int> reference;
+
+		std::mt19937 rng{77};
+
+		// Clustered like above so that removes in the old table hit long probe sequences
+		auto make_key = [](int v)
+		{
+			size_t home = static_cast<size_t>(v % 53) * 29u;
+			size_t fingerprint = static_cast<size_t>(v % 5) << 57;
+
+			return K(v, home | fingerprint);
+		};
+
+		bool saw_rehash = false;
+
+		for (int i = 0; i < 40000; ++i)
+		{
+			int v = static_cast<int>(rng() % 6000);
+			auto key = make_key(v);
+
+			// Mostly inserts so the map keeps growing through several migrations
+			switch (rng() % 5)
+			{
+			case 0:
+			case 1:
+			case 2:
+				m.insert(key, i);
+				reference[v] = i;
+				break;
+			case 3:
+				REQUIRE(m.remove(key) == (reference.erase(v) == 1));
+				break;
+			default:
+			{
+				auto it = reference.find(v);
+				auto value = m.get(key);
+
+				REQUIRE((value != nullptr) == (it != reference.end()));
+				if (value)
+					REQUIRE(*value == it->second);
+			}
+			}
+
+			if (m.is_rehashing())
+			{
+				saw_rehash = true;
+
+				// Iteration covers both tables while the migration runs
+				if (i % 97 == 0)
+				{
+					size_t seen = 0;
+
+					for (const auto& entry : m)
+					{
+						REQUIRE(reference.at(entry.key.v) == entry.value);
+						seen++;
+					}
+
+					REQUIRE(seen == reference.size());
+				}
+			}
+
+			REQUIRE(m.count() == reference.size());
+		}
+
+		REQUIRE(saw_rehash);
+
+		for (auto [v, value] : reference)
+			REQUIRE(*m.get(make_key(v)) == value);
+	}
+
+} // namespace
+
+TEST_CASE("Hash_Map: incremental rehash matches std::unordered_map")
+{
+	check_incremental_against_reference<Incremental>();
+	check_incremental_against_reference<Incremental_Stored>();
+	check_incremental_against_reference<Incremental_Split>();
+}
+
+TEST_CASE("Hash_Map: incremental rehash keeps two tables until they are drained")
+{
+	hstl::Hash_Map<int, int> plain;
+	plain.insert(1, 1);
+	REQUIRE(plain.step() == false);
+
+	hstl::Hash_Map<int, int, hstl::Hash<int>, hstl::Equal_To<int>, Incremental_Int> m{1000};
+	size_t capacity = m.capacity();
+
+	int i = 0;
+	while (m.capacity() == capacity)
+	{
+		m.insert(i, i);
+		i++;
+	}
+
+	// Growing only allocated the new table, the elements move over a step at a time
+	REQUIRE(m.is_rehashing());
+	REQUIRE(m.capacity() == capacity * 2);
+
+	for (int k = 0; k < i; ++k)
+		REQUIRE(*m.get(k) == k);
+
+	// Removes and overwrites reach the elements still waiting in the old table
+	REQUIRE(m.remove(i - 1));
+	REQUIRE(m.get(i - 1) == nullptr);
+	m.insert(i - 2, -1);
+	REQUIRE(*m.get(i - 2) == -1);
+
+	// A copy taken mid-migration gets a single table
+	auto copy = m;
+	REQUIRE(copy.is_rehashing() == false);
+	REQUIRE(copy.count() == m.count());
+
+	size_t steps = 0;
+	while (m.step())
+		steps++;
+
+	REQUIRE(steps > 0);
+	REQUIRE(steps <= capacity / decltype(m)::REHASH_STEP);
+	REQUIRE(m.is_rehashing() == false);
+	REQUIRE(m.count() == static_cast<size_t>(i - 1));
+
+	for (int k = 0; k < i - 1; ++k)
+	{
+		REQUIRE(*m.get(k) == (k == i - 2 ? -1 : k));
+		REQUIRE(*copy.get(k) == (k == i - 2 ? -1 : k));
+	}
+
+	// reserve() finishes a migration in one go
+	while (m.is_rehashing() == false)
+		m.insert(i++, 0);
+
+	m.reserve(m.capacity() * 2);
+	REQUIRE(m.is_rehashing() == false);
+	REQUIRE(m.count() == static_cast<size_t>(i - 1));
+}
+
+TEST_CASE("Hash_Map<Str, int>: incremental rehash with non-trivial keys, moves and teardown mid-migration")
+{
+	hstl::Hash_Map<hstl::Str, int, hstl::Hash<hstl::Str>, hstl::Equal_To<hstl::Str>, Incremental_Str> m;
+
+	char name[48];
+	int i = 0;
+
+	while (m.is_rehashing() == false || m.count() < 3000)
+	{
+		snprintf(name, sizeof(name), "entity_with_a_long_name_%d", i);
+		m.insert(name, i++);
+	}
+
+	// A few removes only, each one migrates REHASH_STEP slots and the old table must stay alive
+	auto removed = [](int k) { return k % 3 == 0 && k < 90; };
+
+	for (int k = 0; k < 90; k += 3)
+	{
+		snprintf(name, sizeof(name), "entity_with_a_long_name_%d", k);
+		REQUIRE(m.remove(hstl::Str_View{ name }));
+	}
+
+	REQUIRE(m.is_rehashing());
+
+	auto moved = std::move(m);
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.is_rehashing() == false);
+	REQUIRE(moved.is_rehashing());
+
+	size_t seen = 0;
+	for (const auto& entry : moved)
+	{
+		REQUIRE(removed(entry.value) == false);
+		seen++;
+	}
+	REQUIRE(seen == moved.count());
+	REQUIRE(seen == static_cast<size_t>(i - 30));
+
+	for (int k = 0; k < i; ++k)
+	{
+		snprintf(name, sizeof(name), "entity_with_a_long_name_%d", k);
+		REQUIRE(moved.contains(name) == (removed(k) == false));
+	}
+
+	m = moved;
+	REQUIRE(m.count() == moved.count());
+
+	// "moved" is destroyed with both of its tables alive
+}
+
+TEST_CASE("Hash_Map: try_emplace and get_or_insert_default hash once and only build values on a miss")
+{
+	hstl::Hash_Map<hstl::Str, Tracker, Counting_Str_Hash, hstl::Str_Equal> m;
+
+	Counting_Str_Hash::calls = 0;
+	Tracker::copy_count = 0;
+	Tracker::move_count = 0;
+
+	auto [value, inserted] = m.try_emplace("a", 7);
+	REQUIRE(inserted);
+	REQUIRE(value.id == 7);
+
+	// A hit neither builds nor overwrites the value
+	auto [existing, inserted_again] = m.try_emplace("a", 8);
+	REQUIRE(inserted_again == false);
+	REQUIRE(existing.id == 7);
+	REQUIRE(&existing == &value);
+
+	REQUIRE(Counting_Str_Hash::calls == 2);
+	REQUIRE(Tracker::copy_count == 0);
+
+	auto result = m.get_or_insert_default("b");
+	REQUIRE(result.inserted);
+	REQUIRE(result.value.id == 0);
+
+	result.value.id = 3;
+	REQUIRE(m.get_or_insert_default("b").inserted == false);
+	REQUIRE(Counting_Str_Hash::calls == 4);
+	REQUIRE(m.get("b")->id == 3);
+	REQUIRE(Tracker::copy_count == 0);
+	REQUIRE(m.count() == 2);
+}
+
+TEST_CASE("Hash_Map<Str, int>: counting words with get_or_insert_default and the mutable get")
+{
+	hstl::Hash_Map<hstl::Str, int> counts;
+
+	const char* words[] = { "the", "cat", "the", "hat", "the", "cat" };
+
+	for (const char* word : words)
+		counts.get_or_insert_default(word).value++;
+
+	REQUIRE(counts.count() == 3);
+	REQUIRE(*counts.get("the") == 3);
+	REQUIRE(*counts.get("cat") == 2);
+	REQUIRE(*counts.get("hat") == 1);
+
+	// Mutable get updates in place and never inserts
+	*counts.get("hat") += 10;
+	REQUIRE(*counts.get("hat") == 11);
+	REQUIRE(counts.get("dog") == nullptr);
+	REQUIRE(counts.count() == 3);
+
+	// Non-transparent keys take the same paths
+	hstl::Hash_Map<int, Tracker> by_id;
+	REQUIRE(by_id.try_emplace(1, 5).inserted);
+	REQUIRE(by_id.try_emplace(1, 6).value.id == 5);
+	by_id.get(1)->id = 9;
+	REQUIRE(by_id.get(1)->id == 9);
+	REQUIRE(by_id.get(2) == nullptr);
+}
+
+TEST_CASE("Hash_Map: try_emplace during an incremental rehash finds the elements left in the old table")
+{
+	hstl::Hash_Map<int, int, hstl::Hash<int>, hstl::Equal_To<int>, Incremental_Int> m;
+
+	int i = 0;
+	while (m.is_rehashing() == false)
+	{
+		REQUIRE(m.try_emplace(i, i).inserted);
+		i++;
+	}
+
+	for (int k = 0; k < i; ++k)
+	{
+		auto [value, inserted] = m.try_emplace(k, -1);
+		REQUIRE(inserted == false);
+		REQUIRE(value == k);
+	}
+
+	REQUIRE(m.count() == static_cast<size_t>(i));
+}
+
+TEST_CASE("Hash_Map<int, int>: get_many, contains_many and insert_many match single calls")
+{
+	hstl::Hash_Map<int, int> m;
+
+	// Empty map, nothing to prefetch
+	int probe_keys[37];
+	const int* values[37];
+	bool found[37];
+
+	for (int i = 0; i < 37; ++i)
+		probe_keys[i] = i * 3;
+
+	m.get_many(probe_keys, 37, values);
+	REQUIRE(m.contains_many(probe_keys, 37, found) == 0);
+
+	for (int i = 0; i < 37; ++i)
+	{
+		REQUIRE(values[i] == nullptr);
+		REQUIRE(found[i] == false);
+	}
+
+	// A count that isn't a whole number of batches, with a duplicated key whose last value wins
+	hstl::Array<int> keys;
+	hstl::Array<int> inserted;
+
+	for (int i = 0; i < 1001; ++i)
+	{
+		keys.push(i * 2);
+		inserted.push(i);
+	}
+
+	keys[1000] = 0;
+
+	m.insert_many(keys.buffer(), inserted.buffer(), keys.size());
+	REQUIRE(m.count() == 1000);
+	REQUIRE(*m.get(0) == 1000);
+
+	hstl::Array<int> queries;
+
+	for (int i = 0; i < 3000; ++i)
+		queries.push(i);
+
+	hstl::Array<const int*> results{queries.size()};
+	hstl::Array<bool> contained{queries.size()};
+
+	m.get_many(queries.buffer(), queries.size(), results.buffer());
+	size_t hits = m.contains_many(queries.buffer(), queries.size(), contained.buffer());
+
+	REQUIRE(hits == 1000);
+
+	for (size_t i = 0; i < queries.size(); ++i)
+	{
+		REQUIRE(results[i] == m.get(queries[i]));
+		REQUIRE(contained[i] == m.contains(queries[i]));
+	}
+}
+
+TEST_CASE("Hash_Map<Str, int>: get_many with transparent keys and during an incremental rehash")
+{
+	hstl::Hash_Map<hstl::Str, int> names;
+	names.insert("left_hand", 1);
+	names.insert("right_hand", 2);
+
+	hstl::Str_View views[] = { "left_hand", "head", "right_hand" };
+	const int* values[3];
+
+	names.get_many(views, 3, values);
+	REQUIRE(*values[0] == 1);
+	REQUIRE(values[1] == nullptr);
+	REQUIRE(*values[2] == 2);
+
+	hstl::Hash_Map<int, int, hstl::Hash<int>, hstl::Equal_To<int>, Incremental_Int> m;
+
+	int count = 0;
+	while (m.is_rehashing() == false)
+	{
+		m.insert(count, count);
+		count++;
+	}
+
+	hstl::Array<int> queries;
+	for (int i = 0; i < count + 50; ++i)
+		queries.push(i);
+
+	hstl::Array<const int*> results{queries.size()};
+	m.get_many(queries.buffer(), queries.size(), results.buffer());
+
+	for (int i = 0; i < count + 50; ++i)
+	{
+		if (i < count)
+			REQUIRE(*results[static_cast<size_t>(i)] == i);
+		else
+			REQUIRE(results[static_cast<size_t>(i)] == nullptr);
+	}
+}
+
+TEST_CASE("Hash_Map<int, int>: batched calls on a table large enough to be prefetched")
+{
+	hstl::Hash_Map<int, int> m;
+
+	hstl::Array<int> keys;
+	for (int i = 0; i < 300000; ++i)
+		keys.push(i * 7);
+
+	// Grows from empty, the table crosses the prefetching threshold in the middle of the call
+	m.insert_many(keys.buffer(), keys.buffer(), keys.size());
+	REQUIRE(m.count() == keys.size());
+
+	hstl::Array<int> queries;
+	for (int i = 0; i < 100003; ++i)
+		queries.push(i * 3);
+
+	hstl::Array<const int*> results{queries.size()};
+	hstl::Array<bool> contained{queries.size()};
+
+	m.get_many(queries.buffer(), queries.size(), results.buffer());
+	size_t hits = m.contains_many(queries.buffer(), queries.size(), contained.buffer());
+
+	size_t expected_hits = 0;
+	for (size_t i = 0; i < queries.size(); ++i)
+	{
+		bool expected = queries[i] % 7 == 0 && queries[i] < 300000 * 7;
+		expected_hits += expected;
+
+		REQUIRE(contained[i] == expected);
+		REQUIRE((results[i] != nullptr) == expected);
+		if (expected)
+			REQUIRE(*results[i] == queries[i]);
+	}
+
+	REQUIRE(hits == expected_hits);
+
+	// Overwrites through the prefetching path
+	m.insert_many(keys.buffer(), queries.buffer(), 1000);
+	REQUIRE(*m.get(7) == 3);
+	REQUIRE(m.count() == keys.size());
+}
+
+TEST_CASE("Hash_Map<int, int>: iterating a sparse table after removals")
+{
+	hstl::Hash_Map<int, int> m;
+
+	for (int i = 0; i < 5000; ++i)
+		m.insert(i, i);
+
+	for (int i = 0; i < 5000; ++i)
+		if (i % 500 != 7)
+			m.remove(i);
+
+	REQUIRE(m.count() == 10);
+
+	int sum = 0;
+	size_t seen = 0;
+
+	for (auto it = m.begin(); it != m.end(); ++it)
+	{
+		REQUIRE(it->key % 500 == 7);
+		sum += it->value;
+		seen++;
+	}
+
+	REQUIRE(seen == 10);
+	REQUIRE(sum == 7 * 10 + 500 * 45);
+
+	// Through the const iterator too
+	const auto& view = m;
+	seen = 0;
+	for (const auto& slot : view)
+	{
+		REQUIRE(slot.key == slot.value);
+		seen++;
+	}
+	REQUIRE(seen == 10);
+}
+
+TEST_CASE("Hash_Map<int, int>: mutable iteration and for_each")
+{
+	hstl::Hash_Map<int, int> m;
+
+	for (int i = 0; i < 100; ++i)
+		m.insert(i, i);
+
+	for (auto entry : m)
+		entry.value *= 2;
+
+	for (int i = 0; i < 100; ++i)
+		REQUIRE(*m.get(i) == i * 2);
+
+	auto it = m.begin();
+	it->value = -1;
+	REQUIRE(*m.get(it->key) == -1);
+	(*it).value = it->key * 2;
+
+	m.for_each([](const int& key, int& value) { value += key; });
+
+	int sum = 0;
+	size_t visited = 0;
+
+	const auto& view = m;
+	view.for_each([&](const int& key, const int& value)
+	{
+		REQUIRE(value == key * 3);
+		sum += value;
+		visited++;
+	});
+
+	REQUIRE(visited == 100);
+	REQUIRE(sum == 3 * 99 * 100 / 2);
+
+	hstl::Hash_Map<int, int> empty;
+	empty.for_each([](const int&, int&) { FAIL(); });
+	REQUIRE(empty.begin() == empty.end());
+}
+
+TEST_CASE("Hash_Map: for_each and the mutable iterator cover both tables of an incremental rehash")
+{
+	hstl::Hash_Map<int, int, hstl::Hash<int>, hstl::Equal_To<int>, Incremental_Int> m;
+
+	// Stops right after a big table started migrating, the removes below land in both tables
+	int count = 0;
+	while (m.is_rehashing() == false || count < 3000)
+	{
+		m.insert(count, count);
+		count++;
+	}
+
+	REQUIRE(m.is_rehashing());
+
+	for (int i = 0; i < count; i += 5)
+		REQUIRE(m.remove(i));
+
+	size_t expected = m.count();
+
+	for (auto entry : m)
+		entry.value = -entry.key;
+
+	size_t visited = 0;
+	m.for_each([&](const int& key, int& value)
+	{
+		REQUIRE(key % 5 != 0);
+		REQUIRE(value == -key);
+		visited++;
+	});
+
+	REQUIRE(visited == expected);
+}
+
+namespace {
+
+	// A component-sized value, the case SPLIT_SLOTS is meant for
+	struct Record {
+		uint64_t id = 0;
+		uint64_t payload[31] = {};
+	};
+
+	struct Split : hstl::Hash_Map_Options<Key, int> {
+		static constexpr bool SPLIT_SLOTS = true;
+	};
+
+	struct Split_Record : hstl::Hash_Map_Options<int, Record> {
+		static constexpr bool SPLIT_SLOTS = true;
+	};
+
+	struct Split_Str : hstl::Hash_Map_Options<hstl::Str, Tracker> {
+		static constexpr bool SPLIT_SLOTS = true;
+	};
+
+} // namespace
+
+TEST_CASE("Hash_Map<int, Record>: split slots with large values")
+{
+	hstl::Hash_Map<int, Record, hstl::Hash<int>, hstl::Equal_To<int>, Split_Record> m;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		Record record;
+		record.id = static_cast<uint64_t>(i);
+		record.payload[30] = static_cast<uint64_t>(i) * 3u;
+		m.insert(i, record);
+	}
+
+	for (int i = 0; i < 1000; i += 2)
+		REQUIRE(m.remove(i));
+
+	REQUIRE(m.count() == 500);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Record* record = m.get(i);
+		REQUIRE((record != nullptr) == (i % 2 == 1));
+		if (record)
+			REQUIRE(record->payload[30] == static_cast<uint64_t>(i) * 3u);
+	}
+
+	// The const iterator yields entries with the same members as a slot
+	size_t seen = 0;
+	for (auto it = std::as_const(m).begin(); it != std::as_const(m).end(); ++it)
+	{
+		REQUIRE(static_cast<uint64_t>(it->key) == it->value.id);
+		seen++;
+	}
+	REQUIRE(seen == 500);
+
+	for (auto entry : m)
+		entry.value.id++;
+
+	m.for_each([](const int& key, const Record& record) { REQUIRE(record.id == static_cast<uint64_t>(key) + 1u); });
+
+	auto copy = m;
+	REQUIRE(copy.count() == 500);
+	REQUIRE(copy.get(999)->id == 1000u);
+}
+
+TEST_CASE("Hash_Map<Key, int>: split slots match std::unordered_map with clustered hashes")
+{
+	hstl::Hash_Map<Key, int, KeyHash, KeyEq, Split> m;
+	std::unordered_map<int, int> reference;
+
+	std::mt19937 rng{99};
+
+	auto make_key = [](int v)
+	{
+		size_t home = static_cast<size_t>(v % 37) * 61u;
+		size_t fingerprint = static_cast<size_t>(v % 3) << 57;
+
+		return K(v, home | fingerprint);
+	};
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		int v = static_cast<int>(rng() % 3000);
+		auto key = make_key(v);
+
+		if (rng() % 3 == 0)
+		{
+			REQUIRE(m.remove(key) == (reference.erase(v) == 1));
+		}
+		else
+		{
+			m.insert(key, i);
+			reference[v] = i;
+		}
+	}
+
+	REQUIRE(m.count() == reference.size());
+
+	for (const auto& entry : m)
+		REQUIRE(reference.at(entry.key.v) == entry.value);
+}
+
+TEST_CASE("Hash_Map<Str, Tracker>: split slots with non-trivial keys and values")
+{
+	Tracker::copy_count = 0;
+	Tracker::move_count = 0;
+
+	{
+		hstl::Hash_Map<hstl::Str, Tracker, hstl::Str_Hash, hstl::Str_Equal, Split_Str> m;
+
+		for (int i = 0; i < 200; ++i)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "entity_%d", i);
+			m.try_emplace(name, i);
+		}
+
+		REQUIRE(Tracker::copy_count == 0);
+
+		for (int i = 0; i < 200; i += 4)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "entity_%d", i);
+			REQUIRE(m.remove(hstl::Str_View{ name }));
+		}
+
+		auto copy = m;
+		auto moved = std::move(m);
+
+		REQUIRE(moved.count() == 150);
+		REQUIRE(copy.count() == 150);
+		REQUIRE(copy.get("entity_5")->id == 5);
+		REQUIRE(moved.get("entity_199")->id == 199);
+		REQUIRE(moved.get("entity_8") == nullptr);
+	}
+}
+
+TEST_CASE("Hash_Map: clear keeps the table and destroys the elements")
+{
+	hstl::Hash_Map<int, int> m;
+	m.clear();
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.capacity() == 0);
+
+	for (int i = 0; i < 2000; ++i)
+		m.insert(i, i);
+
+	size_t capacity = m.capacity();
+
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		m.clear();
+
+		REQUIRE(m.count() == 0);
+		REQUIRE(m.capacity() == capacity);
+		REQUIRE(m.get(5) == nullptr);
+		REQUIRE(m.begin() == m.end());
+
+		for (int i = frame; i < 1500; i += 3)
+			m.insert(i, -i);
+
+		REQUIRE(m.count() == static_cast<size_t>((1500 - frame + 2) / 3));
+		REQUIRE(*m.get(frame + 3) == -(frame + 3));
+		REQUIRE(m.capacity() == capacity);
+	}
+
+	// Non-trivial keys are destroyed (ASan reports a leak otherwise) and the table stays usable
+	hstl::Hash_Map<hstl::Str, int> names;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "a_long_enough_name_%d", i);
+		names.insert(name, i);
+	}
+
+	names.clear();
+	REQUIRE(names.count() == 0);
+	REQUIRE(names.contains("a_long_enough_name_7") == false);
+
+	names.insert("pelvis", 1);
+	REQUIRE(*names.get("pelvis") == 1);
+
+	// Mid-migration, the old table goes away with its elements
+	hstl::Hash_Map<hstl::Str, int, hstl::Str_Hash, hstl::Str_Equal, Incremental_Str> incremental;
+
+	for (int i = 0; incremental.is_rehashing() == false || i < 200; ++i)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "a_long_enough_name_%d", i);
+		incremental.insert(name, i);
+	}
+
+	incremental.clear();
+	REQUIRE(incremental.is_rehashing() == false);
+	REQUIRE(incremental.count() == 0);
+	REQUIRE(incremental.begin() == incremental.end());
+
+	incremental.insert("spine", 2);
+	REQUIRE(*incremental.get("spine") == 2);
+}
+
+namespace {
+
+	struct Generational : hstl::Hash_Map_Options<Key, int> {
+		static constexpr bool GENERATIONAL_CLEAR = true;
+	};
+
+	struct Generational_Stored : Generational {
+		static constexpr bool STORE_HASH = true;
+	};
+
+	struct Generational_Split : Generational {
+		static constexpr bool SPLIT_SLOTS = true;
+	};
+
+	struct Generational_Int : hstl::Hash_Map_Options<int, int> {
+		static constexpr bool GENERATIONAL_CLEAR = true;
+	};
+
+	template<typename Options>
+	void check_generational_against_reference()
+	{
+		hstl::Hash_Map<Key, int, KeyHash, KeyEq, Options> m;
+		std::unordered_map<int, int> reference;
+
+		std::mt19937 rng{46};
+
+		// Clustered so that probes and backward shifts run across groups left stale by a clear
+		auto make_key = [](int v)
+		{
+			size_t home = static_cast<size_t>(v % 41) * 37u;
+			size_t fingerprint = static_cast<size_t>(v % 4) << 57;
+
+			return K(v, home | fingerprint);
+		};
+
+		for (int frame = 0; frame < 40; ++frame)
+		{
+			// Frames of varying size, some grow the table and some barely touch it
+			int operations = static_cast<int>(rng() % 3000);
+
+			for (int i = 0; i < operations; ++i)
+			{
+				int v = static_cast<int>(rng() % 5000);
+				auto key = make_key(v);
+
+				if (rng() % 4 == 0)
+				{
+					REQUIRE(m.remove(key) == (reference.erase(v) == 1));
+				}
+				else
+				{
+					m.insert(key, i);
+					reference[v] = i;
+				}
+			}
+
+			REQUIRE(m.count() == reference.size());
+
+			size_t seen = 0;
+			for (const auto& entry : m)
+			{
+				REQUIRE(reference.at(entry.key.v) == entry.value);
+				seen++;
+			}
+			REQUIRE(seen == reference.size());
+
+			for (auto [v, value] : reference)
+				REQUIRE(*m.get(make_key(v)) == value);
+
+			REQUIRE(m.stats().count == reference.size());
+
+			if (frame % 5 == 4)
+			{
+				// A copy carries the generations along
+				auto copy = m;
+				REQUIRE(copy.count() == reference.size());
+
+				for (auto [v, value] : reference)
+					REQUIRE(*copy.get(make_key(v)) == value);
+			}
+
+			size_t capacity = m.capacity();
+
+			m.clear();
+			reference.clear();
+
+			REQUIRE(m.count() == 0);
+			REQUIRE(m.capacity() == capacity);
+			REQUIRE(m.begin() == m.end());
+			REQUIRE(m.get(make_key(1)) == nullptr);
+		}
+	}
+
+} // namespace
+
+TEST_CASE("Hash_Map: generational clear matches std::unordered_map across many clears")
+{
+	check_generational_against_reference<Generational>();
+	check_generational_against_reference<Generational_Stored>();
+	check_generational_against_reference<Generational_Split>();
+}
+
+TEST_CASE("Hash_Map<int, int>: generational clear leaves the table alone until it's refilled")
+{
+	hstl::Hash_Map<int, int, hstl::Hash<int>, hstl::Equal_To<int>, Generational_Int> m{2048};
+	size_t capacity = m.capacity();
+
+	for (int frame = 0; frame < 100; ++frame)
+	{
+		for (int i = 0; i < 1500; ++i)
+			m.insert(i * 7 + frame, i);
+
+		REQUIRE(m.count() == 1500);
+		REQUIRE(*m.get(frame) == 0);
+		REQUIRE(m.get(frame - 1) == nullptr);
+
+		int sum = 0;
+		m.for_each([&](const int&, const int& value) { sum += value; });
+		REQUIRE(sum == 1499 * 1500 / 2);
+
+		m.clear();
+	}
+
+	REQUIRE(m.capacity() == capacity);
+	REQUIRE(m.stats().rehash_count == 1);
+
+	// Growing out of a cleared table keeps only the live elements
+	for (int i = 0; i < 10000; ++i)
+		m.insert(i, i);
+
+	REQUIRE(m.count() == 10000);
+	REQUIRE(*m.get(9999) == 9999);
+
+	auto moved = std::move(m);
+	moved.clear();
+	REQUIRE(moved.count() == 0);
+	moved.insert(1, 1);
+	REQUIRE(*moved.get(1) == 1);
+}
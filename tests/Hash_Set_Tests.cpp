@@ -1,6 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <Hash_Set.h>
+#include <Str.h>
+
+#include <unordered_set>
+#include <random>
+#include <cstdio>
+#include <vector>
 
 namespace {
 
@@ -154,7 +160,7 @@ TEST_CASE("Hash_Set<Key>: remove back-shifts inside a cluster (no wrap)")
 
 TEST_CASE("Hash_Set<Key>: remove back-shifts across wrap-around")
 {
-	hstl::Hash_Set<Key, KeyHash, KeyEq> s;
+	hstl::Hash_Set<Key, KeyHash, KeyEq> s{ 64 };
 
 	const size_t cap = s.capacity();
 	REQUIRE(cap >= 4);
@@ -198,13 +204,13 @@ TEST_CASE("Hash_Set<Key>: remove back-shifts across wrap-around")
 
 TEST_CASE("Hash_Set<Key>: rehash preserves all elements")
 {
-	hstl::Hash_Set<Key, KeyHash, KeyEq> s;
+	hstl::Hash_Set<Key, KeyHash, KeyEq> s{ 1000 };
 
 	const size_t cap0 = s.capacity();
 	REQUIRE(cap0 > 0);
 
 	// Trigger the rehash by exceeding the load threshold.
-	const size_t threshold = static_cast<size_t>(0.7f * static_cast<float>(cap0));
+	const size_t threshold = static_cast<size_t>(0.875f * static_cast<float>(cap0));
 
 	const size_t N = threshold + 50; // safely past threshold to force at least one rehash
 
@@ -359,4 +365,289 @@ TEST_CASE("Hash_Set<Tracker>: Move Semantics")
 		REQUIRE(Tracker::copy_count == 0);
 		REQUIRE(Tracker::move_count == 0);
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Hash_Set<Key>: group probing matches std::unordered_set with clustered hashes")
+{
+	hstl::Hash_Set<Key, KeyHash, KeyEq> s;
+	std::unordered_set<int> reference;
+
+	std::mt19937 rng{77};
+
+	// Few distinct homes and fingerprints, so long clusters cross group boundaries and wrap around
+	auto make_key = [](int v)
+	{
+		size_t home = static_cast<size_t>(v % 29) * 71u;
+		size_t fingerprint = static_cast<size_t>(v % 3) << 57;
+
+		return Key{ v, home | fingerprint };
+	};
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		int v = static_cast<int>(rng() % 3000);
+		auto key = make_key(v);
+
+		if (rng() % 2 == 0)
+		{
+			s.insert(key);
+			reference.insert(v);
+		}
+		else
+		{
+			REQUIRE(s.remove(key) == (reference.erase(v) == 1));
+		}
+
+		REQUIRE(s.contains(key) == (reference.count(v) == 1));
+	}
+
+	REQUIRE(s.count() == reference.size());
+
+	for (int v : reference)
+		REQUIRE(s.contains(make_key(v)));
+}
+
+TEST_CASE("Hash_Set<Str>: transparent lookup with Str_View and string literals")
+{
+	hstl::Hash_Set<hstl::Str, hstl::Str_Hash, hstl::Str_Equal> s;
+
+	s.insert("pelvis");
+	s.insert(hstl::Str{ "spine" });
+	s.insert("pelvis"); // already there
+
+	REQUIRE(s.count() == 2);
+	REQUIRE(s.contains("pelvis"));
+	REQUIRE(s.contains(hstl::Str_View{ "spine" }));
+	REQUIRE_FALSE(s.contains("head"));
+
+	const hstl::Str* found = s.get(hstl::Str_View{ "spine.001", 5 });
+	REQUIRE(found != nullptr);
+	REQUIRE(found->view() == hstl::Str_View{ "spine" });
+
+	REQUIRE(s.remove("pelvis"));
+	REQUIRE_FALSE(s.remove(hstl::Str_View{ "pelvis" }));
+	REQUIRE(s.count() == 1);
+}
+
+TEST_CASE("Hash_Set<int>: lazy allocation, reserve and shrink_to_fit")
+{
+	hstl::Hash_Set<int> s;
+
+	REQUIRE(s.capacity() == 0);
+	REQUIRE_FALSE(s.contains(1));
+	REQUIRE_FALSE(s.remove(1));
+	REQUIRE(s.begin() == s.end());
+
+	hstl::Hash_Set<int> reserved{ 500 };
+	const size_t cap = reserved.capacity();
+	REQUIRE(cap >= 500);
+
+	for (int i = 0; i < 500; ++i)
+		reserved.insert(i);
+
+	REQUIRE(reserved.capacity() == cap);
+
+	for (int i = 0; i < 500; ++i)
+		REQUIRE(reserved.remove(i));
+
+	reserved.shrink_to_fit();
+	REQUIRE(reserved.capacity() == 0);
+
+	hstl::Hash_Set<int> moved{ std::move(s) };
+	s.insert(7);
+	REQUIRE(s.contains(7));
+}
+
+TEST_CASE("Hash_Set<Str>: stored hashes survive grow, remove and copy")
+{
+	hstl::Hash_Set<hstl::Str, hstl::Str_Hash, hstl::Str_Equal> s;
+
+	char name[32];
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		snprintf(name, sizeof(name), "item_%d", i);
+		s.insert(name);
+	}
+
+	for (int i = 0; i < 1000; i += 2)
+	{
+		snprintf(name, sizeof(name), "item_%d", i);
+		REQUIRE(s.remove(hstl::Str_View{ name }));
+	}
+
+	hstl::Hash_Set<hstl::Str, hstl::Str_Hash, hstl::Str_Equal> copy;
+	copy = s;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		snprintf(name, sizeof(name), "item_%d", i);
+		REQUIRE(s.contains(hstl::Str_View{ name }) == (i % 2 == 1));
+		REQUIRE(copy.contains(hstl::Str_View{ name }) == (i % 2 == 1));
+	}
+}
+
+TEST_CASE("Hash_Set: get_many, contains_many and insert_many match single calls")
+{
+	hstl::Hash_Set<int> s;
+
+	hstl::Array<int> keys;
+	for (int i = 0; i < 777; ++i)
+		keys.push(i * 5);
+
+	s.insert_many(keys.buffer(), keys.size());
+	s.insert_many(keys.buffer(), 10); // already there
+	REQUIRE(s.count() == 777);
+
+	hstl::Array<int> queries;
+	for (int i = 0; i < 4000; ++i)
+		queries.push(i);
+
+	hstl::Array<const int*> results{queries.size()};
+	hstl::Array<bool> contained{queries.size()};
+
+	s.get_many(queries.buffer(), queries.size(), results.buffer());
+	REQUIRE(s.contains_many(queries.buffer(), queries.size(), contained.buffer()) == 777);
+
+	for (size_t i = 0; i < queries.size(); ++i)
+	{
+		REQUIRE(results[i] == s.get(queries[i]));
+		REQUIRE(contained[i] == (queries[i] % 5 == 0 && queries[i] < 777 * 5));
+	}
+
+	// Transparent keys
+	hstl::Hash_Set<hstl::Str> names;
+	names.insert("spine");
+
+	const char* lookups[] = { "spine", "tail" };
+	bool name_found[2];
+
+	REQUIRE(names.contains_many(lookups, 2, name_found) == 1);
+	REQUIRE(name_found[0]);
+	REQUIRE(name_found[1] == false);
+}
+
+TEST_CASE("Hash_Set<int>: batched calls on a table large enough to be prefetched")
+{
+	hstl::Hash_Set<int> s;
+
+	hstl::Array<int> keys;
+	for (int i = 0; i < 400000; ++i)
+		keys.push(i * 2);
+
+	s.insert_many(keys.buffer(), keys.size());
+	REQUIRE(s.count() == keys.size());
+
+	hstl::Array<int> queries;
+	for (int i = 0; i < 50001; ++i)
+		queries.push(i * 3);
+
+	hstl::Array<bool> contained{queries.size()};
+	s.contains_many(queries.buffer(), queries.size(), contained.buffer());
+
+	for (size_t i = 0; i < queries.size(); ++i)
+		REQUIRE(contained[i] == (queries[i] % 2 == 0));
+}
+
+TEST_CASE("Hash_Set<int>: sparse iteration and for_each")
+{
+	hstl::Hash_Set<int> s;
+
+	for (int i = 0; i < 3000; ++i)
+		s.insert(i);
+
+	for (int i = 0; i < 3000; ++i)
+		if (i % 300 != 0)
+			s.remove(i);
+
+	int sum = 0;
+	for (auto it = s.begin(); it != s.end(); ++it)
+		sum += *it;
+
+	REQUIRE(sum == 300 * 45);
+
+	int for_each_sum = 0;
+	size_t visited = 0;
+	s.for_each([&](const int& value) { for_each_sum += value; visited++; });
+
+	REQUIRE(visited == 10);
+	REQUIRE(for_each_sum == sum);
+}
+
+namespace {
+
+	struct Generational : hstl::Hash_Set_Options<Key> {
+		static constexpr bool GENERATIONAL_CLEAR = true;
+	};
+
+} // namespace
+
+TEST_CASE("Hash_Set: clear, plain and generational, keeps the table")
+{
+	hstl::Hash_Set<Tracker, TrackerHash> trackers;
+
+	for (int i = 0; i < 100; ++i)
+		trackers.insert(Tracker{ i });
+
+	size_t tracker_capacity = trackers.capacity();
+
+	trackers.clear();
+	REQUIRE(trackers.count() == 0);
+	REQUIRE(trackers.capacity() == tracker_capacity);
+	REQUIRE(trackers.begin() == trackers.end());
+	trackers.insert(Tracker{ 3 });
+	REQUIRE(trackers.contains(Tracker{ 3 }));
+
+	hstl::Hash_Set<Key, KeyHash, KeyEq, Generational> s;
+	std::mt19937 rng{46};
+
+	// Clustered so that probes and backward shifts run across groups left stale by a clear
+	auto make_key = [](int v) { return K(v, (static_cast<size_t>(v % 29) * 19u) | (static_cast<size_t>(v % 3) << 57)); };
+
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		std::vector<bool> reference(4000, false);
+		size_t live = 0;
+
+		for (int i = static_cast<int>(rng() % 2500); i > 0; --i)
+		{
+			int v = static_cast<int>(rng() % 4000);
+
+			if (rng() % 4 == 0)
+			{
+				REQUIRE(s.remove(make_key(v)) == reference[v]);
+				live -= reference[v];
+				reference[v] = false;
+			}
+			else
+			{
+				s.insert(make_key(v));
+				live += reference[v] == false;
+				reference[v] = true;
+			}
+		}
+
+		REQUIRE(s.count() == live);
+
+		size_t seen = 0;
+		for (const Key& key : s)
+		{
+			REQUIRE(reference[key.v]);
+			seen++;
+		}
+		REQUIRE(seen == live);
+
+		for (int v = 0; v < 4000; ++v)
+			REQUIRE(s.contains(make_key(v)) == reference[v]);
+
+		auto copy = s;
+		REQUIRE(copy.count() == live);
+
+		size_t capacity = s.capacity();
+
+		s.clear();
+		REQUIRE(s.count() == 0);
+		REQUIRE(s.capacity() == capacity);
+		REQUIRE(s.begin() == s.end());
+		REQUIRE(s.stats().count == 0);
+	}
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Hash_Map.h>
+#include <Hash_Set.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+	struct Key {
+		int v = 0;
+		size_t forced_hash = 0;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& k) const noexcept { return k.forced_hash; }
+	};
+
+	struct KeyEq {
+		bool operator()(const Key& a, const Key& b) const noexcept { return a.v == b.v; }
+	};
+
+	struct Counted : hstl::Hash_Map_Options<int, int> {
+		static constexpr bool PROBE_COUNTERS = true;
+	};
+
+	struct Counted_Set : hstl::Hash_Set_Options<int> {
+		static constexpr bool PROBE_COUNTERS = true;
+	};
+
+} // namespace
+
+TEST_CASE("Hash_Stats: empty and freshly reserved maps")
+{
+	hstl::Hash_Map<int, int> empty;
+	auto stats = empty.stats();
+
+	REQUIRE(stats.count == 0);
+	REQUIRE(stats.capacity == 0);
+	REQUIRE(stats.load_factor == 0.0f);
+	REQUIRE(stats.hit_probe_histogram.size() == 0);
+	REQUIRE(stats.bytes_reserved == 0);
+	REQUIRE(stats.rehash_count == 0);
+
+	hstl::Hash_Map<int, int> reserved{100};
+	stats = reserved.stats();
+
+	// Every miss stops in its first group
+	REQUIRE(stats.capacity == 128);
+	REQUIRE(stats.mean_miss_probe == 1.0);
+	REQUIRE(stats.max_miss_probe == 1);
+	REQUIRE(stats.fingerprint_collisions_per_miss == 0.0);
+	REQUIRE(stats.rehash_count == 1);
+}
+
+TEST_CASE("Hash_Stats: a good hash and a constant hash")
+{
+	// Every key on its own home slot
+	hstl::Hash_Map<Key, int, KeyHash, KeyEq> spread{64};
+
+	for (int i = 0; i < 32; ++i)
+		spread.insert(Key{ i, static_cast<size_t>(i * 2) }, i);
+
+	auto stats = spread.stats();
+
+	REQUIRE(stats.count == 32);
+	REQUIRE(stats.load_factor == 32.0f / static_cast<float>(stats.capacity));
+	REQUIRE(stats.mean_hit_probe == 1.0);
+	REQUIRE(stats.max_hit_probe == 1);
+	REQUIRE(stats.hit_probe_histogram.size() == 1);
+	REQUIRE(stats.hit_probe_histogram[0] == 32);
+	REQUIRE(stats.fingerprint_collisions_per_hit == 0.0);
+
+	// Every key on the same home with the same fingerprint: one long cluster, the n-th element is
+	// compared against the n - 1 before it
+	hstl::Hash_Map<Key, int, KeyHash, KeyEq> clustered{64};
+
+	constexpr int N = 40;
+
+	for (int i = 0; i < N; ++i)
+		clustered.insert(Key{ i, 5 }, i);
+
+	stats = clustered.stats();
+
+	REQUIRE(stats.fingerprint_collisions_per_hit == (N - 1) / 2.0);
+	REQUIRE(stats.max_hit_probe > 1);
+	REQUIRE(stats.mean_hit_probe > 1.0);
+	REQUIRE(stats.max_miss_probe >= stats.max_hit_probe);
+
+	size_t histogram_total = 0;
+	for (size_t count : stats.hit_probe_histogram)
+		histogram_total += count;
+
+	REQUIRE(histogram_total == N);
+	REQUIRE(stats.hit_probe_histogram[stats.max_hit_probe - 1] > 0);
+}
+
+TEST_CASE("Hash_Stats: rehash count and bytes")
+{
+	hstl::Hash_Map<int, int> m;
+
+	for (int i = 0; i < 1000; ++i)
+		m.insert(i, i);
+
+	auto stats = m.stats();
+
+	// 16, 32, ..., 2048
+	REQUIRE(stats.capacity == 2048);
+	REQUIRE(stats.rehash_count == 8);
+	REQUIRE(stats.bytes_used == 1000 * (2 * sizeof(int) + 1));
+	REQUIRE(stats.bytes_reserved == 2048 * (2 * sizeof(int) + 1));
+	REQUIRE(stats.mean_hit_probe >= 1.0);
+
+	hstl::Hash_Set<int> s;
+
+	for (int i = 0; i < 1000; ++i)
+		s.insert(i);
+
+	auto set_stats = s.stats();
+
+	REQUIRE(set_stats.count == 1000);
+	REQUIRE(set_stats.rehash_count == 8);
+	REQUIRE(set_stats.bytes_reserved == 2048 * (sizeof(int) + 1));
+}
+
+TEST_CASE("Hash_Stats: live probe counters")
+{
+	hstl::Hash_Map<int, int, hstl::Hash<int>, hstl::Equal_To<int>, Counted> m{1000};
+
+	for (int i = 0; i < 500; ++i)
+		m.insert(i, i);
+
+	m.reset_probe_counters();
+
+	for (int i = 0; i < 1000; ++i)
+		m.contains(i);
+
+	auto counters = m.stats().probe_counters;
+
+	REQUIRE(counters.probes == 1000);
+	REQUIRE(counters.probed_groups >= 1000);
+	REQUIRE(counters.compared_keys >= 500);
+
+	// Without the option nothing is counted
+	hstl::Hash_Map<int, int> uncounted;
+	uncounted.insert(1, 1);
+	uncounted.contains(1);
+
+#if HSTL_HASH_PROBE_COUNTERS == 0
+	REQUIRE(uncounted.stats().probe_counters.probes == 0);
+#endif
+
+	hstl::Hash_Set<int, hstl::Hash<int>, hstl::Equal_To<int>, Counted_Set> s;
+	s.insert(1);
+	s.insert(2);
+	s.contains(1);
+
+	REQUIRE(s.stats().probe_counters.probes == 3);
+	REQUIRE(s.stats().probe_counters.compared_keys == 1);
+}
+
+TEST_CASE("Hash_Stats: live probe counters with concurrent readers")
+{
+	hstl::Hash_Map<int, int, hstl::Hash<int>, hstl::Equal_To<int>, Counted> m{1000};
+
+	for (int i = 0; i < 500; ++i)
+		m.insert(i, i);
+
+	m.reset_probe_counters();
+
+	const auto& readers_view = m;
+	constexpr int READERS = 4;
+	constexpr int LOOKUPS = 10000;
+
+	std::vector<std::thread> readers;
+
+	for (int t = 0; t < READERS; ++t)
+	{
+		readers.emplace_back([&readers_view]()
+		{
+			for (int i = 0; i < LOOKUPS; ++i)
+				readers_view.contains(i % 1000);
+		});
+	}
+
+	for (auto& reader : readers)
+		reader.join();
+
+	// No increment is lost between the threads
+	auto counters = m.stats().probe_counters;
+
+	REQUIRE(counters.probes == READERS * LOOKUPS);
+	REQUIRE(counters.probed_groups >= READERS * LOOKUPS);
+	REQUIRE(counters.compared_keys >= READERS * LOOKUPS / 2);
+}
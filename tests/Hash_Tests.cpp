@@ -0,0 +1,246 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Hash.h>
+#include <Hash_Map.h>
+#include <Hash_Set.h>
+
+#include <string>
+#include <unordered_set>
+#include <bit>
+
+TEST_CASE("Hash: strings hash their characters whatever the type")
+{
+	const char* c_str = "spine_01";
+	hstl::Str str{ "spine_01" };
+	hstl::Str_View view{ "spine_01 and more", 8 };
+	std::string std_str{ "spine_01" };
+
+	hstl::Hash<hstl::Str> hash;
+
+	REQUIRE(hash(str) == hash(c_str));
+	REQUIRE(hash(str) == hash(view));
+	REQUIRE(hash(str) == hstl::Hash<std::string>{}(std_str));
+	REQUIRE(hash(str) == hstl::hash_bytes(c_str, 8));
+	REQUIRE(hash(str) != hash("spine_02"));
+
+	REQUIRE(hstl::Equal_To<hstl::Str>{}(str, view));
+	REQUIRE(hstl::Equal_To<hstl::Str>{}(str, c_str));
+	REQUIRE_FALSE(hstl::Equal_To<hstl::Str>{}(str, "spine_0"));
+}
+
+TEST_CASE("Hash: hash_bytes tells every prefix and seed apart")
+{
+	char buffer[256];
+	for (int i = 0; i < 256; ++i)
+		buffer[i] = static_cast<char>(i * 7);
+
+	std::unordered_set<uint64_t> seen;
+
+	for (size_t length = 0; length <= 256; ++length)
+	{
+		uint64_t h = hstl::hash_bytes(buffer, length);
+
+		REQUIRE(h == hstl::hash_bytes(buffer, length)); // deterministic
+		REQUIRE(seen.insert(h).second);
+		REQUIRE(seen.insert(hstl::hash_bytes(buffer, length, 1234u)).second);
+	}
+
+	// A single byte change anywhere changes the hash
+	for (size_t i = 0; i < 100; ++i)
+	{
+		char copy[100];
+		memcpy(copy, buffer, 100);
+		copy[i] ^= 1;
+
+		REQUIRE(hstl::hash_bytes(copy, 100) != hstl::hash_bytes(buffer, 100));
+	}
+}
+
+TEST_CASE("Hash: single bit flips avalanche")
+{
+	auto average_flipped_bits = [](auto&& hash_of_bit_flip, int bits)
+	{
+		double total = 0.0;
+
+		for (int bit = 0; bit < bits; ++bit)
+			total += std::popcount(hash_of_bit_flip(-1) ^ hash_of_bit_flip(bit));
+
+		return total / bits;
+	};
+
+	double integer = average_flipped_bits([](int bit)
+	{
+		uint64_t value = 0x123456789ull;
+		return hstl::hash_u64(bit < 0 ? value : value ^ (uint64_t{1} << bit));
+	}, 64);
+
+	double bytes = average_flipped_bits([](int bit)
+	{
+		uint8_t data[40] = { 1, 2, 3 };
+		if (bit >= 0)
+			data[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+		return hstl::hash_bytes(data, sizeof(data));
+	}, 320);
+
+	REQUIRE(integer > 24.0);
+	REQUIRE(integer < 40.0);
+	REQUIRE(bytes > 24.0);
+	REQUIRE(bytes < 40.0);
+}
+
+TEST_CASE("Hash: sequential integers spread over the index and the fingerprint bits")
+{
+	hstl::Hash<uint32_t> hash;
+
+	std::unordered_set<uint64_t> fingerprints;
+	size_t buckets[256] = {};
+
+	for (uint32_t i = 0; i < 25600; ++i)
+	{
+		uint64_t h = hash(i * 64u); // strided keys are the worst case for the identity hash
+		fingerprints.insert(h >> 57);
+		buckets[h & 255u]++;
+	}
+
+	REQUIRE(fingerprints.size() == 128);
+
+	for (size_t count : buckets)
+	{
+		REQUIRE(count > 50);
+		REQUIRE(count < 150);
+	}
+}
+
+TEST_CASE("Hash: floats, combining and hash_values")
+{
+	hstl::Hash<double> hash_double;
+	hstl::Hash<float> hash_float;
+
+	REQUIRE(hash_double(0.0) == hash_double(-0.0));
+	REQUIRE(hash_float(0.0f) == hash_float(-0.0f));
+	REQUIRE(hash_double(1.0) != hash_double(2.0));
+
+	uint64_t ab = hstl::hash_combine(hstl::hash_combine(0u, 1u), 2u);
+	uint64_t ba = hstl::hash_combine(hstl::hash_combine(0u, 2u), 1u);
+	REQUIRE(ab != ba);
+
+	REQUIRE(hstl::hash_values(1, 2) == hstl::hash_values(1, 2));
+	REQUIRE(hstl::hash_values(1, 2) != hstl::hash_values(2, 1));
+	REQUIRE(hstl::hash_values(1, hstl::Str{ "a" }) != hstl::hash_values(1, hstl::Str{ "b" }));
+}
+
+TEST_CASE("Hash: Str keys work out of the box and are transparent")
+{
+	hstl::Hash_Map<hstl::Str, int> map;
+
+	map.insert("root", 0);
+	map.insert(hstl::Str{ "pelvis" }, 1);
+
+	REQUIRE(*map.get("root") == 0);
+	REQUIRE(*map.get(hstl::Str_View{ "pelvis" }) == 1);
+	REQUIRE(map.remove("root"));
+
+	hstl::Hash_Set<std::string> set;
+	set.insert("hello");
+
+	REQUIRE(set.contains("hello"));
+	REQUIRE(set.contains(std::string_view{ "hello" }));
+	REQUIRE_FALSE(set.contains("world"));
+}
+
+namespace {
+
+	struct Grid_Cell {
+		int32_t x;
+		int32_t y;
+		int32_t z;
+	};
+
+	struct Entity_Id {
+		uint32_t index;
+		uint16_t generation;
+		uint16_t type;
+		uint64_t owner;
+	};
+
+	struct Padded {
+		uint8_t a;
+		uint32_t b; // 3 bytes of padding in between
+	};
+
+	// Unique object representation, but equality and hash ignore the generation
+	struct Pool_Handle {
+		uint32_t index;
+		uint32_t generation;
+
+		bool operator==(const Pool_Handle& other) const { return index == other.index; }
+	};
+
+} // namespace
+
+template<>
+struct std::hash<Pool_Handle>
+{
+	size_t operator()(const Pool_Handle& handle) const noexcept { return handle.index; }
+};
+
+TEST_CASE("Hash: aggregates with unique object representation are hashed and compared as bytes")
+{
+	STATIC_REQUIRE(hstl::Bytewise_Key<Grid_Cell>);
+	STATIC_REQUIRE(hstl::Bytewise_Key<Entity_Id>);
+	STATIC_REQUIRE_FALSE(hstl::Bytewise_Key<Padded>);
+	STATIC_REQUIRE_FALSE(hstl::Bytewise_Key<int>);
+
+	hstl::Hash<Grid_Cell> hash;
+	hstl::Equal_To<Grid_Cell> equal;
+
+	Grid_Cell a{ 1, 2, 3 };
+	Grid_Cell b{ 1, 2, 3 };
+	Grid_Cell c{ 3, 2, 1 };
+
+	REQUIRE(hash(a) == hash(b));
+	REQUIRE(hash(a) == hstl::hash_bytes(&a, sizeof(a)));
+	REQUIRE(hash(a) != hash(c));
+	REQUIRE(equal(a, b));
+	REQUIRE_FALSE(equal(a, c));
+
+	// No functors needed for the containers
+	hstl::Hash_Map<Grid_Cell, int> cells;
+
+	for (int32_t x = -20; x < 20; ++x)
+		for (int32_t y = -20; y < 20; ++y)
+			cells.insert(Grid_Cell{ x, y, x ^ y }, x * 100 + y);
+
+	REQUIRE(cells.count() == 1600);
+
+	for (int32_t x = -20; x < 20; ++x)
+		for (int32_t y = -20; y < 20; ++y)
+			REQUIRE(*cells.get(Grid_Cell{ x, y, x ^ y }) == x * 100 + y);
+
+	REQUIRE_FALSE(cells.contains(Grid_Cell{ 0, 0, 1 }));
+
+	hstl::Hash_Set<Entity_Id> ids;
+	ids.insert(Entity_Id{ 1, 1, 2, 99 });
+	REQUIRE(ids.contains(Entity_Id{ 1, 1, 2, 99 }));
+	REQUIRE_FALSE(ids.contains(Entity_Id{ 1, 2, 2, 99 }));
+}
+
+TEST_CASE("Hash: types with their own std::hash keep it and their operator==")
+{
+	STATIC_REQUIRE(std::has_unique_object_representations_v<Pool_Handle>);
+	STATIC_REQUIRE_FALSE(hstl::Bytewise_Key<Pool_Handle>);
+
+	Pool_Handle a{ 7, 1 };
+	Pool_Handle b{ 7, 2 };
+
+	REQUIRE(hstl::Hash<Pool_Handle>{}(a) == hstl::Hash<Pool_Handle>{}(b));
+	REQUIRE(hstl::Hash<Pool_Handle>{}(a) == hstl::hash_u64(7));
+	REQUIRE(hstl::Equal_To<Pool_Handle>{}(a, b));
+
+	hstl::Hash_Map<Pool_Handle, int> handles;
+	handles.insert(a, 1);
+	handles.insert(b, 2);
+
+	REQUIRE(handles.count() == 1);
+	REQUIRE(*handles.get(Pool_Handle{ 7, 3 }) == 2);
+}
@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Parallel.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+	hstl::Array<int> make_random_array(size_t count, uint32_t seed)
+	{
+		std::mt19937 rng{seed};
+		std::uniform_int_distribution<int> dist{-1000000, 1000000};
+
+		hstl::Array<int> arr;
+		arr.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+			arr.push(dist(rng));
+
+		return arr;
+	}
+
+} // namespace
+
+TEST_CASE("Thread_Pool: parallel_for runs every task exactly once")
+{
+	hstl::Thread_Pool pool{3};
+
+	REQUIRE(pool.worker_count() == 3);
+	REQUIRE(pool.thread_count() == 4);
+
+	const size_t N = 1000;
+	hstl::Array<int> hits{N};
+
+	pool.parallel_for(N, [&](size_t i) { hits[i]++; });
+
+	for (size_t i = 0; i < N; ++i)
+		REQUIRE(hits[i] == 1);
+
+	SECTION("Nested jobs don't dead-lock") {
+		std::atomic<size_t> total{0};
+
+		pool.parallel_for(8, [&](size_t) {
+			pool.parallel_for(8, [&](size_t) { total++; });
+		});
+
+		REQUIRE(total == 64);
+	}
+
+	SECTION("A pool without workers runs on the caller") {
+		hstl::Thread_Pool serial{0};
+		size_t sum = 0;
+
+		serial.parallel_for(10, [&](size_t i) { sum += i; });
+
+		REQUIRE(sum == 45);
+	}
+}
+
+TEST_CASE("Parallel: sort", "[parallel]")
+{
+	hstl::Thread_Pool pool{3};
+
+	SECTION("Large array matches std::sort") {
+		auto arr = make_random_array(200000, 42);
+		std::vector<int> expected(arr.begin(), arr.end());
+
+		hstl::parallel_sort(arr, std::less<int>{}, &pool);
+		std::sort(expected.begin(), expected.end());
+
+		REQUIRE(arr.size() == expected.size());
+		REQUIRE(std::equal(arr.begin(), arr.end(), expected.begin()));
+	}
+
+	SECTION("Custom comparator") {
+		auto arr = make_random_array(100000, 7);
+
+		hstl::parallel_sort(arr, std::greater<int>{}, &pool);
+
+		REQUIRE(std::is_sorted(arr.begin(), arr.end(), std::greater<int>{}));
+	}
+
+	SECTION("Small and empty arrays") {
+		hstl::Array<int> empty;
+		hstl::parallel_sort(empty, std::less<int>{}, &pool);
+		REQUIRE(empty.size() == 0);
+
+		hstl::Array<int> small;
+		small.push(3);
+		small.push(1);
+		small.push(2);
+		hstl::parallel_sort(small, std::less<int>{}, &pool);
+		REQUIRE(small[0] == 1);
+		REQUIRE(small[1] == 2);
+		REQUIRE(small[2] == 3);
+	}
+
+	SECTION("Non-trivial elements") {
+		hstl::Array<std::string> arr;
+		for (int i = 60000; i > 0; --i)
+			arr.push(std::to_string(i));
+
+		hstl::parallel_sort(arr, std::less<std::string>{}, &pool);
+
+		REQUIRE(std::is_sorted(arr.begin(), arr.end()));
+		REQUIRE(arr.size() == 60000);
+	}
+}
+
+TEST_CASE("Parallel: transform and reduce", "[parallel]")
+{
+	hstl::Thread_Pool pool{3};
+
+	const size_t N = 100000;
+	hstl::Array<int> input;
+	for (size_t i = 0; i < N; ++i)
+		input.push(static_cast<int>(i));
+
+	hstl::Array<int64_t> squares;
+	hstl::parallel_transform(input, squares, [](const int& x) { return static_cast<int64_t>(x) * x; }, &pool);
+
+	REQUIRE(squares.size() == N);
+	for (size_t i = 0; i < N; ++i)
+		REQUIRE(squares[i] == static_cast<int64_t>(i) * static_cast<int64_t>(i));
+
+	int64_t sum = hstl::parallel_reduce(squares, int64_t{5}, std::plus<int64_t>{}, &pool);
+	int64_t expected = std::accumulate(squares.begin(), squares.end(), int64_t{5});
+	REQUIRE(sum == expected);
+
+	hstl::Array<int> empty;
+	REQUIRE(hstl::parallel_reduce(empty, 11, std::plus<int>{}, &pool) == 11);
+}
+
+TEST_CASE("Parallel: inclusive and exclusive scan", "[parallel]")
+{
+	hstl::Thread_Pool pool{3};
+
+	const size_t N = 70001;
+	hstl::Array<int64_t> input;
+	for (size_t i = 0; i < N; ++i)
+		input.push(static_cast<int64_t>(i % 13));
+
+	hstl::Array<int64_t> inclusive;
+	hstl::parallel_inclusive_scan(input, inclusive, std::plus<int64_t>{}, &pool);
+
+	hstl::Array<int64_t> exclusive;
+	hstl::parallel_exclusive_scan(input, exclusive, int64_t{100}, std::plus<int64_t>{}, &pool);
+
+	REQUIRE(inclusive.size() == N);
+	REQUIRE(exclusive.size() == N);
+
+	int64_t running = 0;
+	for (size_t i = 0; i < N; ++i)
+	{
+		REQUIRE(exclusive[i] == running + 100);
+		running += input[i];
+		REQUIRE(inclusive[i] == running);
+	}
+
+	SECTION("In-place scan") {
+		hstl::parallel_inclusive_scan(input, input, std::plus<int64_t>{}, &pool);
+
+		for (size_t i = 0; i < N; ++i)
+			REQUIRE(input[i] == inclusive[i]);
+	}
+}
+
+TEST_CASE("Parallel: remove_if keeps order", "[parallel]")
+{
+	hstl::Thread_Pool pool{3};
+
+	const size_t N = 100000;
+	hstl::Array<int> arr;
+	for (size_t i = 0; i < N; ++i)
+		arr.push(static_cast<int>(i));
+
+	hstl::parallel_remove_if(arr, [](const int& x) { return x % 3 == 0; }, &pool);
+
+	REQUIRE(arr.size() == N - (N + 2) / 3);
+
+	for (size_t i = 1; i < arr.size(); ++i)
+		REQUIRE(arr[i - 1] < arr[i]);
+
+	for (int x : arr)
+		REQUIRE(x % 3 != 0);
+
+	SECTION("Removing nothing leaves the array untouched") {
+		size_t before = arr.size();
+		hstl::parallel_remove_if(arr, [](const int&) { return false; }, &pool);
+		REQUIRE(arr.size() == before);
+	}
+
+	SECTION("Removing everything") {
+		hstl::parallel_remove_if(arr, [](const int&) { return true; }, &pool);
+		REQUIRE(arr.size() == 0);
+	}
+}
@@ -0,0 +1,239 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Priority_Queue.h>
+
+#include <string>
+#include <queue>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+TEST_CASE("Priority_Queue<int>: push/top/pop")
+{
+	hstl::Priority_Queue<int> q;
+
+	REQUIRE(q.empty());
+
+	for (int v : { 5, 1, 9, 3, 7, 9, 0 })
+		q.push(v);
+
+	REQUIRE(q.count() == 7);
+	REQUIRE(q.top() == 9);
+
+	int expected[] = { 9, 9, 7, 5, 3, 1, 0 };
+
+	for (int v : expected)
+		REQUIRE(q.pop() == v);
+
+	REQUIRE(q.empty());
+}
+
+TEST_CASE("Priority_Queue: min-queue with std::greater and move-only friendly types")
+{
+	hstl::Priority_Queue<std::string, std::greater<std::string>> q;
+
+	q.push("pear");
+	q.push("apple");
+	q.emplace("fig");
+
+	REQUIRE(q.pop() == "apple");
+	REQUIRE(q.pop() == "fig");
+	REQUIRE(q.pop() == "pear");
+}
+
+TEST_CASE("Priority_Queue: bulk heapify matches std::priority_queue")
+{
+	std::mt19937 rng{3};
+
+	for (size_t n : { size_t{0}, size_t{1}, size_t{2}, size_t{5}, size_t{17}, size_t{1000} })
+	{
+		hstl::Array<uint32_t> elements;
+		std::priority_queue<uint32_t> reference;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			uint32_t v = rng() % 100;
+			elements.push(v);
+			reference.push(v);
+		}
+
+		hstl::Priority_Queue<uint32_t> q{ std::move(elements) };
+
+		REQUIRE(q.count() == n);
+
+		while (reference.empty() == false)
+		{
+			REQUIRE(q.top() == reference.top());
+			REQUIRE(q.pop() == reference.top());
+			reference.pop();
+		}
+
+		REQUIRE(q.empty());
+	}
+}
+
+TEST_CASE("Priority_Queue: arities 2 and 8 under random operations")
+{
+	hstl::Priority_Queue<int, std::less<int>, 2> binary;
+	hstl::Priority_Queue<int, std::less<int>, 8> octal;
+	std::priority_queue<int> reference;
+
+	std::mt19937 rng{11};
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		if (reference.empty() || rng() % 3 != 0)
+		{
+			int v = static_cast<int>(rng() % 1000);
+			binary.push(v);
+			octal.push(v);
+			reference.push(v);
+		}
+		else
+		{
+			REQUIRE(binary.pop() == reference.top());
+			REQUIRE(octal.pop() == reference.top());
+			reference.pop();
+		}
+	}
+}
+
+TEST_CASE("Indexed_Priority_Queue: push/pop/decrease_key/update/remove")
+{
+	hstl::Indexed_Priority_Queue<int, std::greater<int>> q;
+
+	q.push(0, 50);
+	q.push(1, 20);
+	q.push(2, 40);
+	q.push(7, 30);
+
+	REQUIRE(q.count() == 4);
+	REQUIRE(q.contains(7));
+	REQUIRE_FALSE(q.contains(3));
+	REQUIRE_FALSE(q.contains(100));
+	REQUIRE(*q.get(2) == 40);
+
+	REQUIRE(q.top().id == 1);
+
+	q.decrease_key(0, 10);
+	REQUIRE(q.top().id == 0);
+	REQUIRE(q.top().priority == 10);
+
+	q.update(0, 45); // move back down
+	REQUIRE(q.top().id == 1);
+
+	q.push(2, 5); // push of a queued id updates it
+	REQUIRE(q.count() == 4);
+	REQUIRE(q.top().id == 2);
+
+	REQUIRE(q.remove(1));
+	REQUIRE_FALSE(q.remove(1));
+
+	auto node = q.pop();
+	REQUIRE(node.id == 2);
+	REQUIRE(node.priority == 5);
+	REQUIRE_FALSE(q.contains(2));
+
+	REQUIRE(q.pop().id == 7);
+	REQUIRE(q.pop().id == 0);
+	REQUIRE(q.empty());
+
+	// Popped ids can come back
+	q.push(2, 1);
+	REQUIRE(q.top().id == 2);
+
+	q.clear();
+	REQUIRE(q.empty());
+	REQUIRE_FALSE(q.contains(2));
+}
+
+TEST_CASE("Indexed_Priority_Queue: Dijkstra on a grid matches a lazy std::priority_queue")
+{
+	constexpr uint32_t SIDE = 40;
+	constexpr uint32_t NODES = SIDE * SIDE;
+
+	std::mt19937 rng{5};
+	std::vector<uint32_t> weight(NODES);
+	for (auto& w : weight)
+		w = 1 + rng() % 9;
+
+	auto neighbours = [&](uint32_t node, auto&& visit)
+	{
+		uint32_t x = node % SIDE, y = node / SIDE;
+		if (x > 0) visit(node - 1);
+		if (x + 1 < SIDE) visit(node + 1);
+		if (y > 0) visit(node - SIDE);
+		if (y + 1 < SIDE) visit(node + SIDE);
+	};
+
+	// Indexed queue with decrease_key
+	std::vector<uint32_t> dist(NODES, UINT32_MAX);
+	hstl::Indexed_Priority_Queue<uint32_t, std::greater<uint32_t>> q;
+	q.reserve(NODES, NODES);
+
+	dist[0] = 0;
+	q.push(0, 0);
+
+	while (q.empty() == false)
+	{
+		auto [d, node] = q.pop();
+
+		neighbours(node, [&](uint32_t next)
+		{
+			uint32_t candidate = d + weight[next];
+
+			if (candidate < dist[next])
+			{
+				if (dist[next] == UINT32_MAX)
+					q.push(next, candidate);
+				else
+					q.decrease_key(next, candidate);
+
+				dist[next] = candidate;
+			}
+		});
+	}
+
+	// Reference with duplicates and stale entries
+	using Entry = std::pair<uint32_t, uint32_t>;
+	std::vector<uint32_t> expected(NODES, UINT32_MAX);
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> reference;
+
+	expected[0] = 0;
+	reference.push({ 0, 0 });
+
+	while (reference.empty() == false)
+	{
+		auto [d, node] = reference.top();
+		reference.pop();
+
+		if (d > expected[node])
+			continue;
+
+		neighbours(node, [&](uint32_t next)
+		{
+			if (d + weight[next] < expected[next])
+			{
+				expected[next] = d + weight[next];
+				reference.push({ expected[next], next });
+			}
+		});
+	}
+
+	REQUIRE(dist == expected);
+}
+
+TEST_CASE("Indexed_Priority_Queue: bulk build")
+{
+	hstl::Array<int> priorities;
+	for (int p : { 4, 8, 1, 6 })
+		priorities.push(p);
+
+	hstl::Indexed_Priority_Queue<int> q{ std::move(priorities) };
+
+	REQUIRE(q.count() == 4);
+	REQUIRE(q.pop().id == 1);
+	REQUIRE(q.pop().id == 3);
+	REQUIRE(q.pop().id == 0);
+	REQUIRE(q.pop().id == 2);
+}
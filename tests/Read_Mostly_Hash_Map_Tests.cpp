@@ -0,0 +1,284 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Read_Mostly_Hash_Map.h>
+#include <Str.h>
+
+#include <unordered_map>
+#include <random>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+
+namespace {
+
+	struct Key {
+		int v = 0;
+		size_t forced_hash = 0;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& k) const noexcept { return k.forced_hash; }
+	};
+
+	struct KeyEq {
+		bool operator()(const Key& a, const Key& b) const noexcept { return a.v == b.v; }
+	};
+
+	static Key K(int v, size_t h) { return Key{ v, h }; }
+
+	// Written as a pair that must always match, a torn or freed value breaks it
+	struct Versioned {
+		uint64_t version = 0;
+		uint64_t check = ~uint64_t{ 0 };
+
+		static Versioned make(uint64_t version) { return Versioned{ version, ~version }; }
+		bool valid() const { return check == ~version; }
+	};
+
+} // namespace
+
+TEST_CASE("Read_Mostly_Hash_Map<int, int>: insert/get/contains/remove")
+{
+	hstl::Read_Mostly_Hash_Map<int, int> m;
+
+	int value = 0;
+	REQUIRE(m.count() == 0);
+	REQUIRE_FALSE(m.get(1, value));
+	REQUIRE_FALSE(m.remove(1));
+
+	REQUIRE(m.insert(1, 10));
+	REQUIRE(m.insert(2, 20));
+	REQUIRE_FALSE(m.insert(1, 11));
+	REQUIRE(m.get(1, value));
+	REQUIRE(value == 11);
+
+	REQUIRE(m.try_emplace(3, 30));
+	REQUIRE_FALSE(m.try_emplace(3, 31));
+	REQUIRE(m.visit(3, [](const int& v) { REQUIRE(v == 30); }));
+	REQUIRE_FALSE(m.visit(4, [](const int&) { FAIL("visited a missing key"); }));
+
+	REQUIRE(m.remove(2));
+	REQUIRE_FALSE(m.contains(2));
+	REQUIRE(m.count() == 2);
+
+	// A removed key can come back, in its tombstone
+	REQUIRE(m.insert(2, 21));
+	REQUIRE(m.get(2, value));
+	REQUIRE(value == 21);
+
+	m.clear();
+	REQUIRE(m.count() == 0);
+	REQUIRE_FALSE(m.contains(1));
+	REQUIRE(m.insert(1, 1));
+}
+
+TEST_CASE("Read_Mostly_Hash_Map<Key, int>: tombstones and clustered hashes match std::unordered_map")
+{
+	hstl::Read_Mostly_Hash_Map<Key, int, KeyHash, KeyEq> m;
+	std::unordered_map<int, int> reference;
+
+	std::mt19937 rng{2025};
+
+	// Few distinct homes and fingerprints, so probes run long and cross plenty of tombstones
+	auto make_key = [](int v)
+	{
+		size_t home = static_cast<size_t>(v % 37) * 61u;
+		size_t fingerprint = static_cast<size_t>(v % 3) << 57;
+
+		return K(v, home | fingerprint);
+	};
+
+	for (int i = 0; i < 30000; ++i)
+	{
+		int v = static_cast<int>(rng() % 2000);
+		auto key = make_key(v);
+
+		switch (rng() % 3)
+		{
+		case 0:
+			REQUIRE(m.insert(key, i) == (reference.count(v) == 0));
+			reference[v] = i;
+			break;
+		case 1:
+			REQUIRE(m.remove(key) == (reference.erase(v) == 1));
+			break;
+		default:
+		{
+			int value = -1;
+			auto it = reference.find(v);
+
+			REQUIRE(m.get(key, value) == (it != reference.end()));
+			if (it != reference.end())
+				REQUIRE(value == it->second);
+		}
+		}
+
+		REQUIRE(m.count() == reference.size());
+	}
+
+	for (auto [v, value] : reference)
+	{
+		int found = -1;
+		REQUIRE(m.get(make_key(v), found));
+		REQUIRE(found == value);
+	}
+}
+
+TEST_CASE("Read_Mostly_Hash_Map<Str, int>: transparent lookups")
+{
+	hstl::Read_Mostly_Hash_Map<hstl::Str, int> m;
+
+	m.insert("pelvis", 1);
+	m.try_emplace(hstl::Str{ "spine" }, 2);
+
+	int value = 0;
+	REQUIRE(m.get("pelvis", value));
+	REQUIRE(value == 1);
+	REQUIRE(m.contains(hstl::Str_View{ "spine" }));
+	REQUIRE(m.remove(hstl::Str_View{ "pelvis" }));
+	REQUIRE_FALSE(m.contains("pelvis"));
+}
+
+TEST_CASE("Read_Mostly_Hash_Map: readers run against a writer that overwrites, removes and grows")
+{
+	constexpr int READER_COUNT = 3;
+	constexpr int KEY_COUNT = 2000;
+
+	hstl::Read_Mostly_Hash_Map<int, Versioned> m;
+
+	for (int key = 0; key < KEY_COUNT; key += 2)
+		m.insert(key, Versioned::make(0));
+
+	// Catch2 assertions aren't thread-safe, the readers count their failures instead
+	std::atomic<bool> done{false};
+	std::atomic<int> failures{0};
+	std::atomic<int> lookups{0};
+	std::vector<std::thread> readers;
+
+	for (int r = 0; r < READER_COUNT; ++r)
+	{
+		readers.emplace_back([&, r]()
+		{
+			int local = 0;
+
+			while (done.load() == false || local < 1000)
+			{
+				int key = (local * 7 + r) % KEY_COUNT;
+
+				m.visit(key, [&](const Versioned& value)
+				{
+					if (value.valid() == false)
+						failures++;
+				});
+
+				// Even keys are never removed
+				if (key % 2 == 0 && m.contains(key) == false)
+					failures++;
+
+				local++;
+			}
+
+			lookups += local;
+		});
+	}
+
+	// The writer overwrites the even keys, and inserts and removes the odd keys, which grows the table and
+	// fills it with tombstones
+	for (uint64_t round = 1; round <= 20; ++round)
+	{
+		for (int key = 0; key < KEY_COUNT; ++key)
+		{
+			if (key % 2 == 0)
+				m.insert(key, Versioned::make(round));
+			else if (round % 2 == 1)
+				m.insert(key + static_cast<int>(round) * KEY_COUNT, Versioned::make(round));
+			else
+				m.remove(key + static_cast<int>(round - 1) * KEY_COUNT);
+		}
+	}
+
+	done = true;
+
+	for (auto& reader : readers)
+		reader.join();
+
+	REQUIRE(failures == 0);
+	REQUIRE(lookups >= READER_COUNT * 1000);
+	REQUIRE(m.count() == KEY_COUNT / 2);
+
+	Versioned last;
+	REQUIRE(m.get(0, last));
+	REQUIRE(last.version == 20);
+
+	// Without readers everything retired can be freed
+	hstl::Epoch_Domain::get().collect();
+	REQUIRE(hstl::Epoch_Domain::get().retired_count() == 0);
+}
+
+TEST_CASE("Epoch_Domain: retired objects wait for the readers that could see them")
+{
+	static int deleted = 0;
+	deleted = 0;
+
+	auto& domain = hstl::Epoch_Domain::get();
+	domain.collect();
+
+	int* object = new int{42};
+
+	{
+		hstl::Epoch_Domain::Guard guard;
+
+		domain.retire(object, [](void* pointer) { delete static_cast<int*>(pointer); deleted++; }, sizeof(int));
+		domain.collect();
+
+		// Still pinned, nested guards included
+		{
+			hstl::Epoch_Domain::Guard nested;
+		}
+		domain.collect();
+
+		REQUIRE(deleted == 0);
+		REQUIRE(*object == 42);
+	}
+
+	domain.collect();
+	REQUIRE(deleted == 1);
+}
+
+TEST_CASE("Epoch_Domain: threads past MAX_THREADS wait for a slot instead of sharing one")
+{
+	constexpr size_t THREAD_COUNT = hstl::Epoch_Domain::MAX_THREADS + 16;
+
+	std::atomic<size_t> pinned{0};
+	std::atomic<bool> release{false};
+	std::vector<std::thread> threads;
+
+	for (size_t i = 0; i < THREAD_COUNT; ++i)
+	{
+		threads.emplace_back([&]()
+		{
+			hstl::Epoch_Domain::Guard guard;
+			pinned++;
+
+			while (release.load() == false)
+				std::this_thread::yield();
+		});
+	}
+
+	// Every slot ends up held by a pinned thread (the main thread may hold one from an earlier test), the
+	// other threads stay blocked in their first pin
+	while (pinned.load() < hstl::Epoch_Domain::MAX_THREADS - 1)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	REQUIRE(pinned.load() <= hstl::Epoch_Domain::MAX_THREADS);
+
+	// Exiting threads hand their slots over
+	release = true;
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	REQUIRE(pinned == THREAD_COUNT);
+}
@@ -0,0 +1,197 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Small_Hash_Map.h>
+#include <Str.h>
+
+#include <unordered_map>
+#include <random>
+#include <cstdio>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+	struct Key {
+		int v = 0;
+		size_t forced_hash = 0;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& k) const noexcept { return k.forced_hash; }
+	};
+
+	struct KeyEq {
+		bool operator()(const Key& a, const Key& b) const noexcept { return a.v == b.v; }
+	};
+
+	static Key K(int v) { return Key{ v, static_cast<size_t>(v % 7) }; }
+
+	template<typename Map, typename Make_Key>
+	void check_against_reference(Make_Key make_key, int key_range, uint32_t seed)
+	{
+		Map m;
+		std::unordered_map<int, int> reference;
+
+		std::mt19937 rng{seed};
+
+		for (int i = 0; i < 5000; ++i)
+		{
+			int v = static_cast<int>(rng() % static_cast<uint32_t>(key_range));
+
+			switch (rng() % 3)
+			{
+			case 0:
+				m.insert(make_key(v), i);
+				reference[v] = i;
+				break;
+			case 1:
+				REQUIRE(m.remove(make_key(v)) == (reference.erase(v) == 1));
+				break;
+			default:
+			{
+				auto it = reference.find(v);
+				auto value = m.get(make_key(v));
+
+				REQUIRE((value != nullptr) == (it != reference.end()));
+				if (value)
+					REQUIRE(*value == it->second);
+			}
+			}
+
+			REQUIRE(m.count() == reference.size());
+		}
+
+		size_t seen = 0;
+		int sum = 0;
+		int reference_sum = 0;
+
+		m.for_each([&](const auto&, const int& value) { seen++; sum += value; });
+
+		for (auto [v, value] : reference)
+			reference_sum += value;
+
+		REQUIRE(seen == reference.size());
+		REQUIRE(sum == reference_sum);
+	}
+
+} // namespace
+
+TEST_CASE("Small_Hash_Map<int, int>: inline until it outgrows N, then a Hash_Map")
+{
+	hstl::Small_Hash_Map<int, int, 4> m;
+
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.is_small());
+	REQUIRE(m.get(1) == nullptr);
+	REQUIRE_FALSE(m.remove(1));
+
+	for (int i = 0; i < 4; ++i)
+		REQUIRE(m.try_emplace(i, i * 10).inserted);
+
+	REQUIRE(m.is_small());
+	REQUIRE_FALSE(m.try_emplace(2, -1).inserted);
+	REQUIRE(m.insert(2, 21) == 21);
+	REQUIRE(m.count() == 4);
+
+	// Swap-remove and re-insert while small
+	REQUIRE(m.remove(0));
+	REQUIRE_FALSE(m.contains(0));
+	REQUIRE(*m.get(3) == 30);
+	m.insert(0, 1);
+	REQUIRE(m.is_small());
+
+	// The fifth element spills everything
+	m.insert(4, 40);
+	REQUIRE_FALSE(m.is_small());
+	REQUIRE(m.count() == 5);
+	REQUIRE(*m.get(0) == 1);
+	REQUIRE(*m.get(2) == 21);
+	REQUIRE(*m.get(4) == 40);
+
+	// And stays spilled
+	REQUIRE(m.remove(4));
+	REQUIRE(m.remove(3));
+	REQUIRE_FALSE(m.is_small());
+	REQUIRE(m.count() == 3);
+
+	m.clear();
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.get(0) == nullptr);
+	m.get_or_insert_default(7).value++;
+	REQUIRE(*m.get(7) == 1);
+}
+
+TEST_CASE("Small_Hash_Map: matches std::unordered_map on both sides of the threshold")
+{
+	// Few keys never spill, more keys spill part way through
+	check_against_reference<hstl::Small_Hash_Map<int, int, 16>>([](int v) { return v; }, 12, 1);
+	check_against_reference<hstl::Small_Hash_Map<int, int, 16>>([](int v) { return v; }, 100, 2);
+	check_against_reference<hstl::Small_Hash_Map<uint64_t, int, 8>>([](int v) { return static_cast<uint64_t>(v) << 40; }, 8, 3);
+	check_against_reference<hstl::Small_Hash_Map<uint64_t, int, 8>>([](int v) { return static_cast<uint64_t>(v) << 40; }, 50, 4);
+	check_against_reference<hstl::Small_Hash_Map<Key, int, 8, KeyHash, KeyEq>>([](int v) { return K(v); }, 8, 5);
+	check_against_reference<hstl::Small_Hash_Map<Key, int, 8, KeyHash, KeyEq>>([](int v) { return K(v); }, 60, 6);
+}
+
+TEST_CASE("Small_Hash_Map<Str, Str>: transparent lookups, copies and moves in both modes")
+{
+	using Map = hstl::Small_Hash_Map<hstl::Str, hstl::Str, 4>;
+
+	Map small;
+	small.insert("roughness", "0.5 but long enough to leave the inline buffer");
+	small.try_emplace(hstl::Str{ "metalness" }, "1");
+
+	REQUIRE(small.contains("roughness"));
+	REQUIRE(small.get(hstl::Str_View{ "metalness" })->view() == "1");
+
+	Map large = small;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		char name[48];
+		snprintf(name, sizeof(name), "parameter_with_a_long_name_%d", i);
+		large.insert(name, name);
+	}
+
+	REQUIRE(small.is_small());
+	REQUIRE_FALSE(large.is_small());
+	REQUIRE(small.count() == 2);
+	REQUIRE(large.count() == 12);
+	REQUIRE(large.get("roughness")->view() == small.get("roughness")->view());
+
+	Map small_copy = small;
+	Map large_copy = large;
+	Map small_moved = std::move(small);
+	Map large_moved = std::move(large);
+
+	REQUIRE(small.count() == 0);
+	REQUIRE(small_moved.count() == 2);
+	REQUIRE(small_moved.get("metalness")->view() == "1");
+	REQUIRE(large_moved.count() == 12);
+	REQUIRE(large_moved.get("parameter_with_a_long_name_9")->view() == "parameter_with_a_long_name_9");
+
+	// Assignments across the modes
+	small_copy = large_copy;
+	REQUIRE_FALSE(small_copy.is_small());
+	REQUIRE(small_copy.count() == 12);
+
+	large_copy = std::move(small_moved);
+	REQUIRE(large_copy.is_small());
+	REQUIRE(large_copy.count() == 2);
+	REQUIRE(large_copy.remove("roughness"));
+	REQUIRE(large_copy.count() == 1);
+
+	// The moved-from maps stay usable
+	small.insert("a", "b");
+	REQUIRE(small.get("a")->view() == "b");
+	large.insert("c", "d");
+	REQUIRE(large.get("c")->view() == "d");
+
+	size_t total = 0;
+	large_moved.for_each([&](const hstl::Str&, hstl::Str& value)
+	{
+		value = "overwritten";
+		total++;
+	});
+	REQUIRE(total == 12);
+	REQUIRE(large_moved.get("metalness")->view() == "overwritten");
+}
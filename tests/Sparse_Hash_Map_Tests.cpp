@@ -0,0 +1,226 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Sparse_Hash_Map.h>
+#include <Str.h>
+
+#include <unordered_map>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+	struct Key {
+		int v = 0;
+		size_t forced_hash = 0;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& k) const noexcept { return k.forced_hash; }
+	};
+
+	struct KeyEq {
+		bool operator()(const Key& a, const Key& b) const noexcept { return a.v == b.v; }
+	};
+
+	// Few distinct hashes, long probe runs that cross groups and wrap around the table
+	static Key K(int v) { return Key{ v, static_cast<size_t>(v % 7) * 1000003u - 1u }; }
+
+	template<typename Map, typename Make_Key>
+	void check_against_reference(Make_Key make_key, int key_range, int operations, uint32_t seed)
+	{
+		Map m;
+		std::unordered_map<int, int> reference;
+
+		std::mt19937 rng{seed};
+
+		for (int i = 0; i < operations; ++i)
+		{
+			int v = static_cast<int>(rng() % static_cast<uint32_t>(key_range));
+
+			switch (rng() % 3)
+			{
+			case 0:
+				m.insert(make_key(v), i);
+				reference[v] = i;
+				break;
+			case 1:
+				REQUIRE(m.remove(make_key(v)) == (reference.erase(v) == 1));
+				break;
+			default:
+			{
+				auto it = reference.find(v);
+				auto value = m.get(make_key(v));
+
+				REQUIRE((value != nullptr) == (it != reference.end()));
+				if (value)
+					REQUIRE(*value == it->second);
+			}
+			}
+
+			REQUIRE(m.count() == reference.size());
+		}
+
+		size_t seen = 0;
+		m.for_each([&](const auto&, int value)
+		{
+			seen++;
+			(void)value;
+		});
+		REQUIRE(seen == reference.size());
+
+		for (const auto& [v, value] : reference)
+			REQUIRE(*m.get(make_key(v)) == value);
+	}
+
+} // namespace
+
+TEST_CASE("Sparse_Hash_Map: random operations against std::unordered_map")
+{
+	check_against_reference<hstl::Sparse_Hash_Map<int, int>>([](int v) { return v; }, 3000, 30000, 1);
+	check_against_reference<hstl::Sparse_Hash_Map<int, int>>([](int v) { return v; }, 50, 5000, 2);
+	check_against_reference<hstl::Sparse_Hash_Map<Key, int, KeyHash, KeyEq>>(K, 300, 5000, 3);
+	check_against_reference<hstl::Sparse_Hash_Map<std::string, int>>([](int v) { return std::to_string(v); }, 2000, 10000, 4);
+}
+
+TEST_CASE("Sparse_Hash_Map: growth, tombstones and shrink_to_fit")
+{
+	hstl::Sparse_Hash_Map<uint64_t, uint64_t> m;
+
+	REQUIRE(m.capacity() == 0);
+	REQUIRE(m.get(1) == nullptr);
+	REQUIRE_FALSE(m.remove(1));
+
+	for (uint64_t i = 0; i < 100000; ++i)
+		m.insert(i, i * 3);
+
+	REQUIRE(m.count() == 100000);
+	REQUIRE(m.capacity() >= 200000);
+
+	auto stats = m.stats();
+	REQUIRE(stats.count == 100000);
+	REQUIRE(stats.load_factor <= 0.5f);
+	REQUIRE(stats.rehash_count > 0);
+	REQUIRE(stats.bytes_used == 100000 * 2 * sizeof(uint64_t));
+	// Packed elements plus 24 bytes per 64 slots and the rounding of the group arrays
+	REQUIRE(stats.bytes_reserved < stats.bytes_used + m.capacity());
+
+	// Churn on a full table: the tombstones must not make it grow or loop
+	size_t capacity = m.capacity();
+
+	for (uint64_t round = 0; round < 5; ++round)
+	{
+		for (uint64_t i = 0; i < 100000; i += 2)
+			REQUIRE(m.remove(i));
+
+		for (uint64_t i = 0; i < 100000; i += 2)
+			REQUIRE(m.try_emplace(i, i * 3).inserted);
+	}
+
+	REQUIRE(m.capacity() <= capacity * 2);
+
+	for (uint64_t i = 0; i < 100000; ++i)
+		REQUIRE(*m.get(i) == i * 3);
+
+	for (uint64_t i = 0; i < 99000; ++i)
+		REQUIRE(m.remove(i));
+
+	m.shrink_to_fit();
+	REQUIRE(m.count() == 1000);
+	REQUIRE(m.capacity() == 2048);
+
+	for (uint64_t i = 99000; i < 100000; ++i)
+		REQUIRE(*m.get(i) == i * 3);
+
+	m.clear();
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.get(99999) == nullptr);
+	REQUIRE(m.begin() == m.end());
+
+	m.insert(7u, 8u);
+	REQUIRE(*m.get(7) == 8);
+
+	m.remove(7);
+	m.shrink_to_fit();
+	REQUIRE(m.capacity() == 0);
+}
+
+TEST_CASE("Sparse_Hash_Map: insert, try_emplace and string keys")
+{
+	hstl::Sparse_Hash_Map<hstl::Str, std::string> m;
+
+	REQUIRE(m.insert("alpha", "a") == "a");
+	REQUIRE(m.insert("alpha", "b") == "b");
+	REQUIRE(m.count() == 1);
+
+	auto [value, inserted] = m.try_emplace("beta", 3, 'x');
+	REQUIRE(inserted);
+	REQUIRE(value == "xxx");
+
+	auto again = m.try_emplace("beta", 1, 'y');
+	REQUIRE_FALSE(again.inserted);
+	REQUIRE(again.value == "xxx");
+
+	m.get_or_insert_default("gamma").value += "g";
+
+	// Transparent lookups, no Str is built
+	REQUIRE(*m.get(hstl::Str_View{"gamma"}) == "g");
+	REQUIRE(m.contains("alpha"));
+	REQUIRE_FALSE(m.contains("delta"));
+	REQUIRE(m.remove("alpha"));
+	REQUIRE_FALSE(m.remove("alpha"));
+
+	size_t hash = hstl::Str_Hash{}("beta");
+	REQUIRE(*m.get_hashed(hstl::Str_View{"beta"}, hash) == "xxx");
+	REQUIRE(m.remove_hashed(hstl::Str_View{"beta"}, hash));
+	REQUIRE(m.count() == 1);
+}
+
+TEST_CASE("Sparse_Hash_Map: copies, moves and iterators")
+{
+	hstl::Sparse_Hash_Map<int, std::string> m{1000};
+	size_t capacity = m.capacity();
+
+	for (int i = 0; i < 1000; ++i)
+		m.insert(i, std::to_string(i));
+
+	REQUIRE(m.capacity() == capacity);
+
+	for (int i = 0; i < 1000; i += 3)
+		m.remove(i);
+
+	hstl::Sparse_Hash_Map<int, std::string> copy{m};
+	REQUIRE(copy.count() == m.count());
+
+	for (int i = 0; i < 1000; ++i)
+		REQUIRE(copy.contains(i) == (i % 3 != 0));
+
+	copy.insert(0, "zero");
+	REQUIRE_FALSE(m.contains(0));
+
+	size_t seen = 0;
+	for (const auto& slot : m)
+	{
+		REQUIRE(slot.value == std::to_string(slot.key));
+		seen++;
+	}
+	REQUIRE(seen == m.count());
+
+	for (auto entry : m)
+		entry.value += "!";
+
+	REQUIRE(*m.get(1) == "1!");
+
+	hstl::Sparse_Hash_Map<int, std::string> moved{std::move(m)};
+	REQUIRE(moved.count() == copy.count() - 1);
+	REQUIRE(m.count() == 0);
+	REQUIRE(m.get(1) == nullptr);
+
+	m = copy;
+	REQUIRE(*m.get(0) == "zero");
+
+	copy = std::move(moved);
+	REQUIRE(*copy.get(2) == "2!");
+	REQUIRE_FALSE(copy.contains(0));
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Static_Hash_Map.h>
+#include <Str.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+	enum class Token : uint8_t { IF, ELSE, WHILE, FOR, RETURN, FN, LET, IDENTIFIER };
+
+	constexpr auto KEYWORDS = hstl::make_static_hash_map<hstl::Str_View, Token>({
+		{ "if", Token::IF },
+		{ "else", Token::ELSE },
+		{ "while", Token::WHILE },
+		{ "for", Token::FOR },
+		{ "return", Token::RETURN },
+		{ "fn", Token::FN },
+		{ "let", Token::LET },
+	});
+
+	constexpr auto TOKEN_NAMES = hstl::make_static_hash_map<Token, hstl::Str_View>({
+		{ Token::IF, "IF" },
+		{ Token::ELSE, "ELSE" },
+		{ Token::WHILE, "WHILE" },
+		{ Token::FOR, "FOR" },
+		{ Token::RETURN, "RETURN" },
+		{ Token::FN, "FN" },
+		{ Token::LET, "LET" },
+		{ Token::IDENTIFIER, "IDENTIFIER" },
+	});
+
+	constexpr Token classify(hstl::Str_View word)
+	{
+		return KEYWORDS.get_or(word, Token::IDENTIFIER);
+	}
+
+	// Compile-time lookups
+	static_assert(KEYWORDS.count() == 7);
+	static_assert(classify("while") == Token::WHILE);
+	static_assert(classify("whilst") == Token::IDENTIFIER);
+	static_assert(classify("") == Token::IDENTIFIER);
+	static_assert(*TOKEN_NAMES.get(Token::RETURN) == "RETURN");
+
+	constexpr size_t GENERATED_COUNT = 1000;
+
+	constexpr std::array<hstl::Static_Hash_Entry<uint32_t, uint32_t>, GENERATED_COUNT> generated_entries()
+	{
+		std::array<hstl::Static_Hash_Entry<uint32_t, uint32_t>, GENERATED_COUNT> entries{};
+
+		for (uint32_t i = 0; i < GENERATED_COUNT; ++i)
+			entries[i] = { i * 2654435761u, i };
+
+		return entries;
+	}
+
+	constexpr auto GENERATED = hstl::make_static_hash_map(generated_entries());
+
+	static_assert(*GENERATED.get(500u * 2654435761u) == 500u);
+
+} // namespace
+
+TEST_CASE("Static_Hash_Map<Str_View, Token>: keyword table")
+{
+	std::string words[] = { "if", "else", "while", "for", "return", "fn", "let" };
+	Token tokens[] = { Token::IF, Token::ELSE, Token::WHILE, Token::FOR, Token::RETURN, Token::FN, Token::LET };
+
+	for (size_t i = 0; i < 7; ++i)
+	{
+		// Runtime strings, not the literals the table points to
+		hstl::Str_View word{ words[i].data(), words[i].size() };
+
+		REQUIRE(KEYWORDS.contains(word));
+		REQUIRE(*KEYWORDS.get(word) == tokens[i]);
+		REQUIRE(TOKEN_NAMES.get(tokens[i]) != nullptr);
+	}
+
+	REQUIRE_FALSE(KEYWORDS.contains("iff"));
+	REQUIRE_FALSE(KEYWORDS.contains("i"));
+	REQUIRE_FALSE(KEYWORDS.contains("a_long_identifier_that_takes_the_long_hash_path_of_hash_chars"));
+	REQUIRE(KEYWORDS.get_or("letter", Token::IDENTIFIER) == Token::IDENTIFIER);
+
+	size_t seen = 0;
+	KEYWORDS.for_each([&](hstl::Str_View key, Token token)
+	{
+		seen++;
+		REQUIRE(*KEYWORDS.get(key) == token);
+	});
+	REQUIRE(seen == 7);
+
+	REQUIRE(*TOKEN_NAMES.get(Token::IDENTIFIER) == "IDENTIFIER");
+}
+
+TEST_CASE("Static_Hash_Map: generated tables and tiny tables")
+{
+	for (uint32_t i = 0; i < GENERATED_COUNT; ++i)
+	{
+		REQUIRE(*GENERATED.get(i * 2654435761u) == i);
+		REQUIRE_FALSE(GENERATED.contains(i * 2654435761u + 1u));
+	}
+
+	constexpr auto ONE = hstl::make_static_hash_map<int, int>({ { 42, 1 } });
+	REQUIRE(*ONE.get(42) == 1);
+	REQUIRE(ONE.get(0) == nullptr);
+
+	constexpr auto TWO = hstl::make_static_hash_map<int64_t, char>({ { -1, 'a' }, { 1, 'b' } });
+	REQUIRE(*TWO.get(-1) == 'a');
+	REQUIRE(*TWO.get(1) == 'b');
+	REQUIRE(TWO.get(0) == nullptr);
+}